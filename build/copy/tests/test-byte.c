@@ -0,0 +1,279 @@
+#include "../nsl.h"
+
+static void test_bytes(void) {
+    nsl_Arena arena = {0};
+    nsl_Bytes b = NSL_BYTES(0x02, 0xFF, 0xAA, 0xBB, 0x41, 0x41, 0x41);
+    NSL_ASSERT(b.data[0] == 0x02 && "nsl_Bytes are not initialized correctly");
+    NSL_ASSERT(b.data[1] == 0xff && "nsl_Bytes are not initialized correctly");
+    NSL_ASSERT(b.data[2] == 0xaa && "nsl_Bytes are not initialized correctly");
+    NSL_ASSERT(b.data[3] == 0xbb && "nsl_Bytes are not initialized correctly");
+    nsl_arena_free(&arena);
+}
+
+static void test_nc_bytes_str(void) {
+    nsl_Bytes b = NSL_BYTES_STR("ABC");
+    NSL_ASSERT(b.size == 3 && "Size is not correct");
+    NSL_ASSERT(b.data[0] == 0x41 && "nsl_Bytes are not initialized correctly");
+    NSL_ASSERT(b.data[1] == 0x42 && "nsl_Bytes are not initialized correctly");
+    NSL_ASSERT(b.data[2] == 0x43 && "nsl_Bytes are not initialized correctly");
+
+    nsl_Bytes b2 = NSL_BYTES_STR("\x41\x42\x43");
+    NSL_ASSERT(b2.size == 3 && "Size is not correct");
+    NSL_ASSERT(b2.data[0] == 0x41 && "nsl_Bytes are not initialized correctly");
+    NSL_ASSERT(b2.data[1] == 0x42 && "nsl_Bytes are not initialized correctly");
+    NSL_ASSERT(b2.data[2] == 0x43 && "nsl_Bytes are not initialized correctly");
+}
+
+static void test_to_hex(void) {
+    nsl_Arena arena = {0};
+    nsl_Bytes b = NSL_BYTES(0x41, 0x42, 0x43);
+    nsl_Str s = nsl_bytes_to_hex(b, &arena);
+    nsl_Str ec = NSL_STR("414243");
+    NSL_ASSERT(ec.data);
+    NSL_ASSERT(nsl_str_eq(s, ec) && "nsl_String conversion was not correct");
+
+    nsl_Bytes b2 = NSL_BYTES(0x02, 0xFF, 0xAA, 0xBB, 0x01, 0x02, 0x03);
+    nsl_Str s2 = nsl_bytes_to_hex(b2, &arena);
+    NSL_ASSERT(nsl_str_eq(s2, NSL_STR("2ffaabb010203")) && "nsl_String conversion was not correct");
+
+    nsl_Bytes b3 = NSL_BYTES(0xaa, 0xbb, 0xcc, 0xdd, 0x41, 0x41, 0x41, 0x41, 0x42, 0x42, 0x42, 0x42);
+    nsl_Str s3 = nsl_bytes_to_hex(b3, &arena);
+    NSL_ASSERT(nsl_str_eq(s3, NSL_STR("aabbccdd4141414142424242")) && "nsl_String conversion was not correct");
+
+    nsl_arena_free(&arena);
+}
+
+static void test_nc_bytes_cmp(void) {
+    nsl_Bytes b1 = NSL_BYTES(0xFF);
+    NSL_ASSERT(nsl_bytes_eq(b1, NSL_BYTES(0xFF)) == true && "nsl_Bytes not compared correctly");
+    NSL_ASSERT(nsl_bytes_eq(b1, NSL_BYTES(0x0F)) == false && "nsl_Bytes not compared correctly");
+}
+
+static void test_nc_bytes_slice(void) {
+    nsl_Bytes b = NSL_BYTES_STR("ABC");
+    nsl_Bytes slice = nsl_bytes_slice(b, 1, 3);
+    NSL_ASSERT(nsl_bytes_eq(slice, NSL_BYTES_STR("BC")) && "nsl_Bytes were not sliced correctly");
+
+    nsl_Bytes invalid = nsl_bytes_slice(b, b.size, 2);
+    NSL_ASSERT(nsl_bytes_eq(invalid, NSL_BYTES_STR("")) && "nsl_Bytes were not invalidated");
+
+    nsl_Bytes invalid2 = nsl_bytes_slice(b, 0, b.size + 1);
+    NSL_ASSERT(nsl_bytes_eq(invalid2, NSL_BYTES_STR("")) && "nsl_Bytes were not invalidated");
+}
+
+static void test_nc_bytes_take(void) {
+    nsl_Bytes bytes = NSL_BYTES(0x12, 0x34, 0x56, 0x78);
+    nsl_Bytes take = nsl_bytes_take(&bytes, 3);
+    NSL_ASSERT(nsl_bytes_eq(bytes, NSL_BYTES(0x78)) && "Did not take the correct bytes");
+    NSL_ASSERT(nsl_bytes_eq(take, NSL_BYTES(0x12, 0x34, 0x56)) && "Did not take the correct bytes");
+    nsl_Bytes rest = nsl_bytes_take(&bytes, 3);
+    NSL_ASSERT(nsl_bytes_eq(rest, NSL_BYTES(0x78)) && "Did not take the correct bytes");
+
+    nsl_Bytes invalid = nsl_bytes_take(&bytes, 3);
+    NSL_ASSERT(invalid.size == 0 && "Did not take the correct amount of bytes");
+}
+
+static void test_nc_bytes_from_hex(void) {
+    nsl_Arena arena = {0};
+    nsl_Bytes b1 = nsl_bytes_from_hex(NSL_STR("0xA0"), &arena);
+    NSL_ASSERT(b1.size == 1 && "conversion was not done correctly");
+    NSL_ASSERT(b1.data[0] == 0xa0 && "conversion was not correct");
+
+    nsl_Bytes b2 = nsl_bytes_from_hex(NSL_STR("0xA0B1C2"), &arena);
+    NSL_ASSERT(b2.size == 3 && "conversion was not done correctly");
+    NSL_ASSERT(b2.data[0] == 0xa0 && "conversion was not correct");
+    NSL_ASSERT(b2.data[1] == 0xb1 && "conversion was not correct");
+    NSL_ASSERT(b2.data[2] == 0xc2 && "conversion was not correct");
+
+    nsl_Bytes b3 = nsl_bytes_from_hex(NSL_STR("0x101"), &arena);
+    NSL_ASSERT(b3.size == 2 && "conversion was not done correctly");
+    NSL_ASSERT(b3.data[0] == 0x1 && "conversion was not correct");
+    NSL_ASSERT(b3.data[1] == 0x01 && "conversion was not correct");
+
+    nsl_arena_free(&arena);
+}
+
+static void test_nc_bytes_hex_buffer(void) {
+    u8 data[100];
+    for (usize i = 0; i < sizeof(data); i++) {
+        data[i] = (u8)(i * 37);
+    }
+
+    nsl_StrBuffer sb = {0};
+    nsl_ByteBuffer bb = {0};
+    nsl_Str hex = nsl_bytes_to_hex_sb(nsl_bytes_from_parts(sizeof(data), data), &sb);
+    NSL_ASSERT(hex.len == sizeof(data) * 2 && "every byte should take two chars");
+    NSL_ASSERT(nsl_str_startswith(hex, NSL_STR("00254a6f94b9de03")) && "hex encoding was not correct");
+    NSL_ASSERT(nsl_bytes_from_hex_bb(hex, &bb) == NSL_NO_ERROR && "should decode");
+    NSL_ASSERT(nsl_bytes_eq(nsl_bytes_from_parts(bb.len, bb.items), nsl_bytes_from_parts(sizeof(data), data)));
+
+    bb.len = 0;
+    NSL_ASSERT(nsl_bytes_from_hex_bb(NSL_STR("0xABCdef012"), &bb) == NSL_NO_ERROR && "should decode");
+    NSL_ASSERT(nsl_bytes_eq(nsl_bytes_from_parts(bb.len, bb.items), NSL_BYTES(0x0a, 0xbc, 0xde, 0xf0, 0x12)));
+
+    bb.len = 0;
+    nsl_Str invalid = NSL_STR("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1g1f");
+    NSL_ASSERT(nsl_bytes_from_hex_bb(invalid, &bb) == NSL_ERROR_PARSE && "'g' is not a hex digit");
+    NSL_ASSERT(nsl_bytes_from_hex_bb(NSL_STR("12 4"), &bb) == NSL_ERROR_PARSE && "' ' is not a hex digit");
+    NSL_ASSERT(bb.len == 0 && "nothing should have been appended");
+
+    nsl_list_free(&sb);
+    nsl_list_free(&bb);
+}
+
+static void test_nc_bytes_base64(void) {
+    nsl_Arena arena = {0};
+    nsl_Bytes out = {0};
+
+    nsl_Str s = nsl_bytes_to_base64(NSL_BYTES_STR("Hello"), NSL_BASE64_STD, &arena);
+    NSL_ASSERT(nsl_str_eq(s, NSL_STR("SGVsbG8=")) && "base64 encoding was not correct");
+    NSL_ASSERT(nsl_bytes_from_base64(s, NSL_BASE64_STD, &arena, &out) == NSL_NO_ERROR);
+    NSL_ASSERT(nsl_bytes_eq(out, NSL_BYTES_STR("Hello")) && "base64 decoding was not correct");
+
+    nsl_Bytes b = NSL_BYTES(0xfb, 0xff, 0xbf);
+    NSL_ASSERT(nsl_str_eq(nsl_bytes_to_base64(b, NSL_BASE64_STD, &arena), NSL_STR("+/+/")));
+    NSL_ASSERT(nsl_str_eq(nsl_bytes_to_base64(b, NSL_BASE64_URL, &arena), NSL_STR("-_-_")));
+    NSL_ASSERT(nsl_str_eq(nsl_bytes_to_base64(NSL_BYTES_STR("Hi"), NSL_BASE64_URL, &arena), NSL_STR("SGk")));
+
+    NSL_ASSERT(nsl_bytes_from_base64(NSL_STR("SGk"), NSL_BASE64_URL, &arena, &out) == NSL_NO_ERROR);
+    NSL_ASSERT(nsl_bytes_eq(out, NSL_BYTES_STR("Hi")) && "base64 decoding was not correct");
+    NSL_ASSERT(nsl_bytes_from_base64(NSL_STR("SGk="), NSL_BASE64_URL, &arena, &out) == NSL_NO_ERROR);
+    NSL_ASSERT(nsl_bytes_eq(out, NSL_BYTES_STR("Hi")) && "base64 decoding was not correct");
+
+    NSL_ASSERT(nsl_bytes_from_base64(NSL_STR("SGk"), NSL_BASE64_STD, &arena, &out) == NSL_ERROR_PARSE);
+    NSL_ASSERT(nsl_bytes_from_base64(NSL_STR("SGl="), NSL_BASE64_STD, &arena, &out) == NSL_ERROR_PARSE);
+    NSL_ASSERT(nsl_bytes_from_base64(NSL_STR("-_-_"), NSL_BASE64_STD, &arena, &out) == NSL_ERROR_PARSE);
+    NSL_ASSERT(nsl_bytes_from_base64(NSL_STR("S=Gk"), NSL_BASE64_STD, &arena, &out) == NSL_ERROR_PARSE);
+
+    u8 data[200];
+    for (usize i = 0; i < sizeof(data); i++) {
+        data[i] = (u8)(i * 73 + 5);
+    }
+    for (nsl_Base64 alphabet = NSL_BASE64_STD; alphabet <= NSL_BASE64_URL; alphabet++) {
+        for (usize size = 0; size < sizeof(data); size += 7) {
+            nsl_StrBuffer sb = {0};
+            nsl_ByteBuffer bb = {0};
+            nsl_Str encoded = nsl_bytes_to_base64_sb(nsl_bytes_from_parts(size, data), alphabet, &sb);
+            NSL_ASSERT(nsl_bytes_from_base64_bb(encoded, alphabet, &bb) == NSL_NO_ERROR);
+            NSL_ASSERT(nsl_bytes_eq(nsl_bytes_from_parts(bb.len, bb.items), nsl_bytes_from_parts(size, data)));
+
+            if (encoded.len > 1) {
+                sb.items[encoded.len / 2] = '.';
+                NSL_ASSERT(nsl_bytes_from_base64_bb(encoded, alphabet, &bb) == NSL_ERROR_PARSE);
+            }
+            nsl_list_free(&sb);
+            nsl_list_free(&bb);
+        }
+    }
+
+    nsl_arena_free(&arena);
+}
+
+static void test_nc_bytes_base32(void) {
+    nsl_Arena arena = {0};
+    nsl_Bytes out = {0};
+
+    const char *expected[] = {"", "MY======", "MZXQ====", "MZXW6===", "MZXW6YQ=", "MZXW6YTB", "MZXW6YTBOI======"};
+    for (usize i = 0; i < NSL_ARRAY_LEN(expected); i++) {
+        nsl_Bytes b = nsl_bytes_from_parts(i, "foobar");
+        nsl_Str s = nsl_bytes_to_base32(b, &arena);
+        NSL_ASSERT(nsl_str_eq(s, nsl_str_from_cstr(expected[i])) && "base32 encoding was not correct");
+        NSL_ASSERT(nsl_bytes_from_base32(s, &arena, &out) == NSL_NO_ERROR);
+        NSL_ASSERT(nsl_bytes_eq(out, b) && "base32 decoding was not correct");
+    }
+
+    NSL_ASSERT(nsl_bytes_from_base32(NSL_STR("MY"), &arena, &out) == NSL_ERROR_PARSE);
+    NSL_ASSERT(nsl_bytes_from_base32(NSL_STR("MZ======"), &arena, &out) == NSL_ERROR_PARSE);
+    NSL_ASSERT(nsl_bytes_from_base32(NSL_STR("my======"), &arena, &out) == NSL_ERROR_PARSE);
+    NSL_ASSERT(nsl_bytes_from_base32(NSL_STR("MZXW6Y=="), &arena, &out) == NSL_ERROR_PARSE);
+
+    nsl_arena_free(&arena);
+}
+
+static void test_nc_bytes_hash(void) {
+    nsl_Bytes b1 = NSL_BYTES_STR("abc");
+    nsl_Bytes b2 = NSL_BYTES_STR("abc");
+    nsl_Bytes b3 = NSL_BYTES_STR("bcd");
+
+    NSL_ASSERT(nsl_bytes_hash(b1) == nsl_bytes_hash(b2) && "should be equal");
+    NSL_ASSERT(nsl_bytes_hash(b1) != nsl_bytes_hash(b3) && "should not be equal");
+    NSL_ASSERT(nsl_bytes_hash_seed(b1, 1) != nsl_bytes_hash_seed(b1, 2) && "should not be equal");
+}
+
+static void test_nc_bytes_hasher(void) {
+    u8 data[1000];
+    for (usize i = 0; i < sizeof(data); i++) {
+        data[i] = (u8)(i * 31);
+    }
+
+    for (usize size = 0; size < sizeof(data); size += 77) {
+        nsl_Bytes bytes = nsl_bytes_from_parts(size, data);
+        nsl_Hasher hasher = {.seed = 69};
+        for (nsl_Bytes chunk = {0}; (chunk = nsl_bytes_take(&bytes, 13)).size;) {
+            nsl_hasher_update(&hasher, chunk);
+        }
+        const u64 hash = nsl_bytes_hash_seed(nsl_bytes_from_parts(size, data), 69);
+        NSL_ASSERT(nsl_hasher_finish(&hasher) == hash && "streaming hash is not the same");
+    }
+}
+
+static void test_nc_bytes_crc32c(void) {
+    NSL_ASSERT(nsl_bytes_crc32c(NSL_BYTES_STR("")) == 0);
+    NSL_ASSERT(nsl_bytes_crc32c(NSL_BYTES_STR("123456789")) == 0xe3069283);
+
+    u8 data[1000];
+    for (usize i = 0; i < sizeof(data); i++) {
+        data[i] = (u8)(i * 31);
+    }
+    NSL_ASSERT(nsl_bytes_crc32c(nsl_bytes_from_parts(sizeof(data), data)) == 0x1293b8a5);
+
+    for (usize size = 0; size < sizeof(data); size += 77) {
+        nsl_Bytes bytes = nsl_bytes_from_parts(size, &data[1]);
+        nsl_Crc32c crc = {0};
+        for (nsl_Bytes chunk = {0}; (chunk = nsl_bytes_take(&bytes, 13)).size;) {
+            nsl_crc32c_update(&crc, chunk);
+        }
+        const u32 expected = nsl_bytes_crc32c(nsl_bytes_from_parts(size, &data[1]));
+        NSL_ASSERT(nsl_crc32c_finish(&crc) == expected && "streaming crc is not the same");
+    }
+}
+
+static void test_nc_bytes_xxh64(void) {
+    NSL_ASSERT(nsl_bytes_xxh64(NSL_BYTES_STR(""), 0) == 0xef46db3751d8e999);
+    NSL_ASSERT(nsl_bytes_xxh64(NSL_BYTES_STR("a"), 0) == 0xd24ec4f1a98c6e5b);
+    NSL_ASSERT(nsl_bytes_xxh64(NSL_BYTES_STR("abc"), 0) == 0x44bc2cf5ad770999);
+
+    u8 data[1000];
+    for (usize i = 0; i < sizeof(data); i++) {
+        data[i] = (u8)(i * 31);
+    }
+    NSL_ASSERT(nsl_bytes_xxh64(nsl_bytes_from_parts(sizeof(data), data), 0) == 0xb1280f6428126532);
+    NSL_ASSERT(nsl_bytes_xxh64(nsl_bytes_from_parts(sizeof(data), data), 69) == 0xa920afb94398f97a);
+
+    for (usize size = 0; size < sizeof(data); size += 7) {
+        nsl_Bytes bytes = nsl_bytes_from_parts(size, data);
+        nsl_Xxh64 hasher = {.seed = 69};
+        for (nsl_Bytes chunk = {0}; (chunk = nsl_bytes_take(&bytes, 13 + size % 40)).size;) {
+            nsl_xxh64_update(&hasher, chunk);
+        }
+        const u64 hash = nsl_bytes_xxh64(nsl_bytes_from_parts(size, data), 69);
+        NSL_ASSERT(nsl_xxh64_finish(&hasher) == hash && "streaming hash is not the same");
+    }
+}
+
+int main(void) {
+    test_bytes();
+    test_nc_bytes_str();
+    test_to_hex();
+    test_nc_bytes_cmp();
+    test_nc_bytes_slice();
+    test_nc_bytes_take();
+    test_nc_bytes_from_hex();
+    test_nc_bytes_hex_buffer();
+    test_nc_bytes_base64();
+    test_nc_bytes_base32();
+    test_nc_bytes_hash();
+    test_nc_bytes_hasher();
+    test_nc_bytes_crc32c();
+    test_nc_bytes_xxh64();
+}
@@ -0,0 +1,98 @@
+#include "../nsl.h"
+
+static void test_dir_iteration(void) {
+    bool is_empty = true;
+    nsl_dir_walk(e, NSL_PATH("tests"), true) {
+        is_empty = false;
+        break;
+    }
+    NSL_ASSERT(is_empty == false && "the directory should not be empty");
+}
+
+static void test_copy_file(void) {
+    FILE *file = NULL;
+    nsl_Error error = nsl_file_open(&file, NSL_PATH("build/copy-src.bin"), "wb");
+    NSL_ASSERT(error == NSL_NO_ERROR);
+    // larger than the buffer of the fallback
+    for (usize i = 0; i < 300000; i++) {
+        nsl_file_write_fmt(file, "%09zu\n", i);
+    }
+    nsl_file_close(file);
+
+    nsl_os_remove(NSL_PATH("build/copy-dst.bin"));
+    error = nsl_os_copy_file(NSL_PATH("build/copy-src.bin"), NSL_PATH("build/copy-dst.bin"), NSL_DEFAULT);
+    NSL_ASSERT(error == NSL_NO_ERROR);
+
+    u64 expected = 0, copied = 0;
+    NSL_ASSERT(nsl_file_checksum(NSL_PATH("build/copy-src.bin"), &expected) == NSL_NO_ERROR);
+    NSL_ASSERT(nsl_file_checksum(NSL_PATH("build/copy-dst.bin"), &copied) == NSL_NO_ERROR);
+    NSL_ASSERT(expected == copied);
+
+    error = nsl_os_copy_file(NSL_PATH("build/copy-src.bin"), NSL_PATH("build/copy-dst.bin"), NSL_DEFAULT);
+    NSL_ASSERT(error == NSL_ERROR_ALREADY_EXISTS);
+    error = nsl_os_copy_file(NSL_PATH("build/copy-src.bin"), NSL_PATH("build/copy-dst.bin"), .overwrite = true);
+    NSL_ASSERT(error == NSL_NO_ERROR);
+    error = nsl_os_copy_file(NSL_PATH("build/copy-src.bin"), NSL_PATH("build/copy-src.bin"), .overwrite = true);
+    NSL_ASSERT(error == NSL_ERROR_ALREADY_EXISTS);
+    NSL_ASSERT(nsl_file_checksum(NSL_PATH("build/copy-src.bin"), &copied) == NSL_NO_ERROR);
+    NSL_ASSERT(expected == copied && "the source should not be truncated");
+
+    error = nsl_os_copy_file(NSL_PATH("build/does-not-exist"), NSL_PATH("build/copy-dst.bin"), NSL_DEFAULT);
+    NSL_ASSERT(error == NSL_ERROR_FILE_NOT_FOUND);
+    error = nsl_os_copy_file(NSL_PATH("tests"), NSL_PATH("build/copy-dst.bin"), .overwrite = true);
+    NSL_ASSERT(error == NSL_ERROR_IS_DIRECTORY);
+
+#if !defined(_WIN32)
+    // the mode is copied over an existing file and is not masked by the umask
+    struct stat info;
+    NSL_ASSERT(chmod("build/copy-src.bin", 0600) == 0);
+    error = nsl_os_copy_file(NSL_PATH("build/copy-src.bin"), NSL_PATH("build/copy-dst.bin"), .overwrite = true);
+    NSL_ASSERT(error == NSL_NO_ERROR);
+    NSL_ASSERT(stat("build/copy-dst.bin", &info) == 0 && (info.st_mode & 0777) == 0600);
+
+    // like 'cp' without '-p' the setuid bit is dropped
+    NSL_ASSERT(chmod("build/copy-src.bin", 04700) == 0);
+    error = nsl_os_copy_file(NSL_PATH("build/copy-src.bin"), NSL_PATH("build/copy-dst.bin"), .overwrite = true);
+    NSL_ASSERT(error == NSL_NO_ERROR);
+    NSL_ASSERT(stat("build/copy-dst.bin", &info) == 0 && (info.st_mode & 07777) == 0700);
+
+    NSL_ASSERT(chmod("build/copy-src.bin", 0666) == 0);
+    nsl_os_remove(NSL_PATH("build/copy-dst.bin"));
+    error = nsl_os_copy_file(NSL_PATH("build/copy-src.bin"), NSL_PATH("build/copy-dst.bin"), NSL_DEFAULT);
+    NSL_ASSERT(error == NSL_NO_ERROR);
+    NSL_ASSERT(stat("build/copy-dst.bin", &info) == 0 && (info.st_mode & 0777) == 0666);
+#endif
+}
+
+static void test_copy_dir(void) {
+    nsl_Error error = nsl_os_copy_dir(NSL_PATH("tests"), NSL_PATH("build/copy/tests"), .overwrite = true);
+    NSL_ASSERT(error == NSL_NO_ERROR);
+
+    usize count = 0;
+    nsl_dir_walk(e, NSL_PATH("tests"), true) {
+        nsl_Arena arena = {0};
+        nsl_Path copy = nsl_str_format(&arena, "build/copy/%.*s", (int)e->path.len, e->path.data);
+        NSL_ASSERT(nsl_os_exists(copy));
+        NSL_ASSERT(nsl_os_is_dir(copy) == e->is_dir);
+        if (!e->is_dir) {
+            u64 expected = 0, copied = 0;
+            NSL_ASSERT(nsl_file_checksum(e->path, &expected) == NSL_NO_ERROR);
+            NSL_ASSERT(nsl_file_checksum(copy, &copied) == NSL_NO_ERROR);
+            NSL_ASSERT(expected == copied);
+        }
+        nsl_arena_free(&arena);
+        count++;
+    }
+    NSL_ASSERT(count > 0);
+
+    error = nsl_os_copy_dir(NSL_PATH("tests"), NSL_PATH("build/copy/tests"), NSL_DEFAULT);
+    NSL_ASSERT(error == NSL_ERROR_ALREADY_EXISTS);
+    error = nsl_os_copy_dir(NSL_PATH("nsl.h"), NSL_PATH("build/copy/nsl"), NSL_DEFAULT);
+    NSL_ASSERT(error == NSL_ERROR_NOT_DIRECTORY);
+}
+
+int main(void) {
+    test_dir_iteration();
+    test_copy_file();
+    test_copy_dir();
+}
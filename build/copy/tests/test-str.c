@@ -0,0 +1,391 @@
+#include "../nsl.h"
+
+static void test_str_compare(void) {
+    nsl_Str s = NSL_STR("Hello, World");
+
+    NSL_ASSERT(nsl_str_eq(s, NSL_STR("Hello, World")) == true);
+    NSL_ASSERT(nsl_str_eq_ignorecase(s, NSL_STR("hElLo, WoRlD")) == true);
+    NSL_ASSERT(nsl_str_startswith(s, NSL_STR("Hello, ")) == true);
+    NSL_ASSERT(nsl_str_endswith(s, NSL_STR(", World")) == true);
+
+    NSL_ASSERT(nsl_str_contains(s, NSL_STR("Hell")) == true);
+    NSL_ASSERT(nsl_str_contains(s, NSL_STR("TEST")) == false);
+
+    NSL_ASSERT(nsl_str_contains(s, NSL_STR("H")) == true);
+    NSL_ASSERT(nsl_str_contains(s, NSL_STR("T")) == false);
+    NSL_ASSERT(nsl_str_contains(s, NSL_STR("")) == true);
+
+    NSL_ASSERT(nsl_str_contains_c(s, 'H') == true);
+    NSL_ASSERT(nsl_str_contains_c(s, 'e') == true);
+    NSL_ASSERT(nsl_str_contains_c(s, 'T') == false);
+
+    NSL_ASSERT(nsl_str_is_empty(s) == false && "string should not be empty");
+    NSL_ASSERT(nsl_str_is_empty(NSL_STR("")) == true && "string should be empty");
+}
+
+static void test_str_ignorecase(void) {
+    nsl_Str s = NSL_STR("Content-Type: text/html; Charset=UTF-8 [some more bytes]");
+
+    NSL_ASSERT(nsl_str_eq_ignorecase(s, NSL_STR("content-type: TEXT/HTML; charset=utf-8 [SOME MORE BYTES]")));
+    NSL_ASSERT(!nsl_str_eq_ignorecase(s, NSL_STR("content-type: TEXT/HTML; charset=utf-8 [SOME MORE BYTEZ]")));
+    NSL_ASSERT(!nsl_str_eq_ignorecase(NSL_STR("@"), NSL_STR("`")));
+
+    NSL_ASSERT(nsl_str_startswith_ignorecase(s, NSL_STR("CONTENT-type")) == true);
+    NSL_ASSERT(nsl_str_startswith_ignorecase(s, NSL_STR("type")) == false);
+
+    NSL_ASSERT(nsl_str_find_ignorecase(s, NSL_STR("CHARSET")) == 25);
+    NSL_ASSERT(nsl_str_find_ignorecase(s, NSL_STR("BYTES]")) == 50);
+    NSL_ASSERT(nsl_str_find_ignorecase(s, NSL_STR("bytes!")) == NSL_STR_NOT_FOUND);
+    NSL_ASSERT(nsl_str_find_ignorecase(s, NSL_STR("")) == 0);
+
+    nsl_StrBuffer sb = {0};
+    nsl_Str lower = nsl_str_to_lower(s, &sb);
+    NSL_ASSERT(nsl_str_eq(lower, NSL_STR("content-type: text/html; charset=utf-8 [some more bytes]")));
+    nsl_Str upper = nsl_str_to_upper(s, &sb);
+    NSL_ASSERT(nsl_str_eq(upper, NSL_STR("CONTENT-TYPE: TEXT/HTML; CHARSET=UTF-8 [SOME MORE BYTES]")));
+    NSL_ASSERT(sb.len == s.len * 2);
+    nsl_list_free(&sb);
+}
+
+static void test_str_copy(void) {
+    nsl_Arena arena = {0};
+
+    nsl_Str str = NSL_STR("Hello, World");
+    nsl_Str full = nsl_str_copy(str, &arena);
+
+    NSL_ASSERT(nsl_str_eq(full, NSL_STR("Hello, World")));
+    NSL_ASSERT(nsl_str_getc(full, 0) == 'H');
+    NSL_ASSERT(nsl_str_getc(full, 1) == 'e');
+    NSL_ASSERT(nsl_str_getc(full, 7) == 'W');
+    NSL_ASSERT(nsl_str_getc(full, full.len) == '\0');
+
+    nsl_arena_free(&arena);
+}
+
+static void test_str_append(void) {
+    nsl_Arena arena = {0};
+    nsl_Str append = nsl_str_append(NSL_STR("filename"), NSL_STR(".c"), &arena);
+    NSL_ASSERT(nsl_str_eq(append, NSL_STR("filename.c")) && "did not append correctly");
+
+    nsl_Str prepend = nsl_str_prepend(NSL_STR("filename.c"), NSL_STR("used_mark__"), &arena);
+    NSL_ASSERT(nsl_str_eq(prepend, NSL_STR("used_mark__filename.c")) && "did not prepend correctly");
+
+    nsl_Str wrap = nsl_str_wrap(NSL_STR("command here"), NSL_STR("'"), &arena);
+    NSL_ASSERT(nsl_str_eq(wrap, NSL_STR("'command here'")) && "did not wrap correctly");
+
+    nsl_arena_free(&arena);
+}
+
+static void test_str_trim(void) {
+    nsl_Str dirty = NSL_STR("\t  Hello World  \n");
+    nsl_Str trim_l = nsl_str_trim_left(dirty);
+    NSL_ASSERT(nsl_str_eq(trim_l, NSL_STR("Hello World  \n")));
+
+    nsl_Str trim_r = nsl_str_trim_right(dirty);
+    NSL_ASSERT(nsl_str_eq(trim_r, NSL_STR("\t  Hello World")));
+
+    nsl_Str trim = nsl_str_trim(dirty);
+    NSL_ASSERT(nsl_str_eq(trim, NSL_STR("Hello World")));
+}
+
+static void test_str_chop(void) {
+    nsl_Str text = NSL_STR("Hello\nThis\nis\n\ntext");
+    nsl_Str h = nsl_str_chop_by_delim(&text, '\n');
+    NSL_ASSERT(nsl_str_eq(h, NSL_STR("Hello")));
+
+    nsl_Str rest = nsl_str_chop_by_predicate(&text, nsl_char_is_space);
+    NSL_ASSERT(nsl_str_eq(rest, NSL_STR("This")));
+    rest = nsl_str_chop_by_predicate(&text, nsl_char_is_space);
+    nsl_Str test = NSL_STR("is");
+
+    NSL_ASSERT(nsl_str_eq(rest, test));
+
+    rest = nsl_str_chop_by_predicate(&text, nsl_char_is_space);
+    NSL_ASSERT(nsl_str_eq(rest, NSL_STR("")));
+
+    rest = nsl_str_chop_by_predicate(&text, nsl_char_is_space);
+    NSL_ASSERT(nsl_str_eq(rest, NSL_STR("text")));
+}
+
+static void test_str_try_chop(void) {
+    nsl_Str text = NSL_STR("Hello\nThis\nis\n\ntext");
+    nsl_Str h = {0};
+    bool t1 = nsl_str_try_chop_by_delim(&text, '\n', &h);
+    NSL_ASSERT(t1 == true);
+    NSL_ASSERT(nsl_str_eq(h, NSL_STR("Hello")));
+
+    nsl_Str rest = {0};
+    bool t2 = nsl_str_try_chop_by_delim(&text, '\n', &rest);
+    NSL_ASSERT(t2 == true);
+    NSL_ASSERT(nsl_str_eq(rest, NSL_STR("This")));
+
+    t2 = nsl_str_try_chop_by_predicate(&text, nsl_char_is_space, &rest);
+    NSL_ASSERT(t2 == true);
+    NSL_ASSERT(nsl_str_eq(rest, NSL_STR("is")));
+
+    t2 = nsl_str_try_chop_by_predicate(&text, nsl_char_is_space, &rest);
+    NSL_ASSERT(t2 == true);
+    NSL_ASSERT(nsl_str_eq(rest, NSL_STR("")));
+
+    t2 = nsl_str_try_chop_by_predicate(&text, nsl_char_is_space, &rest);
+    NSL_ASSERT(t2 == true);
+    NSL_ASSERT(nsl_str_eq(rest, NSL_STR("text")));
+
+    bool t3 = nsl_str_try_chop_by_delim(&text, '\n', &rest);
+    NSL_ASSERT(t3 == false);
+}
+
+static void test_str_chop_by_set(void) {
+    nsl_ByteSet set = nsl_byteset_from_str(NSL_STR(" ,\n"));
+    NSL_ASSERT(nsl_byteset_has(&set, ',') == true);
+    NSL_ASSERT(nsl_byteset_has(&set, 'a') == false);
+
+    nsl_Str text = NSL_STR("Hello, this is some text that is longer than thirty two bytes\nend");
+    NSL_ASSERT(nsl_str_find_by_set(text, &set) == 5);
+    NSL_ASSERT(nsl_str_find_by_set(NSL_STR("no_delimiters_in_this_long_string_at_all"), &set) == NSL_STR_NOT_FOUND);
+
+    nsl_Str chunk = nsl_str_chop_by_set(&text, &set);
+    NSL_ASSERT(nsl_str_eq(chunk, NSL_STR("Hello")));
+    NSL_ASSERT(nsl_str_try_chop_by_set(&text, &set, &chunk) == true);
+    NSL_ASSERT(nsl_str_eq(chunk, NSL_STR("")));
+
+    nsl_StrList words = {0};
+    NSL_ASSERT(nsl_str_split_all(text, &set, &words) == 12);
+    NSL_ASSERT(nsl_str_eq(words.items[0], NSL_STR("this")));
+    NSL_ASSERT(nsl_str_eq(words.items[10], NSL_STR("bytes")));
+    NSL_ASSERT(nsl_str_eq(words.items[11], NSL_STR("end")));
+    nsl_list_free(&words);
+
+    u8 high[] = {'a', 0x80, 'b', 0xff, 'c'};
+    nsl_ByteSet high_set = {0};
+    nsl_byteset_add(&high_set, 0xff);
+    NSL_ASSERT(nsl_str_find_by_set(nsl_str_from_parts(sizeof(high), (const char *)high), &high_set) == 3);
+
+    nsl_ByteSet spaces = nsl_byteset_from_predicate(nsl_char_is_space);
+    nsl_Str padded = NSL_STR("................................\t...");
+    NSL_ASSERT(nsl_str_find_by_set(padded, &spaces) == 32);
+}
+
+static void test_str_chop_right(void) {
+    nsl_Str text = NSL_STR("Hello\n\nThis is  text");
+    nsl_Str rest[] = {
+        nsl_str_chop_right_by_delim(&text, '\n'),
+        nsl_str_chop_right_by_delim(&text, '\n'),
+        nsl_str_chop_right_by_delim(&text, '\n'),
+        nsl_str_chop_right_by_delim(&text, '\n'),
+        nsl_str_chop_right_by_delim(&text, '\n'),
+    };
+
+    NSL_ASSERT(nsl_str_eq(rest[0], NSL_STR("This is  text")));
+    NSL_ASSERT(nsl_str_eq(rest[1], NSL_STR("")));
+    NSL_ASSERT(nsl_str_eq(rest[2], NSL_STR("Hello")));
+    NSL_ASSERT(nsl_str_eq(rest[3], NSL_STR("")));
+}
+
+static void test_str_number_converting(void) {
+    nsl_Arena arena = {0};
+
+    const u32 N = 64;
+    nsl_Str number = nsl_str_format(&arena, "%d", N);
+    NSL_ASSERT(nsl_str_eq(number, NSL_STR("64")));
+
+    nsl_Str n = nsl_str_append(number, NSL_STR(" bytes"), &arena);
+    NSL_ASSERT(nsl_str_eq(n, NSL_STR("64 bytes")));
+
+    u64 u = 0;
+    NSL_ASSERT(nsl_str_u64(n, &u) == NSL_ERROR_PARSE);
+    NSL_ASSERT(nsl_str_chop_u64(&n, &u) == NSL_NO_ERROR);
+    NSL_ASSERT(u == 64);
+    NSL_ASSERT(n.len == 6);
+    NSL_ASSERT(nsl_str_eq(n, NSL_STR(" bytes")));
+
+    nsl_Str e = NSL_STR("420");
+    NSL_ASSERT(nsl_str_u64(e, &u) == NSL_NO_ERROR);
+    NSL_ASSERT(u == 420);
+
+    nsl_Str x = NSL_STR("0xAA");
+    u64 xx = 0;
+    NSL_ASSERT(nsl_str_u64(x, &xx) == NSL_NO_ERROR);
+    NSL_ASSERT(xx == 0xAA);
+
+    nsl_Str i = NSL_STR("-420");
+    i64 ii = 0;
+    NSL_ASSERT(nsl_str_i64(i, &ii) == NSL_NO_ERROR);
+    NSL_ASSERT(ii == -420);
+    NSL_ASSERT(nsl_str_chop_i64(&i, &ii) == NSL_NO_ERROR);
+    NSL_ASSERT(ii == -420);
+    NSL_ASSERT(i.len == 0);
+
+    nsl_Str f = NSL_STR("420.69");
+
+    f64 ff;
+    NSL_ASSERT(nsl_str_f64(f, &ff) == NSL_NO_ERROR);
+    NSL_ASSERT(ff == 420.69);
+
+    NSL_ASSERT(nsl_str_chop_f64(&f, &ff) == NSL_NO_ERROR);
+    NSL_ASSERT(ff == 420.69);
+    NSL_ASSERT(f.len == 0);
+
+    nsl_arena_free(&arena);
+}
+
+static void test_str_find(void) {
+    nsl_Str s = NSL_STR("Hello, World");
+    NSL_ASSERT(nsl_str_find(s, NSL_STR("Hello")) == 0);
+    NSL_ASSERT(nsl_str_find_last(s, NSL_STR("Hello")) == 0);
+    NSL_ASSERT(nsl_str_find(s, NSL_STR("World")) == 7);
+    NSL_ASSERT(nsl_str_find_last(s, NSL_STR("World")) == 7);
+    NSL_ASSERT(nsl_str_find(s, NSL_STR("TEST")) == NSL_STR_NOT_FOUND);
+}
+
+static void test_str_count(void) {
+    nsl_Str s = NSL_STR("Hello, World");
+    usize c = nsl_str_count(s, NSL_STR("o"));
+    NSL_ASSERT(c == 2);
+    c = nsl_str_count(s, NSL_STR("TEST"));
+    NSL_ASSERT(c == 0);
+
+    s = NSL_STR("--help");
+    c = nsl_str_count(s, NSL_STR("-"));
+    NSL_ASSERT(c == 2);
+}
+
+static void test_str_substring(void) {
+    nsl_Str s = NSL_STR("Hello, World");
+    nsl_Str substring = nsl_str_substring(s, 0, 4);
+    nsl_Str invalid1 = nsl_str_substring(s, 4, 2);
+    nsl_Str invalid2 = nsl_str_substring(s, s.len, 2);
+
+    NSL_ASSERT(nsl_str_eq(substring, NSL_STR("Hell")));
+    NSL_ASSERT(nsl_str_eq(invalid1, NSL_STR("")));
+    NSL_ASSERT(nsl_str_eq(invalid2, NSL_STR("")));
+}
+
+static void test_str_join(void) {
+    nsl_Arena arena = {0};
+    nsl_Str res =
+        nsl_str_join(NSL_STR(", "), 2, (nsl_Str[2]){NSL_STR("Hello"), NSL_STR("World")}, &arena);
+    NSL_ASSERT(nsl_str_eq(res, NSL_STR("Hello, World")));
+
+    nsl_Str res2 =
+        nsl_str_join_suffix(NSL_STR(", "), 2, (nsl_Str[2]){NSL_STR("Hello"), NSL_STR("World")}, &arena);
+    NSL_ASSERT(nsl_str_eq(res2, NSL_STR("Hello, World, ")));
+
+    nsl_Str res3 =
+        nsl_str_join_prefix(NSL_STR(", "), 2, (nsl_Str[2]){NSL_STR("Hello"), NSL_STR("World")}, &arena);
+    NSL_ASSERT(nsl_str_eq(res3, NSL_STR(", Hello, World")));
+
+    nsl_Str res4 = nsl_str_join_wrap(NSL_STR(" "), NSL_STR("'"), 2,
+                                   (nsl_Str[2]){NSL_STR("One"), NSL_STR("Two")}, &arena);
+    NSL_ASSERT(nsl_str_eq(res4, NSL_STR("'One' 'Two'")));
+
+    nsl_Str res5 = nsl_str_join(NSL_STR(" "), 0, NULL, &arena);
+    NSL_ASSERT(nsl_str_eq(res5, NSL_STR("")));
+
+    nsl_arena_free(&arena);
+}
+
+static void test_str_hash(void) {
+    const struct {
+        nsl_Str s;
+        u64 hash;
+    } tests[] = {
+        {NSL_STR("Hello"), 0xc5a7afb07d03565c},
+        {NSL_STR("This is a very long string"), 0x13c1665277480614},
+        {NSL_STR("Another"), 0x280c5deec07a450e},
+        {NSL_STR("Hello"), 0xc5a7afb07d03565c},
+    };
+
+    for (size_t i = 0; i < sizeof(tests) / sizeof(tests[0]); i++) {
+        const u64 hash = nsl_str_hash(tests[i].s);
+        NSL_ASSERT(hash == tests[i].hash);
+        NSL_ASSERT(hash == nsl_bytes_hash(nsl_str_to_bytes(tests[i].s)));
+        NSL_ASSERT(hash != nsl_str_hash_seed(tests[i].s, 1));
+    }
+}
+
+static void test_str_utf8(void) {
+    nsl_Str s = NSL_STR("Grüße, 日本語! \xf0\x9f\x98\x80 and some more ascii to fill a block");
+    NSL_ASSERT(nsl_str_utf8_validate(s) == true);
+    NSL_ASSERT(nsl_str_utf8_validate(NSL_STR("")) == true);
+    NSL_ASSERT(nsl_str_utf8_validate(NSL_STR("over long \xc0\x80")) == false);
+    NSL_ASSERT(nsl_str_utf8_validate(NSL_STR("surrogate \xed\xa0\x80")) == false);
+    NSL_ASSERT(nsl_str_utf8_validate(NSL_STR("too large \xf4\x90\x80\x80")) == false);
+    NSL_ASSERT(nsl_str_utf8_validate(NSL_STR("lonely continuation \x80")) == false);
+    NSL_ASSERT(nsl_str_utf8_validate(NSL_STR("truncated at the end of the block \xe6\x97")) == false);
+
+    NSL_ASSERT(nsl_str_utf8_count(s) == 49);
+    NSL_ASSERT(nsl_str_utf8_index(s, 9) == 7);
+    NSL_ASSERT(nsl_str_utf8_offset(s, 7) == 9);
+    NSL_ASSERT(nsl_str_utf8_offset(s, 100) == s.len);
+
+    u32 expected[] = {'G', 'r', 0xfc, 0xdf, 'e', ',', ' ', 0x65e5, 0x672c, 0x8a9e, '!', ' ', 0x1f600};
+    nsl_Str it = s;
+    for (usize i = 0; i < NSL_ARRAY_LEN(expected); i++) {
+        u32 cp = 0;
+        NSL_ASSERT(nsl_str_utf8_try_chop(&it, &cp) == true);
+        NSL_ASSERT(cp == expected[i]);
+    }
+
+    nsl_Str invalid = NSL_STR("\xff!");
+    u32 cp = 0;
+    NSL_ASSERT(nsl_str_utf8_try_chop(&invalid, &cp) == true && cp == 0xfffd);
+    NSL_ASSERT(nsl_str_utf8_try_chop(&invalid, &cp) == true && cp == '!');
+    NSL_ASSERT(nsl_str_utf8_try_chop(&invalid, &cp) == false);
+}
+
+static void test_str_format(void) {
+    nsl_Arena arena = {0};
+    nsl_Str s = nsl_str_format(&arena, "%d %d", 420, 69);
+    NSL_ASSERT(nsl_str_eq(s, NSL_STR("420 69")) && "Should format correctly!");
+    nsl_arena_free(&arena);
+}
+
+static void test_str_take(void) {
+    nsl_Str s = NSL_STR("what a wonderful string");
+    NSL_ASSERT(nsl_str_eq(nsl_str_take(&s, 2), NSL_STR("wh")));
+    NSL_ASSERT(nsl_str_eq(nsl_str_take_right(&s, 2), NSL_STR("ng")));
+
+    NSL_ASSERT(nsl_str_eq(nsl_str_take(&s, 8), NSL_STR("at a won")));
+    NSL_ASSERT(nsl_str_eq(nsl_str_take_right(&s, 5), NSL_STR(" stri")));
+
+    NSL_ASSERT(nsl_str_eq(s, NSL_STR("derful")));
+}
+
+static void test_str_try_take(void) {
+    nsl_Str s = NSL_STR("what a wonderful string");
+
+    nsl_Str chunk = {0};
+    NSL_ASSERT(nsl_str_try_take(&s, 7, &chunk) == true);
+    NSL_ASSERT(nsl_str_eq(chunk, NSL_STR("what a ")));
+
+    NSL_ASSERT(nsl_str_try_take_right(&s, 7, &chunk) == true);
+    NSL_ASSERT(nsl_str_eq(chunk, NSL_STR(" string")));
+
+    NSL_ASSERT(nsl_str_eq(s, NSL_STR("wonderful")));
+    NSL_ASSERT(nsl_str_try_take_right(&s, 9, &chunk) == true);
+
+    NSL_ASSERT(nsl_str_try_take_right(&s, 2, &chunk) == false);
+}
+
+int main(void) {
+    test_str_compare();
+    test_str_ignorecase();
+    test_str_copy();
+    test_str_append();
+    test_str_trim();
+    test_str_chop();
+    test_str_try_chop();
+    test_str_chop_by_set();
+    test_str_chop_right();
+    test_str_number_converting();
+    test_str_find();
+    test_str_count();
+    test_str_substring();
+    test_str_join();
+    test_str_hash();
+    test_str_utf8();
+    test_str_format();
+    test_str_take();
+    test_str_try_take();
+}
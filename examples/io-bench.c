@@ -0,0 +1,95 @@
+#define NSL_IMPLEMENTATION
+#include "../nsl.h"
+
+#include <time.h>
+
+// Reads a directory of small files one by one with stdio, then in batches with 'nsl_IoQueue', once
+// with io_uring (where it is available) and once with the worker pool. The files are created on the
+// first run, so every run after that reads them from the page cache.
+//
+//   gcc -O2 -o io-bench examples/io-bench.c && ./io-bench [directory] [count]
+
+#define BATCH 1024
+
+static f64 seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (f64)ts.tv_sec + (f64)ts.tv_nsec / 1e9;
+}
+
+static usize read_stdio(usize count, const nsl_Path *paths) {
+    nsl_Arena arena = {0};
+    usize bytes = 0;
+    for (usize i = 0; i < count; i++) {
+        if (i % BATCH == 0) nsl_arena_reset(&arena);
+        FILE *file = NULL;
+        if (nsl_file_open(&file, paths[i], "r")) NSL_PANIC("could not open file!");
+        bytes += nsl_file_read_str(file, &arena).len;
+        nsl_file_close(file);
+    }
+    nsl_arena_free(&arena);
+    return bytes;
+}
+
+static usize read_queue(usize count, const nsl_Path *paths, bool use_pool) {
+    nsl_Arena arena = {0};
+    nsl_IoQueue queue = {.use_pool = use_pool, .arena = &arena};
+    static nsl_IoRequest requests[BATCH];
+    usize bytes = 0;
+    for (usize start = 0; start < count; start += BATCH) {
+        // the reads of the last batch were returned, so the arena can be reused
+        nsl_arena_reset(&arena);
+        const usize len = nsl_usize_min(BATCH, count - start);
+        for (usize i = 0; i < len; i++) {
+            requests[i] = (nsl_IoRequest){.op = NSL_IO_READ, .path = paths[start + i]};
+        }
+        nsl_io_submit(&queue, len, requests);
+        for (nsl_IoRequest *request; (request = nsl_io_next(&queue)) != NULL;) {
+            if (request->error) NSL_PANIC("could not read file!");
+            bytes += request->data.size;
+        }
+    }
+    nsl_io_queue_free(&queue);
+    nsl_arena_free(&arena);
+    return bytes;
+}
+
+int main(int argc, const char **argv) {
+    const nsl_Path dir = argc < 2 ? NSL_PATH("build/io-bench") : nsl_str_from_cstr(argv[1]);
+    const usize count = argc < 3 ? 100000 : (usize)strtoull(argv[2], NULL, 10);
+
+    nsl_Arena arena = {0};
+    nsl_Path *paths = nsl_arena_alloc(&arena, count * sizeof(nsl_Path));
+    for (usize i = 0; i < count; i++) {
+        paths[i] = nsl_str_format(&arena, NSL_STR_FMT "/%zu.txt", NSL_STR_ARG(dir), i);
+    }
+
+    if (!nsl_os_exists(paths[count - 1])) {
+        printf("creating %zu files in " NSL_STR_FMT "\n", count, NSL_STR_ARG(dir));
+        if (nsl_os_mkdir(dir, .exists_ok = true, .parents = true)) NSL_PANIC("could not create directory!");
+        nsl_IoQueue queue = {.arena = &arena};
+        nsl_IoRequest *writes = nsl_arena_alloc(&arena, count * sizeof(nsl_IoRequest));
+        for (usize i = 0; i < count; i++) {
+            const nsl_Str content = nsl_str_format(&arena, "file %zu\n", i);
+            writes[i] = (nsl_IoRequest){.op = NSL_IO_WRITE, .path = paths[i], .data = nsl_str_to_bytes(content)};
+        }
+        nsl_io_submit(&queue, count, writes);
+        nsl_io_wait(&queue);
+        nsl_io_queue_free(&queue);
+    }
+
+    f64 start = seconds();
+    usize bytes = read_stdio(count, paths);
+    printf("stdio:    %zu files, %zu bytes, %.3fs\n", count, bytes, seconds() - start);
+
+    start = seconds();
+    bytes = read_queue(count, paths, false);
+    printf("io_uring: %zu files, %zu bytes, %.3fs\n", count, bytes, seconds() - start);
+
+    start = seconds();
+    bytes = read_queue(count, paths, true);
+    printf("pool:     %zu files, %zu bytes, %.3fs\n", count, bytes, seconds() - start);
+
+    nsl_arena_free(&arena);
+    return 0;
+}
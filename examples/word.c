@@ -7,9 +7,9 @@ typedef struct {
     usize count;
 } Occurence;
 
-static i32 cmp(const void *a, const void *b) {
-    return ((const Occurence *)b)->count - ((const Occurence *)a)->count;
-}
+// generates 'sort_by_count' and friends, sorts with the comparison inlined
+#define MORE_OCCURENCES(a, b) ((a).count > (b).count)
+NSL_SORT_DEFINE(sort_by_count, Occurence, MORE_OCCURENCES)
 
 typedef struct {
     nsl_Map map;
@@ -23,11 +23,11 @@ int main(int argc, const char **argv) {
     // preparing the memory arena
     nsl_Arena arena = {0};
 
-    // reading the entire file
-    FILE *file;
-    if (nsl_file_open(&file, filename, "r")) NSL_PANIC("could not open file!");
-    nsl_Str content = nsl_file_read_str(file, &arena);
-    nsl_file_close(file);
+    // mapping the entire file, the words point straight into the page cache
+    nsl_FileMap map = {0};
+    if (nsl_file_map(filename, &map)) NSL_PANIC("could not open file!");
+    nsl_file_map_advise(&map, NSL_FILE_MAP_SEQUENTIAL);
+    nsl_Str content = nsl_str_from_bytes(map.bytes);
 
     // initializing the map and list to allocate memory inside the arena
     Occurences occurences = {
@@ -35,8 +35,11 @@ int main(int argc, const char **argv) {
         .list.arena = &arena,
     };
 
+    // building the set of delimiters once, so the chopping can test many bytes at once
+    nsl_ByteSet delimiters = nsl_byteset_from_predicate(nsl_char_is_space);
+
     // for (word in content)
-    for (nsl_Str word = {0}; nsl_str_try_chop_by_predicate(&content, nsl_char_is_space, &word);) {
+    for (nsl_Str word = {0}; nsl_str_try_chop_by_set(&content, &delimiters, &word);) {
         // skip empty words
         if (word.len == 0) continue;
         // hash the word
@@ -53,8 +56,8 @@ int main(int argc, const char **argv) {
         }
     }
 
-    // sort list with qsort (invalidates map)
-    nsl_list_sort(&occurences.list, cmp);
+    // only sort the top 3 (invalidates map)
+    nsl_list_partial_sort(&occurences.list, sort_by_count, 3);
 
     // list top 3 occurences
     for (usize i = 0; i < 3; i++) {
@@ -64,5 +67,6 @@ int main(int argc, const char **argv) {
 
     // free the memory
     nsl_arena_free(&arena);
+    nsl_file_unmap(&map);
     return 0;
 }
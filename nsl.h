@@ -3,6 +3,12 @@
 #ifndef _NSL_H_
 #define _NSL_H_
 
+#if defined(NSL_IMPLEMENTATION) && !defined(_WIN32) && !defined(_WIN64) && !defined(_DEFAULT_SOURCE)
+// the implementation uses 'madvise', 'fchmod' and 'syscall', which are hidden in strict c99 mode. It
+// only has an effect if 'nsl.h' is included before any system header in the implementation file
+#   define _DEFAULT_SOURCE
+#endif
+
 #include <stdbool.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -146,6 +152,8 @@ typedef nsl_List(char) nsl_StrBuffer;
 
 typedef nsl_List(u8) nsl_ByteBuffer;
 
+typedef nsl_List(nsl_Str) nsl_StrList;
+
 #define nsl_bb_push_bytes(bb, size, bytes) nsl_list_extend(bb, size, (const u8*)bytes)
 #define nsl_bb_push_var(bb, var)           nsl_list_extend(bb, sizeof(var), (const u8*)&var)
 
@@ -192,6 +200,7 @@ typedef nsl_List(u8) nsl_ByteBuffer;
 #    define NSL_FMT(fmt_idx)  __attribute__((format(printf, fmt_idx, fmt_idx + 1)))
 #elif defined(_MSC_VER)
 #    include <sal.h>
+#    include <intrin.h>
 #    define NSL_EXPORT        __declspec(dllexport)
 #    define NSL_NORETURN      __declspec(noreturn)
 #    define NSL_PURE_FN       _Check_return_
@@ -222,6 +231,26 @@ typedef nsl_List(u8) nsl_ByteBuffer;
 #    error "No Byte Order detected!"
 #endif
 
+// define 'NSL_NO_SIMD' to force the scalar implementations
+#if !defined(NSL_NO_SIMD)
+#    if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#        define NSL_SSE2
+#    endif
+#    if defined(__SSSE3__) || defined(__AVX__)
+#        define NSL_SSSE3
+#    endif
+#    if defined(__SSE4_2__) || defined(__AVX__)
+#        define NSL_SSE42
+#    endif
+#    if defined(__AVX2__)
+#        define NSL_AVX2
+#    endif
+#endif
+
+#if defined(NSL_SSE2) || defined(NSL_SSSE3) || defined(NSL_SSE42) || defined(NSL_AVX2)
+#    include <immintrin.h>
+#endif
+
 
 NSL_API void nsl_arena_free(nsl_Arena *arena);
 
@@ -278,10 +307,13 @@ NSL_API nsl_DirEntry *nsl_dir_next(nsl_DirIter *it);
 
 typedef struct {
   void *handle;
+  bool _copy; // loaded from a temporary copy that is deleted on close
 } nsl_Dll;
 
 typedef void (*nsl_Function)(void);
 
+// Names without a directory are searched by the system loader. On Windows other paths are loaded
+// from a temporary copy, so the library can be rebuilt while it is loaded.
 NSL_API nsl_Error nsl_dll_load(nsl_Dll* dll, nsl_Path path);
 NSL_API void nsl_dll_close(nsl_Dll *dll);
 
@@ -297,12 +329,265 @@ NSL_API nsl_Str nsl_file_read_str(FILE *file, nsl_Arena *arena);
 NSL_API nsl_Str nsl_file_read_sb(FILE *file, nsl_StrBuffer *sb);
 NSL_API nsl_Str nsl_file_read_line(FILE *file, nsl_StrBuffer *sb);
 
+#define NSL_READER_SIZE (64 * 1024)
+
+typedef enum {
+    NSL_COMPRESSION_AUTO, // detected from the first bytes
+    NSL_COMPRESSION_NONE,
+    NSL_COMPRESSION_GZIP, // gzip or zlib streams, needs zlib
+    NSL_COMPRESSION_ZSTD, // needs libzstd
+} nsl_Compression;
+
+// Decompresses 'file' while it is read, with 'NSL_READER_SIZE' of input buffer. Only 'file' has
+// to be set. The libraries are loaded with 'nsl_dll_load' on first use, so there is no link time
+// dependency.
+typedef struct {
+    FILE *file;
+    nsl_Compression compression;
+    nsl_Error error; // 'NSL_ERROR_FILE_NOT_FOUND' if the library is missing, 'NSL_ERROR_PARSE' on corrupt data
+    void *_state;
+} nsl_Reader;
+
+// Returns empty bytes at the end of the data or on an error.
+NSL_API nsl_Bytes nsl_reader_read(nsl_Reader *reader, usize size, u8 *buffer);
+NSL_API void nsl_reader_free(nsl_Reader *reader);
+
+#define NSL_LINE_READER_SIZE (64 * 1024)
+
+// Reads lines through a refillable buffer. Only 'file' or 'source' has to be set, 'cap' is the
+// initial buffer size and defaults to 'NSL_LINE_READER_SIZE'. The buffer grows for lines that do
+// not fit.
+typedef struct {
+    FILE *file;
+    nsl_Reader *source; // read instead of 'file' if set
+    nsl_Arena *arena;
+    usize cap;
+    usize start;
+    usize end;
+    bool eof;
+    char *buffer;
+} nsl_LineReader;
+
+// The line includes the '\n', except for the last line if the file does not end with one.
+// 'line' points into the buffer and is valid until the next call.
+NSL_API bool nsl_line_reader_next(nsl_LineReader *reader, nsl_Str *line);
+NSL_API void nsl_line_reader_free(nsl_LineReader *reader);
+
+// Follows a file that is appended to, like 'tail -F'. Only 'path' has to be set, it has to stay
+// valid. The file is read from the beginning, 'offset' can be set to start somewhere else.
+// Truncated files are read again from the start, replaced files (log rotation) are reopened.
+typedef struct {
+    nsl_Path path;
+    nsl_Arena *arena;
+    u64 offset; // of the next byte that is read
+    usize cap;
+    usize start;
+    usize end;
+    char *buffer;
+    bool _opened;
+    bool _watching;
+    isize _file;
+    isize _watch;
+    u64 _id[2];
+} nsl_FileFollower;
+
+// Returns the next complete line including the '\n'. When there is none it waits up to
+// 'timeout_ms' for the file to change, and returns false if there still is none. A negative
+// timeout waits until there is a line. Waiting uses inotify on Linux and change notifications on
+// Windows, and polls the file elsewhere. 'line' is valid until the next call.
+NSL_API bool nsl_file_follower_next(nsl_FileFollower *follower, i32 timeout_ms, nsl_Str *line);
+NSL_API void nsl_file_follower_free(nsl_FileFollower *follower);
+
 NSL_API nsl_Bytes nsl_file_read_bytes(FILE *file, usize size, u8 *buffer);
 
 NSL_API NSL_FMT(2) void nsl_file_write_fmt(FILE* file, const char* fmt, ...);
 NSL_API void nsl_file_write_str(FILE *file, nsl_Str content);
 NSL_API void nsl_file_write_bytes(FILE *file, nsl_Bytes content);
 
+#define NSL_WRITER_SIZE (64 * 1024)
+
+// Buffers writes to a file descriptor. Only 'fd' has to be set, 'cap' is the buffer size and
+// defaults to 'NSL_WRITER_SIZE'. The buffer is written when it is full or on 'nsl_writer_flush'.
+typedef struct {
+    int fd;
+    nsl_Arena *arena;
+    usize cap;
+    usize len;
+    char *buffer;
+    nsl_Error error; // the first failed write, the data of later writes is dropped
+} nsl_Writer;
+
+// Creates or truncates the file.
+NSL_API nsl_Error nsl_writer_open(nsl_Path path, nsl_Writer *out);
+
+NSL_API void nsl_writer_write_str(nsl_Writer *writer, nsl_Str content);
+NSL_API void nsl_writer_write_bytes(nsl_Writer *writer, nsl_Bytes content);
+NSL_API NSL_FMT(2) void nsl_writer_write_fmt(nsl_Writer *writer, const char *fmt, ...);
+NSL_API void nsl_writer_write_u64(nsl_Writer *writer, u64 value);
+NSL_API void nsl_writer_write_i64(nsl_Writer *writer, i64 value);
+// Writes the buffered data followed by 'parts' with as few system calls as possible ('writev').
+NSL_API void nsl_writer_writev(nsl_Writer *writer, usize count, const nsl_Bytes *parts);
+
+// Returns 'error'.
+NSL_API nsl_Error nsl_writer_flush(nsl_Writer *writer);
+// Flushes and frees the buffer, the file descriptor stays open.
+NSL_API nsl_Error nsl_writer_free(nsl_Writer *writer);
+// Flushes, frees the buffer and closes the file descriptor.
+NSL_API nsl_Error nsl_writer_close(nsl_Writer *writer);
+
+// Writes to a temporary file next to 'path', syncs it and renames it over 'path'. After a crash the
+// file has either the old or the new content.
+NSL_API nsl_Error nsl_file_write_atomic(nsl_Path path, nsl_Bytes content);
+
+typedef struct {
+    nsl_Path path;
+    nsl_Path temp;
+    u64 device;
+} nsl_AtomicWrite;
+
+// Collects atomic writes that become durable together. On Linux a commit syncs every file system
+// twice ('syncfs') instead of every file and directory once.
+typedef struct {
+    nsl_Arena arena;
+    nsl_List(nsl_AtomicWrite) writes;
+} nsl_FileBatch;
+
+// Writes the content to a temporary file, 'path' is not changed until the commit.
+NSL_API nsl_Error nsl_file_batch_write(nsl_FileBatch *batch, nsl_Path path, nsl_Bytes content);
+// Syncs the temporary files, renames them over their paths and syncs the directories.
+NSL_API nsl_Error nsl_file_batch_commit(nsl_FileBatch *batch);
+// Removes the temporary files of writes that were not committed.
+NSL_API void nsl_file_batch_free(nsl_FileBatch *batch);
+
+// XXH64 (seed 0) of the file content, read in fixed size blocks.
+NSL_API nsl_Error nsl_file_checksum(nsl_Path path, u64 *out);
+
+// Read only view of a whole file, backed by the page cache instead of a copy.
+typedef struct {
+    nsl_Bytes bytes;
+    void *_handle;
+} nsl_FileMap;
+
+typedef enum {
+    NSL_FILE_MAP_NORMAL     = 0,
+    NSL_FILE_MAP_SEQUENTIAL = 1 << 0, // aggressive read ahead, pages can be dropped once read
+    NSL_FILE_MAP_RANDOM     = 1 << 1, // no read ahead
+    NSL_FILE_MAP_WILLNEED   = 1 << 2, // starts reading the whole file in the background
+    NSL_FILE_MAP_HUGEPAGE   = 1 << 3, // transparent huge pages, if the file system supports it
+} nsl_FileMapAdvice;
+
+// Empty files map to empty bytes. The view stays valid until 'nsl_file_unmap'.
+NSL_API nsl_Error nsl_file_map(nsl_Path path, nsl_FileMap *out);
+// Hints are best effort and ignored where the platform has no equivalent.
+NSL_API void nsl_file_map_advise(const nsl_FileMap *map, nsl_FileMapAdvice advice);
+NSL_API void nsl_file_unmap(nsl_FileMap *map);
+
+// Append only file of length prefixed and checksummed records. The record offsets are kept in an
+// index at the end, so opening a file only maps it and reads the header and the footer.
+//
+//   header  "NSLF", u32 version
+//   record  u32 size, u32 crc32c of the data, data, zero padding to 8 bytes
+//   index   u64 offset of every record
+//   footer  u64 count, u64 index offset, u32 crc32c of the index, u32 crc32c of the footer so far, "NSLF"
+//
+// Integers are little endian. The data of every record is 8 byte aligned in the file. Appending
+// writes the new records, the whole index and a footer after the old footer.
+typedef struct {
+    nsl_Writer writer;
+    u64 offset;
+    nsl_List(u64) index;
+    nsl_ByteBuffer buffer;
+} nsl_RecordWriter;
+
+// Creates or truncates the file.
+NSL_API nsl_Error nsl_record_writer_open(nsl_Path path, nsl_RecordWriter *out);
+// Adds records to an existing file. The old index and footer are kept, so until
+// 'nsl_record_writer_close' writes the new ones the file opens with the old records.
+NSL_API nsl_Error nsl_record_writer_append(nsl_Path path, nsl_RecordWriter *out);
+NSL_API void nsl_record_write(nsl_RecordWriter *writer, nsl_Bytes record);
+#define nsl_record_write_str(writer, s) nsl_record_write(writer, nsl_str_to_bytes(s))
+// Writes the items of a list as one record. The data can be cast back to the item type.
+#define nsl_record_write_list(writer, list)                                                        \
+    nsl_record_write(writer, nsl_bytes_from_parts((list)->len * sizeof(*(list)->items), (list)->items))
+// Writes the index and closes the file. Returns the first error of any write.
+NSL_API nsl_Error nsl_record_writer_close(nsl_RecordWriter *writer);
+
+typedef struct {
+    nsl_FileMap map;
+    usize count;
+    nsl_Bytes _index;
+} nsl_RecordFile;
+
+// Returns 'NSL_ERROR_PARSE' if the header or the footer are damaged. If the last footer is not
+// complete, because an append did not finish, the file is searched backwards for the one before.
+NSL_API nsl_Error nsl_record_file_open(nsl_Path path, nsl_RecordFile *out);
+// 'out' points into the mapping. Returns 'NSL_ERROR_PARSE' if the checksum does not match.
+NSL_API nsl_Error nsl_record_file_get(const nsl_RecordFile *file, usize idx, nsl_Bytes *out);
+// Checks the index and every record, so it reads the whole file. Returns 'NSL_ERROR_PARSE' on
+// the first damaged one.
+NSL_API nsl_Error nsl_record_file_verify(const nsl_RecordFile *file);
+NSL_API void nsl_record_file_close(nsl_RecordFile *file);
+
+// Splits the content into chunks that end at a delimiter and calls 'map' for every chunk on a
+// pool of worker threads. Every worker has its own arena for the results, which are passed to
+// 'reduce' in chunk order on the calling thread. The arenas are freed afterwards.
+typedef struct {
+    usize threads; // defaults to 'nsl_os_cpu_count'
+    usize chunks;  // defaults to 4 per thread
+    char delim;    // defaults to '\n'
+    void *ctx;
+    void *(*map)(void *ctx, nsl_Str chunk, nsl_Arena *arena);
+    void (*reduce)(void *ctx, void *result);
+} nsl_ChunkConfig;
+
+#define nsl_str_process_chunks(content, ...)                                                       \
+    nsl_str_process_chunks_conf(content, (nsl_ChunkConfig){__VA_ARGS__})
+#define nsl_file_process_chunks(path, ...)                                                         \
+    nsl_file_process_chunks_conf(path, (nsl_ChunkConfig){__VA_ARGS__})
+
+NSL_API nsl_Error nsl_str_process_chunks_conf(nsl_Str content, nsl_ChunkConfig config);
+// Maps the file with 'nsl_file_map'.
+NSL_API nsl_Error nsl_file_process_chunks_conf(nsl_Path path, nsl_ChunkConfig config);
+
+typedef enum {
+    NSL_IO_READ,   // reads the whole file into 'data'
+    NSL_IO_WRITE,  // replaces the file content with 'data'
+    NSL_IO_APPEND, // appends 'data' to the file
+} nsl_IoOp;
+
+// 'path' and 'data' have to stay valid until the request is completed.
+typedef struct {
+    nsl_IoOp op;
+    nsl_Path path;
+    nsl_Bytes data;
+    void *ctx;
+    nsl_Error error; // set on completion
+} nsl_IoRequest;
+
+// Completes file requests with io_uring on Linux, and on a pool of worker threads where io_uring
+// is not available. Both are set up on the first submit. With io_uring the requests make progress
+// on the calling thread inside 'nsl_io_submit', 'nsl_io_next' and 'nsl_io_wait'.
+// Reads are allocated in 'arena' (or an arena owned by the queue), which must not be used by the
+// caller while reads are pending.
+typedef struct {
+    usize threads; // defaults to 'nsl_os_cpu_count'
+    bool use_pool; // uses the worker pool even if io_uring is available
+    nsl_Arena *arena;
+    void *_state;
+} nsl_IoQueue;
+
+// The requests are not copied and have to stay valid until they are completed.
+NSL_API void nsl_io_submit(nsl_IoQueue *queue, usize count, nsl_IoRequest *requests);
+// Returns a completed request, in any order, or 'NULL' if no request is pending. With the pool,
+// instead of blocking, the calling thread completes pending requests itself.
+NSL_API nsl_IoRequest *nsl_io_next(nsl_IoQueue *queue);
+// Blocks until every submitted request is completed.
+NSL_API void nsl_io_wait(nsl_IoQueue *queue);
+// Completes a single request on the calling thread, the workers are not started.
+NSL_API void nsl_io_perform(nsl_IoQueue *queue, nsl_IoRequest *request);
+// Completes the pending requests before the workers are stopped. Frees the owned arena.
+NSL_API void nsl_io_queue_free(nsl_IoQueue *queue);
+
 
 typedef struct {
     u32 mode;       // set the directory mode (default = 0755)
@@ -316,6 +601,7 @@ NSL_API nsl_Error nsl_os_mkdir_conf(nsl_Path path, nsl_OsDirConfig config);
 NSL_API nsl_Error nsl_os_chdir(nsl_Path path);
 NSL_API nsl_Path nsl_os_cwd(nsl_Arena *arena);
 NSL_API nsl_Str nsl_os_getenv(const char *env, nsl_Arena *arena);
+NSL_API usize nsl_os_cpu_count(void);
 
 NSL_API bool nsl_os_exists(nsl_Path path);
 NSL_API bool nsl_os_is_dir(nsl_Path path);
@@ -323,6 +609,21 @@ NSL_API nsl_Error nsl_os_remove(nsl_Path path);
 
 NSL_API bool nsl_os_older_than(nsl_Path p1, nsl_Path p2);
 
+typedef struct {
+    bool overwrite; // replace existing files instead of returning 'NSL_ERROR_ALREADY_EXISTS'
+} nsl_OsCopyConfig;
+
+// Copies the content and the permissions. The data is copied inside the kernel where possible:
+// reflinks on copy on write file systems, then 'copy_file_range' and 'sendfile'.
+#define nsl_os_copy_file(src, dst, ...)                                                            \
+    nsl_os_copy_file_conf(src, dst, (nsl_OsCopyConfig){ __VA_ARGS__ })
+NSL_API nsl_Error nsl_os_copy_file_conf(nsl_Path src, nsl_Path dst, nsl_OsCopyConfig config);
+
+// Copies the directory tree with 'nsl_os_copy_file'. Existing directories are reused.
+#define nsl_os_copy_dir(src, dst, ...)                                                             \
+    nsl_os_copy_dir_conf(src, dst, (nsl_OsCopyConfig){ __VA_ARGS__ })
+NSL_API nsl_Error nsl_os_copy_dir_conf(nsl_Path src, nsl_Path dst, nsl_OsCopyConfig config);
+
 
 typedef struct {
     u64 hash;
@@ -366,6 +667,83 @@ NSL_API void nsl_map_difference(const nsl_Map *map, const nsl_Map *other, nsl_Ma
 NSL_API void nsl_map_union(const nsl_Map *map, const nsl_Map *other, nsl_Map *out);
 
 
+typedef struct {
+    nsl_Arena *arena;
+    usize len; // words in use, bits past 'len * 64' are zero
+    usize cap;
+    u64 *words;
+} nsl_BitSet;
+
+NSL_API void nsl_bitset_free(nsl_BitSet *set);
+NSL_API void nsl_bitset_clear_all(nsl_BitSet *set);
+NSL_API void nsl_bitset_reserve(nsl_BitSet *set, usize bits);
+
+NSL_API void nsl_bitset_set(nsl_BitSet *set, usize idx);
+NSL_API void nsl_bitset_clear(nsl_BitSet *set, usize idx);
+NSL_API bool nsl_bitset_test(const nsl_BitSet *set, usize idx);
+
+NSL_API usize nsl_bitset_count(const nsl_BitSet *set);
+// Number of set bits before 'idx'.
+NSL_API usize nsl_bitset_rank(const nsl_BitSet *set, usize idx);
+// Index of the 'n'-th set bit, counting from 0. Returns false if there are not enough bits set.
+NSL_API bool nsl_bitset_select(const nsl_BitSet *set, usize n, usize *out);
+// Advances 'idx' to the next set bit at or after 'idx'.
+// for (usize i = 0; nsl_bitset_next(&set, &i); i++) { ... }
+NSL_API bool nsl_bitset_next(const nsl_BitSet *set, usize *idx);
+
+NSL_API bool nsl_bitset_eq(const nsl_BitSet *set, const nsl_BitSet *other);
+
+// 'out' can be the same as 'set' or 'other'.
+NSL_API void nsl_bitset_intersection(const nsl_BitSet *set, const nsl_BitSet *other, nsl_BitSet *out);
+NSL_API void nsl_bitset_difference(const nsl_BitSet *set, const nsl_BitSet *other, nsl_BitSet *out);
+NSL_API void nsl_bitset_union(const nsl_BitSet *set, const nsl_BitSet *other, nsl_BitSet *out);
+NSL_API void nsl_bitset_symmetric_difference(const nsl_BitSet *set, const nsl_BitSet *other, nsl_BitSet *out);
+
+
+// Set of u32 values, split by the upper 16 bits into containers that are either a sorted u16
+// array (up to 4096 values), a 65536 bit bitmap or a list of runs (see 'nsl_roaring_optimize').
+typedef enum {
+    NSL_ROARING_ARRAY,
+    NSL_ROARING_BITMAP,
+    NSL_ROARING_RUN,
+} nsl_RoaringKind;
+
+typedef struct {
+    u16 key;
+    u16 kind;
+    u32 len; // values for arrays and bitmaps, runs for run containers
+    u32 cap; // 0 if 'data' points into the bytes passed to 'nsl_roaring_from_bytes'
+    void *data;
+} nsl_RoaringContainer;
+
+typedef nsl_List(nsl_RoaringContainer) nsl_Roaring;
+
+NSL_API void nsl_roaring_free(nsl_Roaring *r);
+NSL_API void nsl_roaring_clear(nsl_Roaring *r);
+
+NSL_API bool nsl_roaring_add(nsl_Roaring *r, u32 value);
+NSL_API bool nsl_roaring_remove(nsl_Roaring *r, u32 value);
+NSL_API bool nsl_roaring_has(const nsl_Roaring *r, u32 value);
+
+NSL_API u64 nsl_roaring_count(const nsl_Roaring *r);
+// Advances 'value' to the next value in the set at or after 'value'.
+// for (u64 v = 0; nsl_roaring_next(&r, &v); v++) { ... }
+NSL_API bool nsl_roaring_next(const nsl_Roaring *r, u64 *value);
+
+// Converts containers to runs where that is smaller.
+NSL_API void nsl_roaring_optimize(nsl_Roaring *r);
+
+// 'out' is cleared first and can not be one of the inputs.
+NSL_API void nsl_roaring_intersection(const nsl_Roaring *r, const nsl_Roaring *other, nsl_Roaring *out);
+NSL_API void nsl_roaring_union(const nsl_Roaring *r, const nsl_Roaring *other, nsl_Roaring *out);
+
+// Little endian with every container aligned to 8 bytes. 'nsl_roaring_from_bytes' references
+// the containers directly if possible, so 'bytes' (e.g. a mapped file) has to outlive 'out'.
+// Containers are copied when they are modified.
+NSL_API nsl_Bytes nsl_roaring_serialize(const nsl_Roaring *r, nsl_ByteBuffer *bb);
+NSL_API nsl_Error nsl_roaring_from_bytes(nsl_Bytes bytes, nsl_Roaring *out);
+
+
 NSL_API nsl_Bytes nsl_bytes_from_parts(usize size, const void *data);
 
 NSL_API nsl_Bytes nsl_bytes_copy(nsl_Bytes bytes, nsl_Arena *arena);
@@ -374,28 +752,151 @@ NSL_API nsl_Bytes nsl_bytes_slice(nsl_Bytes bytes, usize idx1, size_t idx2);
 NSL_API nsl_Bytes nsl_bytes_take(nsl_Bytes *bytes, usize count);
 
 NSL_API bool nsl_bytes_eq(nsl_Bytes b1, nsl_Bytes b2);
+
+// Word-at-a-time hash with 4 independent lanes for inputs of 32 bytes or more.
+// 'nsl_bytes_hash' and 'nsl_str_hash' return the same value for the same bytes.
 NSL_API u64 nsl_bytes_hash(nsl_Bytes bytes);
+NSL_API u64 nsl_bytes_hash_seed(nsl_Bytes bytes, u64 seed);
+
+// Streaming variant of 'nsl_bytes_hash_seed'. Is valid when zero initialized.
+// Produces the same hash as hashing all the bytes at once.
+typedef struct {
+    u64 seed;
+    u64 len;
+    u64 acc[4];
+    usize buffered;
+    u8 buffer[32];
+} nsl_Hasher;
+
+NSL_API void nsl_hasher_update(nsl_Hasher *hasher, nsl_Bytes bytes);
+NSL_API u64 nsl_hasher_finish(const nsl_Hasher *hasher);
+
+// CRC-32C (Castagnoli), uses the SSE4.2 'crc32' instruction if available.
+// Streaming works like 'nsl_Hasher', a zero initialized 'nsl_Crc32c' is empty.
+typedef struct {
+    u32 crc;
+} nsl_Crc32c;
+
+NSL_API u32 nsl_bytes_crc32c(nsl_Bytes bytes);
+NSL_API void nsl_crc32c_update(nsl_Crc32c *crc, nsl_Bytes bytes);
+NSL_API u32 nsl_crc32c_finish(const nsl_Crc32c *crc);
+
+// XXH64, compatible with the reference implementation.
+typedef struct {
+    u64 seed;
+    u64 len;
+    u64 acc[4];
+    usize buffered;
+    u8 buffer[32];
+} nsl_Xxh64;
+
+NSL_API u64 nsl_bytes_xxh64(nsl_Bytes bytes, u64 seed);
+NSL_API void nsl_xxh64_update(nsl_Xxh64 *hasher, nsl_Bytes bytes);
+NSL_API u64 nsl_xxh64_finish(const nsl_Xxh64 *hasher);
 
 NSL_API nsl_Str nsl_bytes_to_hex(nsl_Bytes bytes, nsl_Arena *arena);
 NSL_API nsl_Bytes nsl_bytes_from_hex(nsl_Str s, nsl_Arena *arena);
 
+// Appends two lowercase hex chars per byte to 'sb'.
+NSL_API nsl_Str nsl_bytes_to_hex_sb(nsl_Bytes bytes, nsl_StrBuffer *sb);
+// Accepts an optional "0x" prefix and an odd number of digits. Returns 'NSL_ERROR_PARSE' on
+// a non hex digit, in which case nothing is appended to 'bb'.
+NSL_API nsl_Error nsl_bytes_from_hex_bb(nsl_Str s, nsl_ByteBuffer *bb);
 
-NSL_API NSL_CONST_FN bool nsl_char_is_alnum(char c);
-NSL_API NSL_CONST_FN bool nsl_char_is_alpha(char c);
-NSL_API NSL_CONST_FN bool nsl_char_is_lower(char c);
-NSL_API NSL_CONST_FN bool nsl_char_is_upper(char c);
-NSL_API NSL_CONST_FN bool nsl_char_is_space(char c);
-NSL_API NSL_CONST_FN bool nsl_char_is_cntrl(char c);
-NSL_API NSL_CONST_FN bool nsl_char_is_print(char c);
-NSL_API NSL_CONST_FN bool nsl_char_is_graph(char c);
-NSL_API NSL_CONST_FN bool nsl_char_is_blank(char c);
-NSL_API NSL_CONST_FN bool nsl_char_is_punct(char c);
-NSL_API NSL_CONST_FN bool nsl_char_is_digit(char c);
-NSL_API NSL_CONST_FN bool nsl_char_is_xdigit(char c);
-NSL_API NSL_CONST_FN bool nsl_char_is_path_delimiter(char c);
-
-NSL_API NSL_CONST_FN char nsl_char_to_lower(char c);
-NSL_API NSL_CONST_FN char nsl_char_to_upper(char c);
+typedef enum {
+    NSL_BASE64_STD, // RFC 4648 '+' and '/', padded with '='
+    NSL_BASE64_URL, // RFC 4648 '-' and '_', without padding
+} nsl_Base64;
+
+// Decoding is strict: padding is required for 'NSL_BASE64_STD' and optional for
+// 'NSL_BASE64_URL'. Chars outside of the alphabet, whitespace and non zero trailing bits are
+// rejected with 'NSL_ERROR_PARSE'.
+NSL_API nsl_Str nsl_bytes_to_base64(nsl_Bytes bytes, nsl_Base64 alphabet, nsl_Arena *arena);
+NSL_API nsl_Str nsl_bytes_to_base64_sb(nsl_Bytes bytes, nsl_Base64 alphabet, nsl_StrBuffer *sb);
+NSL_API nsl_Error nsl_bytes_from_base64(nsl_Str s, nsl_Base64 alphabet, nsl_Arena *arena, nsl_Bytes *out);
+NSL_API nsl_Error nsl_bytes_from_base64_bb(nsl_Str s, nsl_Base64 alphabet, nsl_ByteBuffer *bb);
+
+// RFC 4648 base32 with uppercase letters and '=' padding. Decoding has the same strictness as
+// 'NSL_BASE64_STD'.
+NSL_API nsl_Str nsl_bytes_to_base32(nsl_Bytes bytes, nsl_Arena *arena);
+NSL_API nsl_Str nsl_bytes_to_base32_sb(nsl_Bytes bytes, nsl_StrBuffer *sb);
+NSL_API nsl_Error nsl_bytes_from_base32(nsl_Str s, nsl_Arena *arena, nsl_Bytes *out);
+NSL_API nsl_Error nsl_bytes_from_base32_bb(nsl_Str s, nsl_ByteBuffer *bb);
+
+
+// ASCII only and independent of the current locale. Bytes >= 0x80 belong to no class.
+typedef enum {
+    NSL_CHAR_CNTRL  = 1 << 0,
+    NSL_CHAR_SPACE  = 1 << 1,
+    NSL_CHAR_BLANK  = 1 << 2,
+    NSL_CHAR_PUNCT  = 1 << 3,
+    NSL_CHAR_DIGIT  = 1 << 4,
+    NSL_CHAR_XDIGIT = 1 << 5,
+    NSL_CHAR_UPPER  = 1 << 6,
+    NSL_CHAR_LOWER  = 1 << 7,
+    NSL_CHAR_PRINT  = 1 << 8,
+
+    NSL_CHAR_ALPHA  = NSL_CHAR_UPPER | NSL_CHAR_LOWER,
+    NSL_CHAR_ALNUM  = NSL_CHAR_ALPHA | NSL_CHAR_DIGIT,
+    NSL_CHAR_GRAPH  = NSL_CHAR_ALNUM | NSL_CHAR_PUNCT,
+} nsl_CharClass;
+
+// Classifies the first 32 chars at once. Bit 'i' is set if 'chars[i]' is in one of the 'classes'.
+// Bits at or past 'len' are always 0.
+NSL_API u32 nsl_char_classify(usize len, const char *chars, u32 classes);
+
+#define C_  NSL_CHAR_CNTRL
+#define S_  (NSL_CHAR_CNTRL | NSL_CHAR_SPACE)
+#define B_  (NSL_CHAR_CNTRL | NSL_CHAR_SPACE | NSL_CHAR_BLANK)
+#define SP_ (NSL_CHAR_SPACE | NSL_CHAR_BLANK | NSL_CHAR_PRINT)
+#define P_  (NSL_CHAR_PUNCT | NSL_CHAR_PRINT)
+#define D_  (NSL_CHAR_DIGIT | NSL_CHAR_XDIGIT | NSL_CHAR_PRINT)
+#define UX_ (NSL_CHAR_UPPER | NSL_CHAR_XDIGIT | NSL_CHAR_PRINT)
+#define U_  (NSL_CHAR_UPPER | NSL_CHAR_PRINT)
+#define LX_ (NSL_CHAR_LOWER | NSL_CHAR_XDIGIT | NSL_CHAR_PRINT)
+#define L_  (NSL_CHAR_LOWER | NSL_CHAR_PRINT)
+
+static const u16 _nsl_char_class[256] = {
+    C_,  C_,  C_,  C_,  C_,  C_,  C_,  C_,  C_,  B_,  S_,  S_,  S_,  S_,  C_,  C_,
+    C_,  C_,  C_,  C_,  C_,  C_,  C_,  C_,  C_,  C_,  C_,  C_,  C_,  C_,  C_,  C_,
+    SP_, P_,  P_,  P_,  P_,  P_,  P_,  P_,  P_,  P_,  P_,  P_,  P_,  P_,  P_,  P_,
+    D_,  D_,  D_,  D_,  D_,  D_,  D_,  D_,  D_,  D_,  P_,  P_,  P_,  P_,  P_,  P_,
+    P_,  UX_, UX_, UX_, UX_, UX_, UX_, U_,  U_,  U_,  U_,  U_,  U_,  U_,  U_,  U_,
+    U_,  U_,  U_,  U_,  U_,  U_,  U_,  U_,  U_,  U_,  U_,  P_,  P_,  P_,  P_,  P_,
+    P_,  LX_, LX_, LX_, LX_, LX_, LX_, L_,  L_,  L_,  L_,  L_,  L_,  L_,  L_,  L_,
+    L_,  L_,  L_,  L_,  L_,  L_,  L_,  L_,  L_,  L_,  L_,  P_,  P_,  P_,  P_,  C_,
+};
+
+#undef C_
+#undef S_
+#undef B_
+#undef SP_
+#undef P_
+#undef D_
+#undef UX_
+#undef U_
+#undef LX_
+#undef L_
+
+// Inline, so loops over bytes compile to table lookups and can be vectorized.
+static inline NSL_CONST_FN bool nsl_char_is(char c, u32 classes) { return (_nsl_char_class[(u8)c] & classes) != 0; }
+
+static inline NSL_CONST_FN bool nsl_char_is_alnum(char c) { return _nsl_char_class[(u8)c] & NSL_CHAR_ALNUM; }
+static inline NSL_CONST_FN bool nsl_char_is_alpha(char c) { return _nsl_char_class[(u8)c] & NSL_CHAR_ALPHA; }
+static inline NSL_CONST_FN bool nsl_char_is_lower(char c) { return _nsl_char_class[(u8)c] & NSL_CHAR_LOWER; }
+static inline NSL_CONST_FN bool nsl_char_is_upper(char c) { return _nsl_char_class[(u8)c] & NSL_CHAR_UPPER; }
+static inline NSL_CONST_FN bool nsl_char_is_space(char c) { return _nsl_char_class[(u8)c] & NSL_CHAR_SPACE; }
+static inline NSL_CONST_FN bool nsl_char_is_cntrl(char c) { return _nsl_char_class[(u8)c] & NSL_CHAR_CNTRL; }
+static inline NSL_CONST_FN bool nsl_char_is_print(char c) { return _nsl_char_class[(u8)c] & NSL_CHAR_PRINT; }
+static inline NSL_CONST_FN bool nsl_char_is_graph(char c) { return _nsl_char_class[(u8)c] & NSL_CHAR_GRAPH; }
+static inline NSL_CONST_FN bool nsl_char_is_blank(char c) { return _nsl_char_class[(u8)c] & NSL_CHAR_BLANK; }
+static inline NSL_CONST_FN bool nsl_char_is_punct(char c) { return _nsl_char_class[(u8)c] & NSL_CHAR_PUNCT; }
+static inline NSL_CONST_FN bool nsl_char_is_digit(char c) { return (u8)(c - '0') < 10; }
+static inline NSL_CONST_FN bool nsl_char_is_xdigit(char c) { return _nsl_char_class[(u8)c] & NSL_CHAR_XDIGIT; }
+static inline NSL_CONST_FN bool nsl_char_is_path_delimiter(char c) { return c == '/' || c == '\\'; }
+
+static inline NSL_CONST_FN char nsl_char_to_lower(char c) { return (char)(c + ((u8)(c - 'A') < 26) * ('a' - 'A')); }
+static inline NSL_CONST_FN char nsl_char_to_upper(char c) { return (char)(c - ((u8)(c - 'a') < 26) * ('a' - 'A')); }
 
 NSL_API NSL_CONST_FN u8 nsl_char_to_u8(char c);
 NSL_API NSL_CONST_FN u8 nsl_char_hex_to_u8(char c);
@@ -405,6 +906,21 @@ NSL_API NSL_CONST_FN char nsl_char_hex_from_u8(u8 d);
 NSL_API NSL_CONST_FN char nsl_char_HEX_from_u8(u8 d);
 
 
+// A set of up to 256 bytes. Is valid when zero initialized (empty set).
+// The nibble tables are used to test 16/32 bytes at once with a byte shuffle.
+typedef struct {
+    u64 bits[4];
+    u8 lo[2][16];
+    u8 hi[2][16];
+} nsl_ByteSet;
+
+NSL_API nsl_ByteSet nsl_byteset_from_str(nsl_Str bytes);
+NSL_API nsl_ByteSet nsl_byteset_from_predicate(bool (*predicate)(char));
+
+NSL_API void nsl_byteset_add(nsl_ByteSet *set, u8 byte);
+NSL_API bool nsl_byteset_has(const nsl_ByteSet *set, u8 byte);
+
+
 #define INTEGER_DECL(T)                                                                            \
     NSL_API NSL_CONST_FN T nsl_##T##_reverse_bits(T value);                                        \
     NSL_API NSL_CONST_FN usize nsl_##T##_leading_ones(T value);                                    \
@@ -450,6 +966,38 @@ INTEGER_DECL(usize)
 
 #undef INTEGER_DECL
 
+NSL_API NSL_PURE_FN usize nsl_u64_count_ones_array(usize count, const u64 *values);
+
+// Bulk variants of 'nsl_T_to_be_bytes' and friends. The 'read' functions convert
+// 'min(count, bytes.size / sizeof(T))' values and return how many were converted.
+#define ENDIAN_ARRAY_DECL(T)                                                                       \
+    NSL_API nsl_Bytes nsl_bb_push_##T##_be_array(nsl_ByteBuffer *bb, usize count, const T *v);     \
+    NSL_API nsl_Bytes nsl_bb_push_##T##_le_array(nsl_ByteBuffer *bb, usize count, const T *v);     \
+    NSL_API usize nsl_bytes_read_##T##_be_array(nsl_Bytes bytes, usize count, T *out);             \
+    NSL_API usize nsl_bytes_read_##T##_le_array(nsl_Bytes bytes, usize count, T *out);
+
+ENDIAN_ARRAY_DECL(u16)
+ENDIAN_ARRAY_DECL(i16)
+ENDIAN_ARRAY_DECL(u32)
+ENDIAN_ARRAY_DECL(i32)
+ENDIAN_ARRAY_DECL(u64)
+ENDIAN_ARRAY_DECL(i64)
+
+#undef ENDIAN_ARRAY_DECL
+
+// Unsigned LEB128. Signed values are zigzag encoded first, so small negative numbers stay short.
+NSL_API NSL_CONST_FN u64 nsl_zigzag_encode(i64 value);
+NSL_API NSL_CONST_FN i64 nsl_zigzag_decode(u64 value);
+
+NSL_API nsl_Bytes nsl_bb_push_varint(nsl_ByteBuffer *bb, u64 value);
+NSL_API nsl_Bytes nsl_bb_push_varint_signed(nsl_ByteBuffer *bb, i64 value);
+NSL_API nsl_Bytes nsl_bb_push_varint_array(nsl_ByteBuffer *bb, usize count, const u64 *values);
+
+// Returns 'NSL_ERROR_PARSE' on truncated input or values that do not fit into 64 bits.
+// 'bytes' is only advanced on success.
+NSL_API nsl_Error nsl_bytes_chop_varint(nsl_Bytes *bytes, u64 *out);
+NSL_API nsl_Error nsl_bytes_chop_varint_signed(nsl_Bytes *bytes, i64 *out);
+
 
 NSL_API nsl_Path nsl_path_join(usize len, const nsl_Path* parts, nsl_Arena* arena);
 NSL_API nsl_Path nsl_path_normalize(nsl_Path path, nsl_Arena* arena);
@@ -478,6 +1026,11 @@ NSL_API nsl_Str nsl_str_append(nsl_Str s1, nsl_Str suffix, nsl_Arena *arena);
 NSL_API nsl_Str nsl_str_prepend(nsl_Str s1, nsl_Str prefix, nsl_Arena *arena);
 NSL_API nsl_Str nsl_str_wrap(nsl_Str s, nsl_Str wrap, nsl_Arena *arena);
 
+// Appends the converted string to 'sb'. Only ASCII letters are converted. The result points into
+// 'sb' and is valid until the next push that grows it.
+NSL_API nsl_Str nsl_str_to_lower(nsl_Str s, nsl_StrBuffer *sb);
+NSL_API nsl_Str nsl_str_to_upper(nsl_Str s, nsl_StrBuffer *sb);
+
 // Inserts sep in between elements
 NSL_API nsl_Str nsl_str_join(nsl_Str sep, usize count, nsl_Str *s, nsl_Arena *arena);
 // Appends suffix to every element, even the last one
@@ -490,6 +1043,7 @@ NSL_API nsl_Str nsl_str_join_wrap(nsl_Str sep, nsl_Str wrap, usize count, nsl_St
 NSL_API bool nsl_str_eq(nsl_Str s1, nsl_Str s2);
 NSL_API bool nsl_str_eq_ignorecase(nsl_Str s1, nsl_Str s2);
 NSL_API bool nsl_str_startswith(nsl_Str s1, nsl_Str prefix);
+NSL_API bool nsl_str_startswith_ignorecase(nsl_Str s1, nsl_Str prefix);
 NSL_API bool nsl_str_endswith(nsl_Str s1, nsl_Str suffix);
 NSL_API bool nsl_str_endswith_predicate(nsl_Str s1, bool (*predicate)(char));
 
@@ -513,6 +1067,8 @@ NSL_API bool nsl_str_try_chop_by_delim(nsl_Str *s, char delim, nsl_Str *chunk);
 NSL_API nsl_Str nsl_str_chop_by_delim(nsl_Str *s, char delim);
 NSL_API bool nsl_str_try_chop_by_predicate(nsl_Str *s, bool (*predicate)(char), nsl_Str *chunk);
 NSL_API nsl_Str nsl_str_chop_by_predicate(nsl_Str *s, bool (*predicate)(char));
+NSL_API bool nsl_str_try_chop_by_set(nsl_Str *s, const nsl_ByteSet *set, nsl_Str *chunk);
+NSL_API nsl_Str nsl_str_chop_by_set(nsl_Str *s, const nsl_ByteSet *set);
 NSL_API nsl_Str nsl_str_chop_right_by_delim(nsl_Str *s, char delim);
 NSL_API nsl_Str nsl_str_chop_right_by_predicate(nsl_Str *s, bool (*predicate)(char));
 NSL_API nsl_Str nsl_str_take(nsl_Str *s, usize count);
@@ -533,22 +1089,48 @@ NSL_API nsl_Error nsl_str_chop_f64(nsl_Str *s, f64 *out);
 
 // Returns 'STR_NOT_FOUND' if 'needle' was not found.
 NSL_API usize nsl_str_find(nsl_Str haystack, nsl_Str needle);
+// Returns 'STR_NOT_FOUND' if 'needle' was not found. Only ASCII letters are folded.
+NSL_API usize nsl_str_find_ignorecase(nsl_Str haystack, nsl_Str needle);
 // Returns 'STR_NOT_FOUND' if 'predicate' was not found.
 NSL_API usize nsl_str_find_by_predicate(nsl_Str haystack, bool (*predicate)(char));
+// Returns 'STR_NOT_FOUND' if no byte of 'set' was found.
+NSL_API usize nsl_str_find_by_set(nsl_Str haystack, const nsl_ByteSet *set);
 // Returns 'STR_NOT_FOUND' if 'needle' was not found.
 NSL_API usize nsl_str_find_last(nsl_Str haystack, nsl_Str needle);
 // Returns 'STR_NOT_FOUND' if 'predicate' was not found.
 NSL_API usize nsl_str_find_last_by_predicate(nsl_Str haystack, bool (*predicate)(char));
 
 NSL_API usize nsl_str_count(nsl_Str haystack, nsl_Str needle);
+
+// Pushes every chunk 'nsl_str_try_chop_by_set' would return into 'out'. Returns the number of chunks.
+NSL_API usize nsl_str_split_all(nsl_Str s, const nsl_ByteSet *set, nsl_StrList *out);
 // Returns '\0' if the index is out of bounds.
 NSL_API char nsl_str_getc(nsl_Str s, usize idx);
 
-// Basic FNV hash.
+NSL_API bool nsl_str_utf8_validate(nsl_Str s);
+// Decodes the first code point. Invalid sequences decode as U+FFFD and consume one byte.
+NSL_API bool nsl_str_utf8_try_chop(nsl_Str *s, u32 *codepoint);
+// Counts the code points. Expects valid utf-8.
+NSL_API usize nsl_str_utf8_count(nsl_Str s);
+// Code point index of the byte 'offset'.
+NSL_API usize nsl_str_utf8_index(nsl_Str s, usize offset);
+// Byte offset of the code point 'index'. Returns 's.len' if 'index' is out of bounds.
+NSL_API usize nsl_str_utf8_offset(nsl_Str s, usize index);
+
+// Same as 'nsl_bytes_hash'.
 NSL_API u64 nsl_str_hash(nsl_Str s);
+NSL_API u64 nsl_str_hash_seed(nsl_Str s, u64 seed);
 
 #define NSL_LIST_INITIAL_CAPACITY 8
 
+// Reverses the order of 'count' elements of 'size' bytes. Elements of 1, 2, 4 and 8 bytes are
+// reversed a vector at a time.
+NSL_API void nsl_array_reverse(usize count, usize size, void *items);
+
+// The bulk operations copy bytes, so the source has to have the same element size as the list.
+#define NSL_LIST_SAME_ITEM_SIZE(list, src)                                                         \
+    (void)sizeof(char[sizeof(*(list)->items) == sizeof(*(src)) ? 1 : -1])
+
 // https://github.com/tsoding/nob.h/blob/3f835d7bf0e5321fbcf8fbded06fa4ad30d282f3/nob.h#L386
 #define nsl_list_first(list) (list)->items[(NSL_ASSERT((list)->len > 0), 0)]
 #define nsl_list_last(list)  (list)->items[(NSL_ASSERT((list)->len > 0), (list)->len - 1)]
@@ -567,9 +1149,10 @@ NSL_API u64 nsl_str_hash(nsl_Str s);
 
 #define nsl_list_copy(src, dest)                                                                   \
     do {                                                                                           \
+        NSL_LIST_SAME_ITEM_SIZE((dest), (src)->items);                                             \
         nsl_list_resize((dest), (src)->len);                                                       \
-        for (usize __c_i = 0; __c_i < (src)->len; __c_i++) {                                       \
-            (dest)->items[__c_i] = (src)->items[__c_i];                                            \
+        if ((src)->len) {                                                                          \
+            memcpy((dest)->items, (src)->items, (src)->len * sizeof(*(src)->items));               \
         }                                                                                          \
         (dest)->len = (src)->len;                                                                  \
     } while (0)
@@ -601,11 +1184,13 @@ NSL_API u64 nsl_str_hash(nsl_Str s);
 
 #define nsl_list_extend(list, count, ...)                                                          \
     do {                                                                                           \
-        nsl_list_reserve((list), (count));                                                         \
-        for (usize __e_i = 0; __e_i < (count); __e_i++) {                                          \
-            (list)->items[(list)->len + __e_i] = (__VA_ARGS__)[__e_i];                             \
+        NSL_LIST_SAME_ITEM_SIZE((list), (__VA_ARGS__));                                            \
+        const usize __e_n = (count);                                                               \
+        nsl_list_reserve((list), __e_n);                                                           \
+        if (__e_n) {                                                                               \
+            memcpy(&(list)->items[(list)->len], (__VA_ARGS__), __e_n * sizeof(*(list)->items));    \
         }                                                                                          \
-        (list)->len += count;                                                                      \
+        (list)->len += __e_n;                                                                      \
     } while (0)
 
 #define nsl_list_extend_static(list, ...)                                                          \
@@ -615,31 +1200,64 @@ NSL_API u64 nsl_str_hash(nsl_Str s);
 
 #define nsl_list_extend_list(list, other)                                                          \
     do {                                                                                           \
+        NSL_LIST_SAME_ITEM_SIZE((list), (other)->items);                                           \
         nsl_list_reserve((list), (other)->len);                                                    \
-        for (usize __e_i = 0; __e_i < (other)->len; __e_i++) {                                     \
-            (list)->items[(list)->len + __e_i] = (other)->items[__e_i];                            \
+        if ((other)->len) {                                                                        \
+            memcpy(&(list)->items[(list)->len], (other)->items,                                    \
+                   (other)->len * sizeof(*(list)->items));                                         \
         }                                                                                          \
         (list)->len += (other)->len;                                                               \
     } while (0)
 
 #define nsl_list_insert(list, value, idx)                                                          \
     do {                                                                                           \
-        nsl_list_reserve(list, 1);                                                                 \
-        for (usize __r_i = idx + 1; __r_i < (list)->len + 1; __r_i++) {                            \
-            (list)->items[__r_i] = (list)->items[__r_i - 1];                                       \
-        }                                                                                          \
-        (list)->items[idx] = value;                                                                \
+        const usize __i_idx = (idx);                                                               \
+        NSL_ASSERT(__i_idx <= (list)->len);                                                        \
+        nsl_list_reserve((list), 1);                                                               \
+        memmove(&(list)->items[__i_idx + 1], &(list)->items[__i_idx],                              \
+                ((list)->len - __i_idx) * sizeof(*(list)->items));                                 \
+        (list)->items[__i_idx] = (value);                                                          \
         (list)->len++;                                                                             \
     } while (0)
 
-#define nsl_list_remove(list, idx)                                                                 \
+// Inserts 'count' items at 'idx'. 'items' must not point into the list.
+#define nsl_list_insert_n(list, idx, count, ...)                                                   \
     do {                                                                                           \
-        for (usize __r_i = idx + 1; __r_i < (list)->len; __r_i++) {                                \
-            (list)->items[__r_i - 1] = (list)->items[__r_i];                                       \
+        NSL_LIST_SAME_ITEM_SIZE((list), (__VA_ARGS__));                                            \
+        const usize __i_idx = (idx);                                                               \
+        const usize __i_n = (count);                                                               \
+        NSL_ASSERT(__i_idx <= (list)->len);                                                        \
+        nsl_list_reserve((list), __i_n);                                                           \
+        if (__i_n) {                                                                               \
+            memmove(&(list)->items[__i_idx + __i_n], &(list)->items[__i_idx],                      \
+                    ((list)->len - __i_idx) * sizeof(*(list)->items));                             \
+            memcpy(&(list)->items[__i_idx], (__VA_ARGS__), __i_n * sizeof(*(list)->items));        \
         }                                                                                          \
+        (list)->len += __i_n;                                                                      \
+    } while (0)
+
+#define nsl_list_remove(list, idx)                                                                 \
+    do {                                                                                           \
+        const usize __r_idx = (idx);                                                               \
+        NSL_ASSERT(__r_idx < (list)->len);                                                         \
+        memmove(&(list)->items[__r_idx], &(list)->items[__r_idx + 1],                              \
+                ((list)->len - __r_idx - 1) * sizeof(*(list)->items));                             \
         (list)->len--;                                                                             \
     } while (0)
 
+// Removes the items in the range ['idx', 'idx' + 'count').
+#define nsl_list_remove_range(list, idx, count)                                                    \
+    do {                                                                                           \
+        const usize __r_idx = (idx);                                                               \
+        const usize __r_n = (count);                                                               \
+        NSL_ASSERT(__r_idx + __r_n <= (list)->len);                                                \
+        if (__r_n) {                                                                               \
+            memmove(&(list)->items[__r_idx], &(list)->items[__r_idx + __r_n],                      \
+                    ((list)->len - __r_idx - __r_n) * sizeof(*(list)->items));                     \
+        }                                                                                          \
+        (list)->len -= __r_n;                                                                      \
+    } while (0)
+
 #define nsl_list_remove_unordered(list, idx)                                                       \
     (list)->items[idx] = (list)->items[--(list)->len]
 
@@ -687,17 +1305,307 @@ NSL_API u64 nsl_str_hash(nsl_Str s);
 
 #define nsl_list_sort(src, sort) qsort((src)->items, (src)->len, sizeof((src)->items[0]), sort)
 
-#define nsl_list_reverse(list)                                                                     \
-    if ((list)->len) do {                                                                          \
-        nsl_list_reserve((list), 1);                                                               \
-        for (usize __r_i = 0; __r_i < (list)->len - __r_i - 1; __r_i++) {                          \
-            usize __last_idx = (list)->len - __r_i - 1;                                            \
-            (list)->items[(list)->len] = (list)->items[__r_i];                                     \
-            (list)->items[__r_i] = (list)->items[__last_idx];                                      \
-            (list)->items[__last_idx] = (list)->items[(list)->len];                                \
+// Generates 'void name(usize count, T *items)', a pattern-defeating quicksort with 'less(a, b)'
+// inlined. 'less' can be a macro or a function and gets two values of type 'T'. Not stable.
+// Also generates 'name##_select_nth', 'name##_partial_sort' and a bounded heap for streaming
+// top-k selection, 'name##_top_k_push' and 'name##_top_k_finish'.
+#define NSL_SORT_DEFINE(name, T, less)                                                             \
+    static inline void name##_swap(T *a, T *b) {                                                   \
+        T tmp = *a;                                                                                \
+        *a = *b;                                                                                   \
+        *b = tmp;                                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    static inline void name##_sort3(T *a, T *b, T *c) {                                            \
+        if (less(*b, *a)) name##_swap(a, b);                                                       \
+        if (less(*c, *b)) name##_swap(b, c);                                                       \
+        if (less(*b, *a)) name##_swap(a, b);                                                       \
+    }                                                                                              \
+                                                                                                   \
+    static inline void name##_insertion(T *begin, T *end) {                                        \
+        if (begin == end) return;                                                                  \
+        for (T *cur = begin + 1; cur != end; cur++) {                                              \
+            if (!less(*cur, cur[-1])) continue;                                                    \
+            T tmp = *cur;                                                                          \
+            T *sift = cur;                                                                         \
+            do {                                                                                   \
+                *sift = sift[-1];                                                                  \
+                sift--;                                                                            \
+            } while (sift != begin && less(tmp, sift[-1]));                                        \
+            *sift = tmp;                                                                           \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* gives up after moving more than 8 elements */                                               \
+    static inline bool name##_partial_insertion(T *begin, T *end) {                                \
+        if (begin == end) return true;                                                             \
+        usize moved = 0;                                                                           \
+        for (T *cur = begin + 1; cur != end; cur++) {                                              \
+            if (!less(*cur, cur[-1])) continue;                                                    \
+            T tmp = *cur;                                                                          \
+            T *sift = cur;                                                                         \
+            do {                                                                                   \
+                *sift = sift[-1];                                                                  \
+                sift--;                                                                            \
+            } while (sift != begin && less(tmp, sift[-1]));                                        \
+            *sift = tmp;                                                                           \
+            moved += (usize)(cur - sift);                                                          \
+            if (8 < moved) return false;                                                           \
+        }                                                                                          \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    static inline void name##_sift_down(T *items, usize root, usize len) {                         \
+        T value = items[root];                                                                     \
+        for (usize child; (child = 2 * root + 1) < len; root = child) {                            \
+            if (child + 1 < len && less(items[child], items[child + 1])) child++;                  \
+            if (!less(value, items[child])) break;                                                 \
+            items[root] = items[child];                                                            \
+        }                                                                                          \
+        items[root] = value;                                                                       \
+    }                                                                                              \
+                                                                                                   \
+    static inline void name##_heapsort(T *begin, T *end) {                                         \
+        const usize len = (usize)(end - begin);                                                    \
+        for (usize i = len / 2; 0 < i--;) name##_sift_down(begin, i, len);                         \
+        for (usize i = len; 1 < i--;) {                                                            \
+            name##_swap(&begin[0], &begin[i]);                                                     \
+            name##_sift_down(begin, 0, i);                                                         \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* elements equal to the pivot go to the right */                                              \
+    static inline T *name##_partition_right(T *begin, T *end, bool *already_partitioned) {         \
+        T pivot = *begin;                                                                          \
+        T *first = begin;                                                                          \
+        T *last = end;                                                                             \
+        do first++; while (less(*first, pivot));                                                   \
+        if (first - 1 == begin) {                                                                  \
+            do last--; while (first < last && !less(*last, pivot));                                \
+        } else {                                                                                   \
+            do last--; while (!less(*last, pivot));                                                \
+        }                                                                                          \
+        *already_partitioned = last <= first;                                                      \
+        while (first < last) {                                                                     \
+            name##_swap(first, last);                                                              \
+            do first++; while (less(*first, pivot));                                               \
+            do last--; while (!less(*last, pivot));                                                \
+        }                                                                                          \
+        T *pivot_pos = first - 1;                                                                  \
+        *begin = *pivot_pos;                                                                       \
+        *pivot_pos = pivot;                                                                        \
+        return pivot_pos;                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* elements equal to the pivot go to the left */                                               \
+    static inline T *name##_partition_left(T *begin, T *end) {                                     \
+        T pivot = *begin;                                                                          \
+        T *first = begin;                                                                          \
+        T *last = end;                                                                             \
+        do last--; while (less(pivot, *last));                                                     \
+        if (last + 1 == end) {                                                                     \
+            do first++; while (first < last && !less(pivot, *first));                              \
+        } else {                                                                                   \
+            do first++; while (!less(pivot, *first));                                              \
+        }                                                                                          \
+        while (first < last) {                                                                     \
+            name##_swap(first, last);                                                              \
+            do last--; while (less(pivot, *last));                                                 \
+            do first++; while (!less(pivot, *first));                                              \
+        }                                                                                          \
+        *begin = *last;                                                                            \
+        *last = pivot;                                                                             \
+        return last;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* shuffles a few elements to break up patterns that lead to bad partitions */                 \
+    static inline void name##_break_patterns(T *begin, T *end) {                                   \
+        const usize len = (usize)(end - begin);                                                    \
+        if (len < 24) return;                                                                      \
+        name##_swap(&begin[0], &begin[len / 4]);                                                   \
+        name##_swap(&end[-1], &end[-(isize)(len / 4)]);                                            \
+        if (len <= 128) return;                                                                    \
+        name##_swap(&begin[1], &begin[len / 4 + 1]);                                               \
+        name##_swap(&begin[2], &begin[len / 4 + 2]);                                               \
+        name##_swap(&end[-2], &end[-(isize)(len / 4 + 1)]);                                        \
+        name##_swap(&end[-3], &end[-(isize)(len / 4 + 2)]);                                        \
+    }                                                                                              \
+                                                                                                   \
+    /* moves the median of 3, or the pseudo median of 9 for larger ranges, to the front */         \
+    static inline void name##_choose_pivot(T *begin, T *end) {                                     \
+        const usize len = (usize)(end - begin);                                                    \
+        const usize half = len / 2;                                                                \
+        if (128 < len) {                                                                           \
+            name##_sort3(&begin[0], &begin[half], &end[-1]);                                       \
+            name##_sort3(&begin[1], &begin[half - 1], &end[-2]);                                   \
+            name##_sort3(&begin[2], &begin[half + 1], &end[-3]);                                   \
+            name##_sort3(&begin[half - 1], &begin[half], &begin[half + 1]);                        \
+            name##_swap(&begin[0], &begin[half]);                                                  \
+        } else {                                                                                   \
+            name##_sort3(&begin[half], &begin[0], &end[-1]);                                       \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    static inline void name##_loop(T *begin, T *end, usize bad_allowed, bool leftmost) {           \
+        while (true) {                                                                             \
+            const usize len = (usize)(end - begin);                                                \
+            if (len < 24) {                                                                        \
+                name##_insertion(begin, end);                                                      \
+                return;                                                                            \
+            }                                                                                      \
+                                                                                                   \
+            name##_choose_pivot(begin, end);                                                       \
+                                                                                                   \
+            /* the pivot equals the one left of this partition, skip all equal elements */         \
+            if (!leftmost && !less(begin[-1], *begin)) {                                           \
+                begin = name##_partition_left(begin, end) + 1;                                     \
+                continue;                                                                          \
+            }                                                                                      \
+                                                                                                   \
+            bool already_partitioned = false;                                                      \
+            T *pivot_pos = name##_partition_right(begin, end, &already_partitioned);               \
+            const usize left = (usize)(pivot_pos - begin);                                         \
+            const usize right = (usize)(end - (pivot_pos + 1));                                    \
+                                                                                                   \
+            if (left < len / 8 || right < len / 8) {                                               \
+                if (--bad_allowed == 0) {                                                          \
+                    name##_heapsort(begin, end);                                                   \
+                    return;                                                                        \
+                }                                                                                  \
+                name##_break_patterns(begin, pivot_pos);                                           \
+                name##_break_patterns(pivot_pos + 1, end);                                         \
+            } else if (already_partitioned && name##_partial_insertion(begin, pivot_pos) &&        \
+                       name##_partial_insertion(pivot_pos + 1, end)) {                             \
+                return;                                                                            \
+            }                                                                                      \
+                                                                                                   \
+            name##_loop(begin, pivot_pos, bad_allowed, leftmost);                                  \
+            begin = pivot_pos + 1;                                                                 \
+            leftmost = false;                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    static inline void name(usize count, T *items) {                                               \
+        if (count < 2) return;                                                                     \
+        usize bad_allowed = 0;                                                                     \
+        for (usize n = count; n >>= 1;) bad_allowed++;                                             \
+        name##_loop(items, items + count, bad_allowed, true);                                      \
+    }                                                                                              \
+                                                                                                   \
+    /* introselect, afterwards no element before 'nth' is greater and none after it is less */     \
+    static inline void name##_select_nth(usize count, T *items, usize nth) {                       \
+        if (count <= nth) return;                                                                  \
+        T *begin = items;                                                                          \
+        T *end = items + count;                                                                    \
+        T *target = items + nth;                                                                   \
+        usize bad_allowed = 0;                                                                     \
+        for (usize n = count; n >>= 1;) bad_allowed++;                                             \
+                                                                                                   \
+        while (24 <= end - begin) {                                                                \
+            const usize len = (usize)(end - begin);                                                \
+            name##_choose_pivot(begin, end);                                                       \
+                                                                                                   \
+            if (begin != items && !less(begin[-1], *begin)) {                                      \
+                T *pivot_pos = name##_partition_left(begin, end);                                  \
+                if (target <= pivot_pos) return;                                                   \
+                begin = pivot_pos + 1;                                                             \
+                continue;                                                                          \
+            }                                                                                      \
+                                                                                                   \
+            bool already_partitioned = false;                                                      \
+            T *pivot_pos = name##_partition_right(begin, end, &already_partitioned);               \
+            if (pivot_pos == target) return;                                                       \
+                                                                                                   \
+            const usize left = (usize)(pivot_pos - begin);                                         \
+            const usize right = (usize)(end - (pivot_pos + 1));                                    \
+            if (left < len / 8 || right < len / 8) {                                               \
+                if (--bad_allowed == 0) {                                                          \
+                    name##_heapsort(begin, end);                                                   \
+                    return;                                                                        \
+                }                                                                                  \
+                name##_break_patterns(begin, pivot_pos);                                           \
+                name##_break_patterns(pivot_pos + 1, end);                                         \
+            }                                                                                      \
+                                                                                                   \
+            if (target < pivot_pos) {                                                              \
+                end = pivot_pos;                                                                   \
+            } else {                                                                               \
+                begin = pivot_pos + 1;                                                             \
+            }                                                                                      \
+        }                                                                                          \
+        name##_insertion(begin, end);                                                              \
+    }                                                                                              \
+                                                                                                   \
+    /* sorts only the first 'k' elements */                                                        \
+    static inline void name##_partial_sort(usize count, T *items, usize k) {                       \
+        if (k < count) {                                                                           \
+            name##_select_nth(count, items, k);                                                    \
+            count = k;                                                                             \
+        }                                                                                          \
+        name(count, items);                                                                        \
+    }                                                                                              \
+                                                                                                   \
+    /* keeps the 'k' least values pushed so far, 'heap[0]' is the greatest of them */              \
+    static inline void name##_top_k_push(usize k, usize *len, T *heap, T value) {                  \
+        if (*len < k) {                                                                            \
+            usize i = (*len)++;                                                                    \
+            for (; i && less(heap[(i - 1) / 2], value); i = (i - 1) / 2) {                         \
+                heap[i] = heap[(i - 1) / 2];                                                       \
+            }                                                                                      \
+            heap[i] = value;                                                                       \
+        } else if (k && less(value, heap[0])) {                                                    \
+            heap[0] = value;                                                                       \
+            name##_sift_down(heap, 0, k);                                                          \
         }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* sorts the heap in place */                                                                  \
+    static inline void name##_top_k_finish(usize len, T *heap) {                                   \
+        name##_heapsort(heap, heap + len);                                                         \
+    }
+
+#define nsl_list_select_nth(list, sort, nth) sort##_select_nth((list)->len, (list)->items, (nth))
+#define nsl_list_partial_sort(list, sort, k) sort##_partial_sort((list)->len, (list)->items, (k))
+
+// Keeps the 'k' least values pushed so far, 'nsl_list_top_k_finish' sorts them.
+#define nsl_list_top_k_push(list, sort, k, value)                                                  \
+    do {                                                                                           \
+        if ((list)->cap < (k)) nsl_list_resize((list), (k));                                       \
+        sort##_top_k_push((k), &(list)->len, (list)->items, (value));                              \
+    } while (0)
+#define nsl_list_top_k_finish(list, sort) sort##_top_k_finish((list)->len, (list)->items)
+
+// LSD radix sorts. Floats are ordered by their bits: -nan < -inf < -0.0 < 0.0 < inf < nan.
+#define SORT_DECL(T) NSL_API void nsl_##T##_sort(usize count, T *values);
+
+SORT_DECL(u8)
+SORT_DECL(i8)
+SORT_DECL(u16)
+SORT_DECL(i16)
+SORT_DECL(u32)
+SORT_DECL(i32)
+SORT_DECL(u64)
+SORT_DECL(i64)
+SORT_DECL(usize)
+SORT_DECL(f32)
+SORT_DECL(f64)
+
+#undef SORT_DECL
+
+// Stable radix sort of 'count' elements of 'size' bytes by the u64 at 'key_offset' of each element.
+NSL_API void nsl_array_sort_by_u64(usize count, usize size, void *items, usize key_offset);
+
+#define nsl_list_sort_by_u64(list, field)                                                          \
+    do {                                                                                           \
+        (void)sizeof(char[sizeof((list)->items->field) == sizeof(u64) ? 1 : -1]);                  \
+        if ((list)->len < 2) break;                                                                \
+        nsl_array_sort_by_u64((list)->len, sizeof(*(list)->items), (list)->items,                  \
+                              (usize)((u8 *)&(list)->items->field - (u8 *)(list)->items));         \
     } while (0)
 
+#define nsl_list_reverse(list)                                                                     \
+    nsl_array_reverse((list)->len, sizeof(*(list)->items), (list)->items)
+
 #define nsl_list_for_each(T, iter, da)                                                             \
     if ((da)->len)                                                                                 \
         for (T iter = (da)->items; iter <= &(da)->items[(da)->len - 1]; iter++)
@@ -706,6 +1614,23 @@ NSL_API u64 nsl_str_hash(nsl_Str s);
 
 #if defined(NSL_IMPLEMENTATION)
 
+#if defined(NSL_WIN32)
+#   include <fcntl.h>
+#   include <sys/stat.h>
+#else
+#   include <sys/mman.h>
+#   include <sys/uio.h>
+#   include <poll.h>
+#   include <fcntl.h>
+#   include <pthread.h>
+#   if defined(__linux__)
+#       include <sys/ioctl.h>
+#       include <sys/sendfile.h>
+#       include <sys/syscall.h>
+#       include <sys/inotify.h>
+#   endif
+#endif
+
 // 4 kb
 #define CHUNK_DEFAULT_SIZE 4096
 
@@ -841,6 +1766,216 @@ NSL_API void nsl_arena_free_chunk(nsl_Arena *arena, void *ptr) {
     free(chunk);
 }
 
+#if defined(NSL_SSSE3)
+// byte shuffles that reverse the order of 1, 2, 4 and 8 byte elements in 16 bytes
+static const u8 _nsl_reverse_masks[4][16] = {
+    {15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0},
+    {14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1},
+    {12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3},
+    {8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7},
+};
+#endif
+
+#define _NSL_REVERSE_AS(T)                                                                         \
+    for (u8 *__hi = hi - sizeof(T); lo < __hi; lo += sizeof(T), __hi -= sizeof(T)) {               \
+        T __a, __b;                                                                                \
+        memcpy(&__a, lo, sizeof(T));                                                               \
+        memcpy(&__b, __hi, sizeof(T));                                                             \
+        memcpy(lo, &__b, sizeof(T));                                                               \
+        memcpy(__hi, &__a, sizeof(T));                                                             \
+    }
+
+NSL_API void nsl_array_reverse(usize count, usize size, void *items) {
+    if (count < 2) return;
+    u8 *lo = items;
+    u8 *hi = lo + count * size;
+
+#if defined(NSL_SSSE3)
+    const usize shift = size == 1 ? 0 : size == 2 ? 1 : size == 4 ? 2 : size == 8 ? 3 : 4;
+    if (shift < 4) {
+        // swap a vector from each end until they meet in the middle
+        const __m128i mask = _mm_loadu_si128((const __m128i *)_nsl_reverse_masks[shift]);
+#if defined(NSL_AVX2)
+        const __m256i mask256 = _mm256_broadcastsi128_si256(mask);
+        for (; 64 <= (usize)(hi - lo); lo += 32, hi -= 32) {
+            __m256i a = _mm256_loadu_si256((const __m256i *)(const void *)lo);
+            __m256i b = _mm256_loadu_si256((const __m256i *)(const void *)(hi - 32));
+            a = _mm256_shuffle_epi8(a, mask256);
+            b = _mm256_shuffle_epi8(b, mask256);
+            _mm256_storeu_si256((__m256i *)(void *)lo, _mm256_permute2x128_si256(b, b, 1));
+            _mm256_storeu_si256((__m256i *)(void *)(hi - 32), _mm256_permute2x128_si256(a, a, 1));
+        }
+#endif
+        for (; 32 <= (usize)(hi - lo); lo += 16, hi -= 16) {
+            const __m128i a = _mm_loadu_si128((const __m128i *)(const void *)lo);
+            const __m128i b = _mm_loadu_si128((const __m128i *)(const void *)(hi - 16));
+            _mm_storeu_si128((__m128i *)(void *)lo, _mm_shuffle_epi8(b, mask));
+            _mm_storeu_si128((__m128i *)(void *)(hi - 16), _mm_shuffle_epi8(a, mask));
+        }
+    }
+#endif
+
+    switch (size) {
+    case 1: _NSL_REVERSE_AS(u8) break;
+    case 2: _NSL_REVERSE_AS(u16) break;
+    case 4: _NSL_REVERSE_AS(u32) break;
+    case 8: _NSL_REVERSE_AS(u64) break;
+    default: {
+        u8 tmp[64];
+        for (hi -= size; lo < hi; lo += size, hi -= size) {
+            for (usize offset = 0; offset < size; offset += sizeof(tmp)) {
+                const usize n = nsl_usize_min(sizeof(tmp), size - offset);
+                memcpy(tmp, &lo[offset], n);
+                memcpy(&lo[offset], &hi[offset], n);
+                memcpy(&hi[offset], tmp, n);
+            }
+        }
+    } break;
+    }
+}
+
+#undef _NSL_REVERSE_AS
+
+#define _NSL_SORT_LESS(a, b) ((a) < (b))
+#define _NSL_SORT_KEY(v) (v)
+
+typedef struct {
+    u64 key;
+    usize idx;
+} _nsl_SortPair;
+
+// the index keeps the small sort stable
+#define _NSL_SORT_PAIR_LESS(a, b) ((a).key < (b).key || ((a).key == (b).key && (a).idx < (b).idx))
+#define _NSL_SORT_PAIR_KEY(v) ((v).key)
+
+// Below this the histograms cost more than they save.
+#define _NSL_RADIX_THRESHOLD 256
+
+#define _NSL_RADIX_IMPL(T, K, BYTES, less, key)                                                    \
+    NSL_SORT_DEFINE(_nsl_sort_##T, T, less)                                                        \
+                                                                                                   \
+    static void _nsl_radix_sort_##T(usize count, T *values) {                                      \
+        if (count < _NSL_RADIX_THRESHOLD) {                                                        \
+            _nsl_sort_##T(count, values);                                                          \
+            return;                                                                                \
+        }                                                                                          \
+        T *tmp = nsl_arena_alloc_chunk(NULL, count * sizeof(T));                                   \
+                                                                                                   \
+        usize hist[BYTES][256];                                                                    \
+        memset(hist, 0, sizeof(hist));                                                             \
+        for (usize i = 0; i < count; i++) {                                                        \
+            const K k = key(values[i]);                                                            \
+            for (usize b = 0; b < BYTES; b++) hist[b][(k >> (b * 8)) & 0xff]++;                    \
+        }                                                                                          \
+                                                                                                   \
+        T *src = values;                                                                           \
+        T *dst = tmp;                                                                              \
+        for (usize b = 0; b < BYTES; b++) {                                                        \
+            usize *h = hist[b];                                                                    \
+            /* every key has the same digit */                                                     \
+            if (h[(key(src[0]) >> (b * 8)) & 0xff] == count) continue;                             \
+            for (usize d = 0, sum = 0; d < 256; d++) {                                             \
+                const usize c = h[d];                                                              \
+                h[d] = sum;                                                                        \
+                sum += c;                                                                          \
+            }                                                                                      \
+            for (usize i = 0; i < count; i++) {                                                    \
+                dst[h[(key(src[i]) >> (b * 8)) & 0xff]++] = src[i];                                \
+            }                                                                                      \
+            T *swap = src;                                                                         \
+            src = dst;                                                                             \
+            dst = swap;                                                                            \
+        }                                                                                          \
+        if (src != values) memcpy(values, src, count * sizeof(T));                                 \
+                                                                                                   \
+        nsl_arena_free_chunk(NULL, tmp);                                                           \
+    }
+
+_NSL_RADIX_IMPL(u8, u8, 1, _NSL_SORT_LESS, _NSL_SORT_KEY)
+_NSL_RADIX_IMPL(u16, u16, 2, _NSL_SORT_LESS, _NSL_SORT_KEY)
+_NSL_RADIX_IMPL(u32, u32, 4, _NSL_SORT_LESS, _NSL_SORT_KEY)
+_NSL_RADIX_IMPL(u64, u64, 8, _NSL_SORT_LESS, _NSL_SORT_KEY)
+_NSL_RADIX_IMPL(_nsl_SortPair, u64, 8, _NSL_SORT_PAIR_LESS, _NSL_SORT_PAIR_KEY)
+
+#define SORT_UNSIGNED_IMPL(T, U)                                                                   \
+    NSL_API void nsl_##T##_sort(usize count, T *values) {                                          \
+        _nsl_radix_sort_##U(count, (U *)(void *)values);                                           \
+    }
+
+// signed values are sorted as unsigned with the sign bit flipped
+#define SORT_SIGNED_IMPL(T, U)                                                                     \
+    NSL_API void nsl_##T##_sort(usize count, T *values) {                                          \
+        U *keys = (U *)(void *)values;                                                             \
+        const U sign = (U)((U)1 << (sizeof(U) * 8 - 1));                                           \
+        for (usize i = 0; i < count; i++) keys[i] ^= sign;                                         \
+        _nsl_radix_sort_##U(count, keys);                                                          \
+        for (usize i = 0; i < count; i++) keys[i] ^= sign;                                         \
+    }
+
+// negative floats get all bits flipped, positive floats only the sign bit
+#define SORT_FLOAT_IMPL(T, U)                                                                      \
+    NSL_API void nsl_##T##_sort(usize count, T *values) {                                          \
+        if (count < 2) return;                                                                     \
+        U *keys = nsl_arena_alloc_chunk(NULL, count * sizeof(U));                                  \
+        const U sign = (U)((U)1 << (sizeof(U) * 8 - 1));                                           \
+        for (usize i = 0; i < count; i++) {                                                        \
+            U k;                                                                                   \
+            memcpy(&k, &values[i], sizeof(U));                                                     \
+            keys[i] = k & sign ? ~k : k | sign;                                                    \
+        }                                                                                          \
+        _nsl_radix_sort_##U(count, keys);                                                          \
+        for (usize i = 0; i < count; i++) {                                                        \
+            const U k = keys[i] & sign ? keys[i] & ~sign : ~keys[i];                               \
+            memcpy(&values[i], &k, sizeof(U));                                                     \
+        }                                                                                          \
+        nsl_arena_free_chunk(NULL, keys);                                                          \
+    }
+
+SORT_UNSIGNED_IMPL(u8, u8)
+SORT_SIGNED_IMPL(i8, u8)
+SORT_UNSIGNED_IMPL(u16, u16)
+SORT_SIGNED_IMPL(i16, u16)
+SORT_UNSIGNED_IMPL(u32, u32)
+SORT_SIGNED_IMPL(i32, u32)
+SORT_UNSIGNED_IMPL(u64, u64)
+SORT_SIGNED_IMPL(i64, u64)
+SORT_FLOAT_IMPL(f32, u32)
+SORT_FLOAT_IMPL(f64, u64)
+
+NSL_API void nsl_usize_sort(usize count, usize *values) {
+    if (sizeof(usize) == sizeof(u64)) {
+        nsl_u64_sort(count, (u64 *)(void *)values);
+    } else {
+        nsl_u32_sort(count, (u32 *)(void *)values);
+    }
+}
+
+#undef SORT_UNSIGNED_IMPL
+#undef SORT_SIGNED_IMPL
+#undef SORT_FLOAT_IMPL
+#undef _NSL_RADIX_IMPL
+
+NSL_API void nsl_array_sort_by_u64(usize count, usize size, void *items, usize key_offset) {
+    if (count < 2) return;
+    // sorts (key, index) pairs and moves every element once at the end
+    _nsl_SortPair *pairs = nsl_arena_alloc_chunk(NULL, count * sizeof(_nsl_SortPair));
+    u8 *bytes = items;
+    for (usize i = 0; i < count; i++) {
+        memcpy(&pairs[i].key, &bytes[i * size + key_offset], sizeof(u64));
+        pairs[i].idx = i;
+    }
+    _nsl_radix_sort__nsl_SortPair(count, pairs);
+
+    u8 *sorted = nsl_arena_alloc_chunk(NULL, count * size);
+    for (usize i = 0; i < count; i++) {
+        memcpy(&sorted[i * size], &bytes[pairs[i].idx * size], size);
+    }
+    memcpy(items, sorted, count * size);
+
+    nsl_arena_free_chunk(NULL, sorted);
+    nsl_arena_free_chunk(NULL, pairs);
+}
+
 NSL_API nsl_Error nsl_cmd_exec(const nsl_Cmd *cmd) {
     return nsl_cmd_exec_argv(cmd->len, cmd->items);
 }
@@ -892,427 +2027,3326 @@ NSL_API nsl_Str nsl_file_read_sb(FILE* file, nsl_StrBuffer* sb) {
 
 NSL_API nsl_Str nsl_file_read_line(FILE* file, nsl_StrBuffer* sb) {
     usize off = sb->len;
-    i32 c = 0;
-    while (!feof(file) && c != '\n') {
-        c = fgetc(file);
+    for (i32 c = 0; (c = getc(file)) != EOF;) {
         nsl_list_push(sb, (char)c);
+        if (c == '\n') break;
     }
     return nsl_str_from_parts(sb->len - off, &sb->items[off]);
 }
 
-NSL_API nsl_Bytes nsl_file_read_bytes(FILE* file, usize size, u8* buffer) {
-    size = fread(buffer, 1, size, file);
-    return nsl_bytes_from_parts(size, buffer);
-}
+// 'z_stream' from zlib.h, the layout is part of the zlib ABI
+typedef struct {
+    const u8 *next_in;
+    unsigned avail_in;
+    unsigned long total_in;
+    u8 *next_out;
+    unsigned avail_out;
+    unsigned long total_out;
+    const char *msg;
+    void *state;
+    void (*zalloc)(void);
+    void (*zfree)(void);
+    void *opaque;
+    int data_type;
+    unsigned long adler;
+    unsigned long reserved;
+} _nsl_ZStream;
+
+// 'ZSTD_inBuffer' and 'ZSTD_outBuffer' from zstd.h
+typedef struct {
+    const void *src;
+    usize size;
+    usize pos;
+} _nsl_ZstdIn;
 
-NSL_API NSL_FMT(2) void nsl_file_write_fmt(FILE* file, const char* fmt, ...) {
-    va_list va;
-    va_start(va, fmt);
-    vfprintf(file, fmt, va);
-    va_end(va);
+typedef struct {
+    void *dst;
+    usize size;
+    usize pos;
+} _nsl_ZstdOut;
+
+typedef int (*_nsl_InflateInit)(_nsl_ZStream *strm, int window_bits, const char *version, int size);
+typedef int (*_nsl_Inflate)(_nsl_ZStream *strm, int flush);
+typedef int (*_nsl_InflateFn)(_nsl_ZStream *strm);
+typedef void *(*_nsl_ZstdCreate)(void);
+typedef usize (*_nsl_ZstdDecompress)(void *ctx, _nsl_ZstdOut *out, _nsl_ZstdIn *in);
+typedef unsigned (*_nsl_ZstdIsError)(usize code);
+typedef usize (*_nsl_ZstdFree)(void *ctx);
+
+typedef struct {
+    nsl_Dll dll;
+    bool loaded;
+    bool eof;
+    bool done;
+    usize pos;
+    usize len;
+    u8 input[NSL_READER_SIZE];
+
+    _nsl_ZStream zlib;
+    _nsl_InflateInit inflate_init;
+    _nsl_Inflate inflate;
+    _nsl_InflateFn inflate_reset;
+    _nsl_InflateFn inflate_end;
+
+    void *zstd;
+    usize zstd_hint; // 0 once a frame is complete
+    _nsl_ZstdDecompress zstd_decompress;
+    _nsl_ZstdIsError zstd_is_error;
+    _nsl_ZstdFree zstd_free;
+} _nsl_ReaderState;
+
+#if defined(NSL_WIN32)
+static const char *_nsl_zlib_names[] = {"zlib1.dll", "zlib.dll"};
+static const char *_nsl_zstd_names[] = {"libzstd.dll", "zstd.dll"};
+#else
+static const char *_nsl_zlib_names[] = {"libz.so.1", "libz.so", "libz.1.dylib", "libz.dylib"};
+static const char *_nsl_zstd_names[] = {"libzstd.so.1", "libzstd.so", "libzstd.1.dylib", "libzstd.dylib"};
+#endif
+
+static bool _nsl_reader_load(_nsl_ReaderState *state, usize count, const char **names) {
+    for (usize i = 0; i < count && !state->loaded; i++) {
+        state->loaded = nsl_dll_load(&state->dll, nsl_str_from_cstr(names[i])) == NSL_NO_ERROR;
+    }
+    return state->loaded;
 }
 
-NSL_API void nsl_file_write_str(FILE* file, nsl_Str content) {
-    fwrite(content.data, 1, content.len, file);
+static bool _nsl_reader_refill(nsl_Reader *reader, _nsl_ReaderState *state) {
+    if (state->pos < state->len) return true;
+    if (state->eof) return false;
+    state->pos = 0;
+    state->len = fread(state->input, 1, sizeof(state->input), reader->file);
+    state->eof = state->len == 0;
+    return state->len != 0;
 }
 
-NSL_API void nsl_file_write_bytes(FILE* file, nsl_Bytes content) {
-    fwrite(content.data, 1, content.size, file);
+static nsl_Error _nsl_reader_init(nsl_Reader *reader, _nsl_ReaderState *state) {
+    if (reader->compression == NSL_COMPRESSION_AUTO) {
+        // the magic bytes stay in the input for the decoder
+        while (state->len < 4 && !state->eof) {
+            const usize size = fread(&state->input[state->len], 1, 4 - state->len, reader->file);
+            state->len += size;
+            state->eof = size == 0;
+        }
+        const u8 *magic = state->input;
+        reader->compression = NSL_COMPRESSION_NONE;
+        if (state->len >= 2 && magic[0] == 0x1f && magic[1] == 0x8b) {
+            reader->compression = NSL_COMPRESSION_GZIP;
+        } else if (state->len >= 4 && nsl_u32_from_le_bytes(nsl_bytes_from_parts(4, magic)) == 0xfd2fb528) {
+            reader->compression = NSL_COMPRESSION_ZSTD;
+        }
+    }
+
+    if (reader->compression == NSL_COMPRESSION_GZIP) {
+        if (!_nsl_reader_load(state, NSL_ARRAY_LEN(_nsl_zlib_names), _nsl_zlib_names)) {
+            return NSL_ERROR_FILE_NOT_FOUND;
+        }
+        state->inflate_init = (_nsl_InflateInit)nsl_dll_symbol(&state->dll, NSL_STR("inflateInit2_"));
+        state->inflate = (_nsl_Inflate)nsl_dll_symbol(&state->dll, NSL_STR("inflate"));
+        state->inflate_reset = (_nsl_InflateFn)nsl_dll_symbol(&state->dll, NSL_STR("inflateReset"));
+        state->inflate_end = (_nsl_InflateFn)nsl_dll_symbol(&state->dll, NSL_STR("inflateEnd"));
+        if (!state->inflate_init || !state->inflate || !state->inflate_reset || !state->inflate_end) {
+            return NSL_ERROR_FILE_NOT_FOUND;
+        }
+        // 15 bits of window, +32 detects gzip and zlib headers. zlib only checks the major version
+        if (state->inflate_init(&state->zlib, 15 + 32, "1", (int)sizeof(_nsl_ZStream)) != 0) {
+            state->inflate_end = NULL;
+            return NSL_ERROR;
+        }
+    } else if (reader->compression == NSL_COMPRESSION_ZSTD) {
+        if (!_nsl_reader_load(state, NSL_ARRAY_LEN(_nsl_zstd_names), _nsl_zstd_names)) {
+            return NSL_ERROR_FILE_NOT_FOUND;
+        }
+        const _nsl_ZstdCreate create = (_nsl_ZstdCreate)nsl_dll_symbol(&state->dll, NSL_STR("ZSTD_createDCtx"));
+        state->zstd_decompress = (_nsl_ZstdDecompress)nsl_dll_symbol(&state->dll, NSL_STR("ZSTD_decompressStream"));
+        state->zstd_is_error = (_nsl_ZstdIsError)nsl_dll_symbol(&state->dll, NSL_STR("ZSTD_isError"));
+        state->zstd_free = (_nsl_ZstdFree)nsl_dll_symbol(&state->dll, NSL_STR("ZSTD_freeDCtx"));
+        if (!create || !state->zstd_decompress || !state->zstd_is_error || !state->zstd_free) {
+            return NSL_ERROR_FILE_NOT_FOUND;
+        }
+        state->zstd = create();
+        if (state->zstd == NULL) return NSL_ERROR;
+    }
+    return NSL_NO_ERROR;
 }
 
-NSL_API void nsl_map_free(nsl_Map *map) {
-    nsl_arena_free_chunk(map->arena, map->items);
+// returns true if another gzip member follows. Zeros after the last member are padding
+static bool _nsl_reader_next_member(nsl_Reader *reader, _nsl_ReaderState *state) {
+    bool padded = false;
+    while (_nsl_reader_refill(reader, state)) {
+        if (state->input[state->pos] != 0) {
+            // only zeros can follow the padding
+            if (padded) reader->error = NSL_ERROR_PARSE;
+            return !padded;
+        }
+        state->pos++;
+        padded = true;
+    }
+    return false;
 }
 
-NSL_API void nsl_map_clear(nsl_Map* map) {
-    map->len = 0;
-    map->del = 0;
-    memset(map->items, 0, sizeof(map->items[0]) * map->cap);
+static usize _nsl_reader_inflate(nsl_Reader *reader, _nsl_ReaderState *state, usize size, u8 *buffer) {
+    _nsl_ZStream *z = &state->zlib;
+    while (!state->done) {
+        _nsl_reader_refill(reader, state);
+        z->next_in = &state->input[state->pos];
+        z->avail_in = (unsigned)(state->len - state->pos);
+        z->next_out = buffer;
+        z->avail_out = (unsigned)nsl_usize_min(size, UINT32_MAX);
+        const int ret = state->inflate(z, 0);
+        state->pos = state->len - z->avail_in;
+        const usize produced = (usize)(z->next_out - buffer);
+
+        if (ret == 1) {
+            // gzip files can have multiple members
+            if (_nsl_reader_next_member(reader, state)) state->inflate_reset(z);
+            else state->done = true;
+        } else if (ret != 0) {
+            // errors, a preset dictionary and no progress, which only happens at the end of the file
+            // when the stream is truncated
+            reader->error = NSL_ERROR_PARSE;
+        }
+        if (reader->error) state->done = true;
+        if (produced) return produced;
+    }
+    return 0;
+}
+
+static usize _nsl_reader_zstd(nsl_Reader *reader, _nsl_ReaderState *state, usize size, u8 *buffer) {
+    while (!state->done) {
+        const bool input = _nsl_reader_refill(reader, state);
+        _nsl_ZstdIn in = {.src = state->input, .size = state->len, .pos = state->pos};
+        _nsl_ZstdOut out = {.dst = buffer, .size = size};
+        const usize ret = state->zstd_decompress(state->zstd, &out, &in);
+        state->pos = in.pos;
+
+        if (state->zstd_is_error(ret)) {
+            reader->error = NSL_ERROR_PARSE;
+            state->done = true;
+        } else if (input || out.pos) {
+            state->zstd_hint = ret;
+        } else {
+            // a frame that is not complete at the end of the file is truncated
+            if (state->zstd_hint != 0) reader->error = NSL_ERROR_PARSE;
+            state->done = true;
+        }
+        if (out.pos) return out.pos;
+    }
+    return 0;
 }
 
-NSL_API bool nsl_map_has(const nsl_Map *map, u64 hash) {
-    if (map->len == 0) {
-        return false;
+NSL_API nsl_Bytes nsl_reader_read(nsl_Reader *reader, usize size, u8 *buffer) {
+    _nsl_ReaderState *state = reader->_state;
+    if (state == NULL) {
+        state = nsl_arena_calloc_chunk(NULL, sizeof(_nsl_ReaderState));
+        reader->_state = state;
+        reader->error = _nsl_reader_init(reader, state);
+        if (reader->error) state->done = true;
     }
+    if (reader->error || size == 0) return nsl_bytes_from_parts(0, buffer);
 
-    // NOTE: rehash in the slight chance that the hash is 0 or NSL_MAP_DELETED
-    if (NSL_UNLIKELY(hash == 0 || hash == NSL_MAP_DELETED)) {
-        hash = nsl_u64_hash(hash);
+    usize len = 0;
+    if (reader->compression == NSL_COMPRESSION_GZIP) {
+        len = _nsl_reader_inflate(reader, state, size, buffer);
+    } else if (reader->compression == NSL_COMPRESSION_ZSTD) {
+        len = _nsl_reader_zstd(reader, state, size, buffer);
+    } else {
+        // the bytes read for the detection come first
+        len = nsl_usize_min(size, state->len - state->pos);
+        memcpy(buffer, &state->input[state->pos], len);
+        state->pos += len;
+        if (len == 0) len = fread(buffer, 1, size, reader->file);
     }
+    return nsl_bytes_from_parts(len, buffer);
+}
 
-    usize idx = hash & (map->cap - 1);
-    for (usize i = 0; i < map->cap; i++) {
-        if (map->items[idx].hash == 0) {
-            return false;
+NSL_API void nsl_reader_free(nsl_Reader *reader) {
+    _nsl_ReaderState *state = reader->_state;
+    if (state == NULL) return;
+    if (state->inflate_end) state->inflate_end(&state->zlib);
+    if (state->zstd) state->zstd_free(state->zstd);
+    if (state->loaded) nsl_dll_close(&state->dll);
+    nsl_arena_free_chunk(NULL, state);
+    reader->_state = NULL;
+}
+
+NSL_API bool nsl_line_reader_next(nsl_LineReader *reader, nsl_Str *line) {
+    // everything before 'scanned' is known to contain no newline
+    usize scanned = reader->start;
+    while (true) {
+        const usize pending = reader->end - reader->start;
+        const char *newline = NULL;
+        if (scanned < reader->end) {
+            newline = memchr(&reader->buffer[scanned], '\n', reader->end - scanned);
         }
-        if (map->items[idx].hash == hash) {
+        if (newline) {
+            const usize len = (usize)(newline - &reader->buffer[reader->start]) + 1;
+            *line = nsl_str_from_parts(len, &reader->buffer[reader->start]);
+            reader->start += len;
             return true;
         }
-        idx = (idx + i * i) & (map->cap - 1);
-    }
 
-    return false;
-}
+        if (reader->eof) {
+            if (pending == 0) return false;
+            *line = nsl_str_from_parts(pending, &reader->buffer[reader->start]);
+            reader->start = reader->end;
+            return true;
+        }
 
-NSL_API void nsl_map_update(nsl_Map *map, nsl_Map *other) {
-    nsl_map_reserve(map, other->len);
-    for (usize i = 0; i < other->cap; ++i) {
-        if (other->items[i].hash && other->items[i].hash != NSL_MAP_DELETED) {
-            nsl_map_insert(map, other->items[i].hash, other->items[i].value);
+        // the only copy: moves the incomplete line to the front before refilling
+        if (reader->start) {
+            memmove(reader->buffer, &reader->buffer[reader->start], pending);
+            reader->start = 0;
+            reader->end = pending;
+        }
+        scanned = pending;
+
+        if (reader->buffer == NULL || reader->end == reader->cap) {
+            if (reader->cap == 0) reader->cap = NSL_LINE_READER_SIZE;
+            else if (reader->buffer) reader->cap *= 2;
+            reader->buffer = nsl_arena_realloc_chunk(reader->arena, reader->buffer, reader->cap);
         }
+
+        const usize space = reader->cap - reader->end;
+        const usize size = reader->source
+            ? nsl_reader_read(reader->source, space, (u8 *)&reader->buffer[reader->end]).size
+            : fread(&reader->buffer[reader->end], 1, space, reader->file);
+        reader->end += size;
+        reader->eof = size == 0;
     }
 }
 
-NSL_API void nsl_map_extend(nsl_Map* map, usize count, const nsl_MapItem* items) {
-    nsl_map_reserve(map, count);
-    for (usize i = 0; i < count; i++) {
-        nsl_map_insert(map, items[i].hash, items[i].value);
-    }
+NSL_API void nsl_line_reader_free(nsl_LineReader *reader) {
+    nsl_arena_free_chunk(reader->arena, reader->buffer);
+    reader->buffer = NULL;
+    reader->start = reader->end = 0;
 }
 
-NSL_API void nsl_map_resize(nsl_Map *map, usize size) {
-    if (size < map->cap) {
-        return;
-    }
-    usize old_cap = map->cap;
-    nsl_MapItem *old_items = map->items;
+static bool _nsl_follower_line(nsl_FileFollower *follower, nsl_Str *line) {
+    if (follower->start == follower->end) return false;
+    const usize pending = follower->end - follower->start;
+    const char *newline = memchr(&follower->buffer[follower->start], '\n', pending);
+    if (newline == NULL) return false;
+    const usize len = (usize)(newline - &follower->buffer[follower->start]) + 1;
+    *line = nsl_str_from_parts(len, &follower->buffer[follower->start]);
+    follower->start += len;
+    return true;
+}
 
-    map->cap = size == 0 ? NSL_MAP_DEFAULT_SIZE : nsl_usize_next_pow2(size);
-    map->items = nsl_arena_calloc_chunk(map->arena, map->cap * sizeof(map->items[0]));
+// the incomplete line at the end of a file that was replaced
+static bool _nsl_follower_rest(nsl_FileFollower *follower, nsl_Str *line) {
+    if (follower->start == follower->end) return false;
+    *line = nsl_str_from_parts(follower->end - follower->start, &follower->buffer[follower->start]);
+    follower->start = follower->end;
+    return true;
+}
 
-    map->len = 0;
-    map->del = 0;
-    for (usize i = 0; i < old_cap; ++i) {
-        if (old_items[i].hash && old_items[i].hash != NSL_MAP_DELETED) {
-            nsl_map_insert(map, old_items[i].hash, old_items[i].value);
-        }
+// moves the incomplete line to the front and returns the free space behind it
+static usize _nsl_follower_reserve(nsl_FileFollower *follower) {
+    if (follower->start) {
+        memmove(follower->buffer, &follower->buffer[follower->start], follower->end - follower->start);
+        follower->end -= follower->start;
+        follower->start = 0;
     }
-    nsl_arena_free_chunk(map->arena, old_items);
+    if (follower->buffer == NULL || follower->end == follower->cap) {
+        if (follower->cap == 0) follower->cap = NSL_LINE_READER_SIZE;
+        else if (follower->buffer) follower->cap *= 2;
+        follower->buffer = nsl_arena_realloc_chunk(follower->arena, follower->buffer, follower->cap);
+    }
+    return follower->cap - follower->end;
 }
 
-NSL_API void nsl_map_reserve(nsl_Map *map, usize size) {
-    usize target = map->len + size;
-    if (target <= map->cap) return;
-    nsl_map_resize(map, target);
+NSL_API nsl_Bytes nsl_file_read_bytes(FILE* file, usize size, u8* buffer) {
+    size = fread(buffer, 1, size, file);
+    return nsl_bytes_from_parts(size, buffer);
 }
 
-NSL_API bool nsl_map_remove(nsl_Map *map, u64 hash) {
-    if (map->len == 0) {
-        return false;
-    }
+NSL_API NSL_FMT(2) void nsl_file_write_fmt(FILE* file, const char* fmt, ...) {
+    va_list va;
+    va_start(va, fmt);
+    vfprintf(file, fmt, va);
+    va_end(va);
+}
 
-    // NOTE: rehash in the slight chance that the hash is 0 or NSL_MAP_DELETED
-    if (NSL_UNLIKELY(hash == 0 || hash == NSL_MAP_DELETED)) {
-        hash = nsl_u64_hash(hash);
-    }
+NSL_API void nsl_file_write_str(FILE* file, nsl_Str content) {
+    fwrite(content.data, 1, content.len, file);
+}
 
-    usize idx = hash & (map->cap - 1);
-    for (usize i = 0; i < map->cap; i++) {
-        if (map->items[idx].hash == 0) {
-            return false;
-        }
-        if (map->items[idx].hash && map->items[idx].hash == hash) {
-            map->items[idx].hash = NSL_MAP_DELETED;
-            map->len--;
-            map->del++;
-            return true;
+NSL_API void nsl_file_write_bytes(FILE* file, nsl_Bytes content) {
+    fwrite(content.data, 1, content.size, file);
+}
+
+static void _nsl_writer_reserve(nsl_Writer *writer) {
+    if (writer->buffer) return;
+    if (writer->cap == 0) writer->cap = NSL_WRITER_SIZE;
+    writer->buffer = nsl_arena_alloc_chunk(writer->arena, writer->cap);
+}
+
+NSL_API void nsl_writer_write_str(nsl_Writer *writer, nsl_Str content) {
+    nsl_writer_write_bytes(writer, nsl_str_to_bytes(content));
+}
+
+NSL_API void nsl_writer_write_bytes(nsl_Writer *writer, nsl_Bytes content) {
+    if (content.size == 0) return;
+    _nsl_writer_reserve(writer);
+    if (writer->cap - writer->len < content.size) {
+        // too large for the buffer: goes out together with the buffered data
+        if (writer->cap <= content.size) {
+            nsl_writer_writev(writer, 1, &content);
+            return;
         }
-        idx = (idx + i * i) & (map->cap - 1);
+        nsl_writer_writev(writer, 0, NULL);
     }
-    return false;
+    memcpy(&writer->buffer[writer->len], content.data, content.size);
+    writer->len += content.size;
 }
 
-bool nsl_map_insert(nsl_Map *map, u64 hash, u64 value) {
-    if (map->cap <= map->len + map->del) {
-        nsl_map_resize(map, map->cap * 2);
+NSL_API NSL_FMT(2) void nsl_writer_write_fmt(nsl_Writer *writer, const char *fmt, ...) {
+    _nsl_writer_reserve(writer);
+    va_list va;
+    va_start(va, fmt);
+    // formats straight into the buffer, the terminator needs one byte as well
+    const i32 size = vsnprintf(&writer->buffer[writer->len], writer->cap - writer->len, fmt, va);
+    va_end(va);
+    if (size < 0) return;
+    if ((usize)size < writer->cap - writer->len) {
+        writer->len += (usize)size;
+        return;
     }
 
-    // NOTE: rehash in the slight chance that the hash is 0 or NSL_MAP_DELETED
-    if (NSL_UNLIKELY(hash == 0 || hash == NSL_MAP_DELETED)) {
-        hash = nsl_u64_hash(hash);
+    nsl_writer_writev(writer, 0, NULL);
+    char *data = (usize)size < writer->cap ? writer->buffer : nsl_arena_alloc_chunk(NULL, (usize)size + 1);
+    va_start(va, fmt);
+    vsnprintf(data, (usize)size + 1, fmt, va);
+    va_end(va);
+    if (data == writer->buffer) {
+        writer->len = (usize)size;
+    } else {
+        const nsl_Bytes content = nsl_bytes_from_parts((usize)size, data);
+        nsl_writer_writev(writer, 1, &content);
+        nsl_arena_free_chunk(NULL, data);
     }
+}
 
-    usize del_idx = (usize)-1;
-    while (true) {
-        usize idx = hash & (map->cap - 1);
+static void _nsl_writer_write_digits(nsl_Writer *writer, u64 value, bool negative) {
+    char digits[21];
+    usize i = sizeof(digits);
+    do {
+        digits[--i] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value);
+    if (negative) digits[--i] = '-';
+    nsl_writer_write_bytes(writer, nsl_bytes_from_parts(sizeof(digits) - i, &digits[i]));
+}
 
-        for (usize i = 0; i < map->cap; i++) {
-            if (map->items[idx].hash == 0) {
-                // NOTE: reusing a deleted slot
-                if (del_idx != (usize)-1) {
-                    map->items[del_idx] = (nsl_MapItem){.hash = hash, .value = value};
-                    map->len++;
-                    map->del--;
-                    return true;
-                }
-                map->items[idx] = (nsl_MapItem){.hash = hash, .value = value};
-                map->len++;
-                return true;
-            } else if (map->items[idx].hash == hash) {
-                map->items[idx].value = value;
-                return false;
-            } else if (map->items[idx].hash == NSL_MAP_DELETED && del_idx == (usize)-1) {
-                del_idx = idx;
-            }
-            idx = (idx + i * i) & (map->cap - 1);
-        }
+NSL_API void nsl_writer_write_u64(nsl_Writer *writer, u64 value) {
+    _nsl_writer_write_digits(writer, value, false);
+}
 
-        nsl_map_resize(map, map->cap * 2);
-    }
+NSL_API void nsl_writer_write_i64(nsl_Writer *writer, i64 value) {
+    // negating in unsigned arithmetic is defined for 'INT64_MIN' as well
+    _nsl_writer_write_digits(writer, value < 0 ? 0 - (u64)value : (u64)value, value < 0);
+}
 
-    NSL_UNREACHABLE("nsl_map_insert");
+NSL_API nsl_Error nsl_writer_flush(nsl_Writer *writer) {
+    nsl_writer_writev(writer, 0, NULL);
+    return writer->error;
 }
 
-u64 *nsl_map_get(nsl_Map *map, u64 hash) {
-    if (map->len == 0) {
-        return NULL;
-    }
+NSL_API nsl_Error nsl_writer_free(nsl_Writer *writer) {
+    const nsl_Error error = nsl_writer_flush(writer);
+    nsl_arena_free_chunk(writer->arena, writer->buffer);
+    writer->buffer = NULL;
+    return error;
+}
 
-    // NOTE: rehash in the slight chance that the hash is 0 or NSL_MAP_DELETED
-    if (NSL_UNLIKELY(hash == 0 || hash == NSL_MAP_DELETED)) {
-        hash = nsl_u64_hash(hash);
+NSL_API void nsl_file_batch_free(nsl_FileBatch *batch) {
+    for (usize i = 0; i < batch->writes.len; i++) {
+        remove(batch->writes.items[i].temp.data);
     }
+    nsl_list_free(&batch->writes);
+    nsl_arena_free(&batch->arena);
+}
 
-    usize idx = hash & (map->cap - 1);
-    for (usize i = 0; i < map->cap; i++) {
-        if (map->items[idx].hash == 0) {
-            return NULL;
-        }
-        if (map->items[idx].hash == hash) {
-            return &map->items[idx].value;
-        }
-        idx = (idx + i * i) & (map->cap - 1);
-    }
+#define _NSL_RECORD_MAGIC   0x464c534e // "NSLF"
+#define _NSL_RECORD_VERSION 1
+#define _NSL_RECORD_HEADER  8
+#define _NSL_RECORD_FOOTER  28
 
-    return NULL;
+NSL_API nsl_Error nsl_record_writer_open(nsl_Path path, nsl_RecordWriter *out) {
+    nsl_Error error = nsl_writer_open(path, &out->writer);
+    if (error) return error;
+    nsl_list_clear(&out->index);
+    nsl_list_clear(&out->buffer);
+    nsl_u32_to_le_bytes(_NSL_RECORD_MAGIC, &out->buffer);
+    nsl_u32_to_le_bytes(_NSL_RECORD_VERSION, &out->buffer);
+    nsl_writer_write_bytes(&out->writer, nsl_bb_to_bytes(&out->buffer));
+    out->offset = _NSL_RECORD_HEADER;
+    return NSL_NO_ERROR;
 }
 
-u64 *nsl_map_get_or_insert(nsl_Map *map, u64 hash, u64 value) {
-    if (map->cap <= map->len + map->del) {
-        nsl_map_resize(map, map->cap * 2);
-    }
+static bool _nsl_record_index_valid(const nsl_RecordFile *file) {
+    // the footer follows the index
+    const nsl_Bytes crc = nsl_bytes_from_parts(4, &file->_index.data[file->_index.size + 16]);
+    return nsl_bytes_crc32c(file->_index) == nsl_u32_from_le_bytes(crc);
+}
 
-    // NOTE: rehash in the slight chance that the hash is 0 or NSL_MAP_DELETED
-    if (NSL_UNLIKELY(hash == 0 || hash == NSL_MAP_DELETED)) {
-        hash = nsl_u64_hash(hash);
+// Loads the index of an existing file, the next record goes after the end of the file.
+static nsl_Error _nsl_record_writer_load(nsl_Path path, nsl_RecordWriter *writer) {
+    nsl_RecordFile file = {0};
+    nsl_Error error = nsl_record_file_open(path, &file);
+    if (error) return error;
+    // the index is written again with a new checksum
+    if (!_nsl_record_index_valid(&file)) {
+        nsl_record_file_close(&file);
+        return NSL_ERROR_PARSE;
     }
+    nsl_list_clear(&writer->index);
+    nsl_list_reserve(&writer->index, file.count);
+    writer->index.len = nsl_bytes_read_u64_le_array(file._index, file.count, writer->index.items);
+    writer->offset = file.map.bytes.size;
+    nsl_record_file_close(&file);
+    return NSL_NO_ERROR;
+}
 
-    usize del_idx = (usize)-1;
-    while (true) {
-        usize idx = hash & (map->cap - 1);
+// pads the end of the file, so the appended records are 8 byte aligned
+static void _nsl_record_writer_align(nsl_RecordWriter *writer) {
+    static const u8 padding[8] = {0};
+    const usize pad = (usize)((8 - writer->offset % 8) % 8);
+    nsl_writer_write_bytes(&writer->writer, nsl_bytes_from_parts(pad, padding));
+    writer->offset += pad;
+}
 
-        for (usize i = 0; i < map->cap; i++) {
-            if (map->items[idx].hash == 0) {
-                // NOTE: reusing a deleted slot
-                if (del_idx != (usize)-1) {
-                    map->items[del_idx] = (nsl_MapItem){.hash = hash, .value = value};
-                    map->len++;
-                    map->del--;
-                    return &map->items[idx].value;
-                }
-                map->items[idx] = (nsl_MapItem){.hash = hash, .value = value};
-                map->len++;
-                return &map->items[idx].value;
-            } else if (map->items[idx].hash == hash) {
-                return &map->items[idx].value;
-            } else if (map->items[idx].hash == NSL_MAP_DELETED && del_idx == (usize)-1) {
-                del_idx = idx;
-            }
-            idx = (idx + i * i) & (map->cap - 1);
-        }
+NSL_API void nsl_record_write(nsl_RecordWriter *writer, nsl_Bytes record) {
+    NSL_ASSERT(record.size <= UINT32_MAX && "record is too big");
+    static const u8 padding[8] = {0};
+    const usize pad = (8 - record.size % 8) % 8;
 
-        nsl_map_resize(map, map->cap * 2);
-    }
+    nsl_list_clear(&writer->buffer);
+    nsl_u32_to_le_bytes((u32)record.size, &writer->buffer);
+    nsl_u32_to_le_bytes(nsl_bytes_crc32c(record), &writer->buffer);
+    nsl_writer_write_bytes(&writer->writer, nsl_bb_to_bytes(&writer->buffer));
+    nsl_writer_write_bytes(&writer->writer, record);
+    nsl_writer_write_bytes(&writer->writer, nsl_bytes_from_parts(pad, padding));
 
-    NSL_UNREACHABLE("nsl_map_insert");
+    nsl_list_push(&writer->index, writer->offset);
+    writer->offset += _NSL_RECORD_HEADER + record.size + pad;
 }
 
-NSL_API bool nsl_map_eq(const nsl_Map *map, const nsl_Map *other) {
-    if (other->len != map->len) return false;
+NSL_API nsl_Error nsl_record_writer_close(nsl_RecordWriter *writer) {
+    nsl_list_clear(&writer->buffer);
+    const nsl_Bytes index = nsl_bb_push_u64_le_array(&writer->buffer, writer->index.len, writer->index.items);
+    const u32 index_crc = nsl_bytes_crc32c(index);
+    const usize footer = writer->buffer.len;
+    nsl_u64_to_le_bytes(writer->index.len, &writer->buffer);
+    nsl_u64_to_le_bytes(writer->offset, &writer->buffer);
+    nsl_u32_to_le_bytes(index_crc, &writer->buffer);
+    const nsl_Bytes fields = nsl_bytes_from_parts(writer->buffer.len - footer, &writer->buffer.items[footer]);
+    nsl_u32_to_le_bytes(nsl_bytes_crc32c(fields), &writer->buffer);
+    nsl_u32_to_le_bytes(_NSL_RECORD_MAGIC, &writer->buffer);
+    nsl_writer_write_bytes(&writer->writer, nsl_bb_to_bytes(&writer->buffer));
 
-    if (other->cap < map->cap) {
-        const nsl_Map *temp = map;
-        map = other;
-        other = temp;
-    }
-    for (usize i = 0; i < map->cap; i++) {
-        if (map->items[i].hash && map->items[i].hash != NSL_MAP_DELETED) {
-            if (!nsl_map_has(other, map->items[i].hash)) {
-                return false;
-            }
-        }
-    }
-    return true;
+    const nsl_Error error = nsl_writer_close(&writer->writer);
+    nsl_list_free(&writer->index);
+    nsl_list_free(&writer->buffer);
+    return error;
 }
 
-NSL_API bool nsl_map_subset(const nsl_Map *map, const nsl_Map *other) {
-    if (other->len < map->len) return false;
+// checks the footer at 'end' and the position of the index before it
+static bool _nsl_record_footer(nsl_Bytes bytes, usize end, u64 *count, u64 *offset) {
+    const nsl_Bytes footer = nsl_bytes_slice(bytes, end, end + _NSL_RECORD_FOOTER);
+    if (nsl_u32_from_le_bytes(nsl_bytes_slice(footer, 24, 28)) != _NSL_RECORD_MAGIC) return false;
+    const u32 crc = nsl_u32_from_le_bytes(nsl_bytes_slice(footer, 20, 24));
+    if (nsl_bytes_crc32c(nsl_bytes_slice(footer, 0, 20)) != crc) return false;
 
-    for (usize i = 0; i < map->cap; i++) {
-        if (map->items[i].hash && map->items[i].hash != NSL_MAP_DELETED) {
-            if (!nsl_map_has(other, map->items[i].hash)) {
-                return false;
-            }
+    *count = nsl_u64_from_le_bytes(nsl_bytes_slice(footer, 0, 8));
+    *offset = nsl_u64_from_le_bytes(nsl_bytes_slice(footer, 8, 16));
+    if (*offset < _NSL_RECORD_HEADER || *offset > end) return false;
+    return (end - *offset) % 8 == 0 && (end - *offset) / 8 == *count;
+}
+
+NSL_API nsl_Error nsl_record_file_open(nsl_Path path, nsl_RecordFile *out) {
+    nsl_FileMap map = {0};
+    nsl_Error error = nsl_file_map(path, &map);
+    if (error) return error;
+
+    nsl_Error result = NSL_NO_ERROR;
+    const nsl_Bytes bytes = map.bytes;
+    if (bytes.size < _NSL_RECORD_HEADER + _NSL_RECORD_FOOTER) NSL_DEFER(NSL_ERROR_PARSE);
+    if (nsl_u32_from_le_bytes(nsl_bytes_slice(bytes, 0, 4)) != _NSL_RECORD_MAGIC ||
+        nsl_u32_from_le_bytes(nsl_bytes_slice(bytes, 4, 8)) != _NSL_RECORD_VERSION) {
+        NSL_DEFER(NSL_ERROR_PARSE);
+    }
+
+    // the index is only checked by 'nsl_record_file_verify', so opening does not depend on its size
+    usize end = bytes.size - _NSL_RECORD_FOOTER;
+    u64 count = 0;
+    u64 offset = 0;
+    if (!_nsl_record_footer(bytes, end, &count, &offset)) {
+        // an append that did not finish leaves the footer before it intact. Footers are 8 byte aligned
+        end -= end % 8;
+        while (!_nsl_record_footer(bytes, end, &count, &offset)) {
+            if (end == _NSL_RECORD_HEADER) NSL_DEFER(NSL_ERROR_PARSE);
+            end -= 8;
         }
     }
-    return true;
+
+    *out = (nsl_RecordFile){
+        .map = map,
+        .count = count,
+        ._index = nsl_bytes_from_parts(end - offset, &bytes.data[offset]),
+    };
+
+defer:
+    if (result) nsl_file_unmap(&map);
+    return result;
 }
 
-NSL_API bool nsl_map_disjoint(const nsl_Map *map, const nsl_Map *other) {
-    if (other->len == 0 || map->len == 0) return true;
+NSL_API nsl_Error nsl_record_file_get(const nsl_RecordFile *file, usize idx, nsl_Bytes *out) {
+    NSL_ASSERT(idx < file->count && "record index out of range");
+    const nsl_Bytes bytes = file->map.bytes;
+    const usize end = (usize)(file->_index.data - bytes.data);
+    const u64 offset = nsl_u64_from_le_bytes(nsl_bytes_slice(file->_index, idx * 8, idx * 8 + 8));
+    if (offset < _NSL_RECORD_HEADER || offset % 8 || offset > end - _NSL_RECORD_HEADER) {
+        return NSL_ERROR_PARSE;
+    }
 
-    if (other->cap < map->cap) {
+    const u32 size = nsl_u32_from_le_bytes(nsl_bytes_from_parts(4, &bytes.data[offset]));
+    const u32 crc = nsl_u32_from_le_bytes(nsl_bytes_from_parts(4, &bytes.data[offset + 4]));
+    if (size > end - offset - _NSL_RECORD_HEADER) return NSL_ERROR_PARSE;
+    const nsl_Bytes data = nsl_bytes_from_parts(size, &bytes.data[offset + _NSL_RECORD_HEADER]);
+    if (nsl_bytes_crc32c(data) != crc) return NSL_ERROR_PARSE;
+    *out = data;
+    return NSL_NO_ERROR;
+}
+
+NSL_API nsl_Error nsl_record_file_verify(const nsl_RecordFile *file) {
+    if (!_nsl_record_index_valid(file)) return NSL_ERROR_PARSE;
+    for (usize i = 0; i < file->count; i++) {
+        nsl_Bytes record = {0};
+        nsl_Error error = nsl_record_file_get(file, i, &record);
+        if (error) return error;
+    }
+    return NSL_NO_ERROR;
+}
+
+NSL_API void nsl_record_file_close(nsl_RecordFile *file) {
+    nsl_file_unmap(&file->map);
+    *file = (nsl_RecordFile){0};
+}
+
+NSL_API nsl_Error nsl_file_checksum(nsl_Path path, u64 *out) {
+    FILE *file = NULL;
+    nsl_Error error = nsl_file_open(&file, path, "rb");
+    if (error) return error;
+
+    nsl_Xxh64 hasher = {0};
+    u8 buffer[64 * 1024];
+    for (nsl_Bytes block; (block = nsl_file_read_bytes(file, sizeof(buffer), buffer)).size;) {
+        nsl_xxh64_update(&hasher, block);
+    }
+    if (ferror(file)) error = NSL_ERROR;
+    nsl_file_close(file);
+
+    if (!error) *out = nsl_xxh64_finish(&hasher);
+    return error;
+}
+
+#if defined(NSL_POSIX)
+typedef pthread_t _nsl_Thread;
+typedef pthread_mutex_t _nsl_Mutex;
+typedef pthread_cond_t _nsl_Cond;
+#define _NSL_THREAD_FN(name, arg) static void *name(void *arg)
+#define _NSL_THREAD_RETURN return NULL
+
+static bool _nsl_thread_start(_nsl_Thread *thread, void *(*fn)(void *), void *arg) {
+    return pthread_create(thread, NULL, fn, arg) == 0;
+}
+static void _nsl_thread_join(_nsl_Thread thread) { pthread_join(thread, NULL); }
+
+static void _nsl_mutex_init(_nsl_Mutex *mutex) { pthread_mutex_init(mutex, NULL); }
+static void _nsl_mutex_lock(_nsl_Mutex *mutex) { pthread_mutex_lock(mutex); }
+static void _nsl_mutex_unlock(_nsl_Mutex *mutex) { pthread_mutex_unlock(mutex); }
+static void _nsl_mutex_destroy(_nsl_Mutex *mutex) { pthread_mutex_destroy(mutex); }
+
+static void _nsl_cond_init(_nsl_Cond *cond) { pthread_cond_init(cond, NULL); }
+static void _nsl_cond_wait(_nsl_Cond *cond, _nsl_Mutex *mutex) { pthread_cond_wait(cond, mutex); }
+static void _nsl_cond_signal(_nsl_Cond *cond) { pthread_cond_signal(cond); }
+static void _nsl_cond_broadcast(_nsl_Cond *cond) { pthread_cond_broadcast(cond); }
+static void _nsl_cond_destroy(_nsl_Cond *cond) { pthread_cond_destroy(cond); }
+#elif defined(NSL_WIN32)
+typedef HANDLE _nsl_Thread;
+typedef CRITICAL_SECTION _nsl_Mutex;
+typedef CONDITION_VARIABLE _nsl_Cond;
+#define _NSL_THREAD_FN(name, arg) static DWORD WINAPI name(LPVOID arg)
+#define _NSL_THREAD_RETURN return 0
+
+static bool _nsl_thread_start(_nsl_Thread *thread, LPTHREAD_START_ROUTINE fn, void *arg) {
+    *thread = CreateThread(NULL, 0, fn, arg, 0, NULL);
+    return *thread != NULL;
+}
+static void _nsl_thread_join(_nsl_Thread thread) {
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+
+static void _nsl_mutex_init(_nsl_Mutex *mutex) { InitializeCriticalSection(mutex); }
+static void _nsl_mutex_lock(_nsl_Mutex *mutex) { EnterCriticalSection(mutex); }
+static void _nsl_mutex_unlock(_nsl_Mutex *mutex) { LeaveCriticalSection(mutex); }
+static void _nsl_mutex_destroy(_nsl_Mutex *mutex) { DeleteCriticalSection(mutex); }
+
+static void _nsl_cond_init(_nsl_Cond *cond) { InitializeConditionVariable(cond); }
+static void _nsl_cond_wait(_nsl_Cond *cond, _nsl_Mutex *mutex) {
+    SleepConditionVariableCS(cond, mutex, INFINITE);
+}
+static void _nsl_cond_signal(_nsl_Cond *cond) { WakeConditionVariable(cond); }
+static void _nsl_cond_broadcast(_nsl_Cond *cond) { WakeAllConditionVariable(cond); }
+static void _nsl_cond_destroy(_nsl_Cond *cond) { (void)cond; }
+#endif
+
+typedef struct {
+    const nsl_ChunkConfig *config;
+    const nsl_Str *chunks;
+    void **results;
+    usize count;
+    usize next;
+    _nsl_Mutex lock;
+} _nsl_ChunkJob;
+
+typedef struct {
+    _nsl_ChunkJob *job;
+    nsl_Arena arena;
+    _nsl_Thread thread;
+} _nsl_ChunkWorker;
+
+// workers take the next chunk until all are done, so slow chunks do not stall the others
+static void _nsl_chunk_work(_nsl_ChunkWorker *worker) {
+    _nsl_ChunkJob *job = worker->job;
+    while (true) {
+        _nsl_mutex_lock(&job->lock);
+        const usize i = job->next++;
+        _nsl_mutex_unlock(&job->lock);
+        if (job->count <= i) break;
+        job->results[i] = job->config->map(job->config->ctx, job->chunks[i], &worker->arena);
+    }
+}
+
+_NSL_THREAD_FN(_nsl_chunk_thread, arg) {
+    _nsl_chunk_work(arg);
+    _NSL_THREAD_RETURN;
+}
+
+NSL_API nsl_Error nsl_str_process_chunks_conf(nsl_Str content, nsl_ChunkConfig config) {
+    NSL_ASSERT(config.map && "no 'map' function");
+    if (config.threads == 0) config.threads = nsl_os_cpu_count();
+    if (config.chunks == 0) config.chunks = config.threads * 4;
+    if (config.delim == 0) config.delim = '\n';
+
+    nsl_Arena scratch = {0};
+    nsl_List(nsl_Str) chunks = {.arena = &scratch};
+    for (nsl_Str rest = content; rest.len;) {
+        // a proportional share of what is left, extended to the next delimiter
+        const usize remaining = config.chunks - nsl_usize_min(chunks.len, config.chunks - 1);
+        const char *start = rest.data;
+        nsl_str_take(&rest, rest.len / remaining);
+        nsl_str_chop_by_delim(&rest, config.delim);
+        nsl_list_push(&chunks, nsl_str_from_parts((usize)(rest.data - start), start));
+    }
+    if (chunks.len == 0) {
+        nsl_arena_free(&scratch);
+        return NSL_NO_ERROR;
+    }
+
+    _nsl_ChunkJob job = {
+        .config = &config,
+        .chunks = chunks.items,
+        .results = nsl_arena_calloc(&scratch, chunks.len * sizeof(void *)),
+        .count = chunks.len,
+    };
+    _nsl_mutex_init(&job.lock);
+
+    const usize count = nsl_usize_min(config.threads, chunks.len);
+    _nsl_ChunkWorker *workers = nsl_arena_calloc(&scratch, count * sizeof(_nsl_ChunkWorker));
+    for (usize i = 0; i < count; i++) {
+        workers[i].job = &job;
+    }
+    // the calling thread is the first worker
+    usize started = 1;
+    while (started < count) {
+        if (!_nsl_thread_start(&workers[started].thread, _nsl_chunk_thread, &workers[started])) break;
+        started++;
+    }
+    _nsl_chunk_work(&workers[0]);
+    for (usize i = 1; i < started; i++) {
+        _nsl_thread_join(workers[i].thread);
+    }
+    _nsl_mutex_destroy(&job.lock);
+
+    if (config.reduce) {
+        for (usize i = 0; i < chunks.len; i++) {
+            config.reduce(config.ctx, job.results[i]);
+        }
+    }
+    for (usize i = 0; i < count; i++) {
+        nsl_arena_free(&workers[i].arena);
+    }
+
+    nsl_arena_free(&scratch);
+    return NSL_NO_ERROR;
+}
+
+NSL_API nsl_Error nsl_file_process_chunks_conf(nsl_Path path, nsl_ChunkConfig config) {
+    nsl_FileMap map = {0};
+    nsl_Error error = nsl_file_map(path, &map);
+    if (error) return error;
+    nsl_file_map_advise(&map, NSL_FILE_MAP_WILLNEED);
+
+    error = nsl_str_process_chunks_conf(nsl_str_from_bytes(map.bytes), config);
+
+    nsl_file_unmap(&map);
+    return error;
+}
+
+typedef struct _nsl_IoRing _nsl_IoRing;
+
+typedef struct {
+    _nsl_Mutex lock;
+    _nsl_Cond submitted;
+    _nsl_Cond completed;
+    nsl_List(nsl_IoRequest *) pending;
+    usize next;
+    nsl_List(nsl_IoRequest *) done;
+    usize outstanding; // submitted and not returned by 'nsl_io_next'
+    bool stop;
+    usize count;
+    _nsl_Thread *threads;
+    _nsl_IoRing *ring; // replaces the workers if io_uring is available
+    nsl_Arena arena;
+} _nsl_IoState;
+
+// expects the lock to be held
+static nsl_IoRequest *_nsl_io_take(_nsl_IoState *state) {
+    if (state->next == state->pending.len) return NULL;
+    nsl_IoRequest *request = state->pending.items[state->next++];
+    if (state->next == state->pending.len) state->next = state->pending.len = 0;
+    return request;
+}
+
+#if defined(__linux__) && defined(SYS_io_uring_setup) && defined(SYS_io_uring_enter)
+// the io_uring ABI from 'linux/io_uring.h', which is not installed everywhere
+#define _NSL_IO_RING_OPENAT         18
+#define _NSL_IO_RING_READ           22
+#define _NSL_IO_RING_WRITE          23
+#define _NSL_IO_RING_OFF_SQES       0x10000000ull
+#define _NSL_IO_RING_GETEVENTS      1u
+#define _NSL_IO_RING_SINGLE_MMAP    1u
+#define _NSL_IO_RING_RW_CUR_POS     8u
+// every request has at most one operation in flight, so this is the number of open files as well
+#define _NSL_IO_RING_ENTRIES 128
+
+typedef struct {
+    u32 head, tail, ring_mask, ring_entries, flags, dropped, array, resv;
+    u64 user_addr;
+} _nsl_IoSqOffsets;
+
+typedef struct {
+    u32 head, tail, ring_mask, ring_entries, overflow, cqes, flags, resv;
+    u64 user_addr;
+} _nsl_IoCqOffsets;
+
+typedef struct {
+    u32 sq_entries, cq_entries, flags, sq_thread_cpu, sq_thread_idle, features, wq_fd, resv[3];
+    _nsl_IoSqOffsets sq_off;
+    _nsl_IoCqOffsets cq_off;
+} _nsl_IoParams;
+
+typedef struct {
+    u8 opcode;
+    u8 flags;
+    u16 ioprio;
+    i32 fd;
+    u64 off;
+    u64 addr;
+    u32 len;      // the mode for 'openat'
+    u32 op_flags; // the flags for 'openat'
+    u64 user_data;
+    u64 pad[3];
+} _nsl_IoSqe;
+
+typedef struct {
+    u64 user_data;
+    i32 res;
+    u32 flags;
+} _nsl_IoCqe;
+
+typedef struct {
+    nsl_IoRequest *request;
+    int fd; // -1 until the file is opened
+    usize size;
+    usize len;
+    u8 *data;
+    char *path; // copy of the request path with a null terminator
+    usize path_cap;
+} _nsl_IoSlot;
+
+struct _nsl_IoRing {
+    int fd;
+    usize size;
+    u8 *rings;
+    _nsl_IoSqe *sqes;
+    u32 sq_entries;
+    u32 *sq_tail, *sq_mask;
+    u32 *cq_head, *cq_tail, *cq_mask;
+    _nsl_IoCqe *cqes;
+    u32 queued; // in the submission queue, but not passed to the kernel yet
+    u32 active;
+    u32 free_len;
+    u32 free[_NSL_IO_RING_ENTRIES];
+    _nsl_IoSlot slots[_NSL_IO_RING_ENTRIES];
+};
+
+// returns NULL if io_uring is not available, the operations need linux 5.6
+static _nsl_IoRing *_nsl_io_ring_new(void) {
+    _nsl_IoParams params = {0};
+    const int fd = (int)syscall(SYS_io_uring_setup, _NSL_IO_RING_ENTRIES, &params);
+    if (fd == -1) return NULL;
+
+    const u32 features = _NSL_IO_RING_SINGLE_MMAP | _NSL_IO_RING_RW_CUR_POS;
+    const usize sq_size = params.sq_off.array + params.sq_entries * sizeof(u32);
+    const usize cq_size = params.cq_off.cqes + params.cq_entries * sizeof(_nsl_IoCqe);
+    const usize size = nsl_usize_max(sq_size, cq_size);
+    const usize sqes_size = params.sq_entries * sizeof(_nsl_IoSqe);
+    void *rings = MAP_FAILED;
+    void *sqes = MAP_FAILED;
+    if ((params.features & features) == features && params.sq_entries >= _NSL_IO_RING_ENTRIES) {
+        rings = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        sqes = mmap(NULL, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, (off_t)_NSL_IO_RING_OFF_SQES);
+    }
+    if (rings == MAP_FAILED || sqes == MAP_FAILED) {
+        if (rings != MAP_FAILED) munmap(rings, size);
+        if (sqes != MAP_FAILED) munmap(sqes, sqes_size);
+        close(fd);
+        return NULL;
+    }
+
+    _nsl_IoRing *ring = nsl_arena_calloc_chunk(NULL, sizeof(_nsl_IoRing));
+    ring->fd = fd;
+    ring->size = size;
+    ring->rings = rings;
+    ring->sqes = sqes;
+    ring->sq_entries = params.sq_entries;
+    ring->sq_tail = (u32 *)(void *)&ring->rings[params.sq_off.tail];
+    ring->sq_mask = (u32 *)(void *)&ring->rings[params.sq_off.ring_mask];
+    ring->cq_head = (u32 *)(void *)&ring->rings[params.cq_off.head];
+    ring->cq_tail = (u32 *)(void *)&ring->rings[params.cq_off.tail];
+    ring->cq_mask = (u32 *)(void *)&ring->rings[params.cq_off.ring_mask];
+    ring->cqes = (_nsl_IoCqe *)(void *)&ring->rings[params.cq_off.cqes];
+    // the entries are used in order, so every index points to the entry with the same position
+    u32 *array = (u32 *)(void *)&ring->rings[params.sq_off.array];
+    for (u32 i = 0; i < params.sq_entries; i++) array[i] = i;
+    for (u32 i = 0; i < _NSL_IO_RING_ENTRIES; i++) ring->free[ring->free_len++] = _NSL_IO_RING_ENTRIES - 1 - i;
+    return ring;
+}
+
+static void _nsl_io_ring_push(_nsl_IoRing *ring, const _nsl_IoSqe *sqe) {
+    const u32 tail = *ring->sq_tail;
+    ring->sqes[tail & *ring->sq_mask] = *sqe;
+    // the kernel reads the entry after it sees the new tail
+    __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    ring->queued++;
+}
+
+static void _nsl_io_ring_open(_nsl_IoRing *ring, u32 idx) {
+    const _nsl_IoSlot *slot = &ring->slots[idx];
+    int flags = O_RDONLY;
+    if (slot->request->op == NSL_IO_WRITE)  flags = O_WRONLY | O_CREAT | O_TRUNC;
+    if (slot->request->op == NSL_IO_APPEND) flags = O_WRONLY | O_CREAT | O_APPEND;
+    const _nsl_IoSqe sqe = {
+        .opcode = _NSL_IO_RING_OPENAT,
+        .fd = AT_FDCWD,
+        .addr = (u64)(usize)slot->path,
+        .len = 0644,
+        .op_flags = (u32)(flags | O_CLOEXEC),
+        .user_data = idx,
+    };
+    _nsl_io_ring_push(ring, &sqe);
+}
+
+// reads or writes the rest of the file
+static void _nsl_io_ring_transfer(_nsl_IoRing *ring, u32 idx) {
+    const _nsl_IoSlot *slot = &ring->slots[idx];
+    const nsl_IoRequest *request = slot->request;
+    const bool read = request->op == NSL_IO_READ;
+    const u8 *data = read ? slot->data : request->data.data;
+    const _nsl_IoSqe sqe = {
+        .opcode = read ? _NSL_IO_RING_READ : _NSL_IO_RING_WRITE,
+        .fd = slot->fd,
+        // appends write at the current position, which 'O_APPEND' keeps at the end
+        .off = request->op == NSL_IO_APPEND ? UINT64_MAX : (u64)slot->len,
+        .addr = (u64)(usize)&data[slot->len],
+        .len = (u32)nsl_usize_min(slot->size - slot->len, 1u << 30),
+        .user_data = idx,
+    };
+    _nsl_io_ring_push(ring, &sqe);
+}
+
+static void _nsl_io_ring_start(_nsl_IoState *state, nsl_IoRequest *request) {
+    _nsl_IoRing *ring = state->ring;
+    const u32 idx = ring->free[--ring->free_len];
+    _nsl_IoSlot *slot = &ring->slots[idx];
+    if (slot->path_cap < request->path.len + 1) {
+        slot->path_cap = nsl_usize_max(nsl_usize_next_pow2(request->path.len + 1), 64);
+        slot->path = nsl_arena_realloc_chunk(NULL, slot->path, slot->path_cap);
+    }
+    memcpy(slot->path, request->path.data, request->path.len);
+    slot->path[request->path.len] = '\0';
+    slot->request = request;
+    slot->fd = -1;
+    slot->size = slot->len = 0;
+    slot->data = NULL;
+    ring->active++;
+    _nsl_io_ring_open(ring, idx);
+}
+
+// continues the request with the result of its last operation
+static void _nsl_io_ring_step(nsl_IoQueue *queue, _nsl_IoState *state, u32 idx, i32 res) {
+    _nsl_IoRing *ring = state->ring;
+    _nsl_IoSlot *slot = &ring->slots[idx];
+    nsl_IoRequest *request = slot->request;
+    const bool read = request->op == NSL_IO_READ;
+    if (res == -EINTR || res == -EAGAIN) {
+        if (slot->fd == -1) _nsl_io_ring_open(ring, idx);
+        else _nsl_io_ring_transfer(ring, idx);
+        return;
+    }
+
+    nsl_Error error = NSL_NO_ERROR;
+    if (slot->fd == -1) {
+        if (res == -ENOENT) error = NSL_ERROR_FILE_NOT_FOUND;
+        else if (res == -EACCES) error = NSL_ERROR_ACCESS_DENIED;
+        else if (res == -EISDIR) error = NSL_ERROR_IS_DIRECTORY;
+        else if (res == -ENAMETOOLONG) error = NSL_ERROR_PATH_TOO_LONG;
+        else if (res < 0) error = NSL_ERROR;
+        slot->fd = res < 0 ? -1 : res;
+        struct stat info;
+        if (error == NSL_NO_ERROR && read) {
+            if (fstat(slot->fd, &info) == -1 || !S_ISREG(info.st_mode)) {
+                error = NSL_ERROR;
+            } else {
+                slot->size = (usize)info.st_size;
+                slot->data = nsl_arena_alloc(queue->arena ? queue->arena : &state->arena, slot->size + 1);
+            }
+        } else if (error == NSL_NO_ERROR) {
+            slot->size = request->data.size;
+        }
+    } else if (res < 0 || (res == 0 && !read)) {
+        error = NSL_ERROR;
+    } else if (res == 0) {
+        // the file got shorter since it was opened
+        slot->size = slot->len;
+    } else {
+        slot->len += (usize)res;
+    }
+
+    if (error == NSL_NO_ERROR && slot->len < slot->size) {
+        _nsl_io_ring_transfer(ring, idx);
+        return;
+    }
+    if (error == NSL_NO_ERROR && read) {
+        slot->data[slot->len] = '\0';
+        request->data = nsl_bytes_from_parts(slot->len, slot->data);
+    }
+    if (slot->fd != -1) close(slot->fd);
+    request->error = error;
+    nsl_list_push(&state->done, request);
+    slot->request = NULL;
+    ring->free[ring->free_len++] = idx;
+    ring->active--;
+}
+
+// starts pending requests, submits the operations and processes the completions. With 'wait' it
+// blocks until at least one operation completed.
+static void _nsl_io_ring_run(nsl_IoQueue *queue, _nsl_IoState *state, bool wait) {
+    _nsl_IoRing *ring = state->ring;
+    for (nsl_IoRequest *request; ring->free_len && (request = _nsl_io_take(state)) != NULL;) {
+        _nsl_io_ring_start(state, request);
+    }
+
+    const u32 min = wait && ring->active ? 1 : 0;
+    while (ring->queued || min) {
+        const u32 flags = min ? _NSL_IO_RING_GETEVENTS : 0;
+        const long n = syscall(SYS_io_uring_enter, ring->fd, ring->queued, min, flags, NULL, 0);
+        if (n == -1 && (errno == EINTR || errno == EAGAIN)) continue;
+        if (n == -1) NSL_PANIC(strerror(errno));
+        ring->queued -= (u32)n;
+        break;
+    }
+
+    u32 head = *ring->cq_head;
+    const u32 tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+    for (; head != tail; head++) {
+        const _nsl_IoCqe *cqe = &ring->cqes[head & *ring->cq_mask];
+        _nsl_io_ring_step(queue, state, (u32)cqe->user_data, cqe->res);
+    }
+    // the kernel can reuse the entries after it sees the new head
+    __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+}
+
+// completes the pending requests first
+static void _nsl_io_ring_free(nsl_IoQueue *queue, _nsl_IoState *state) {
+    _nsl_IoRing *ring = state->ring;
+    while (ring->active || state->next < state->pending.len) _nsl_io_ring_run(queue, state, true);
+    for (usize i = 0; i < _NSL_IO_RING_ENTRIES; i++) nsl_arena_free_chunk(NULL, ring->slots[i].path);
+    munmap(ring->sqes, ring->sq_entries * sizeof(_nsl_IoSqe));
+    munmap(ring->rings, ring->size);
+    close(ring->fd);
+    nsl_arena_free_chunk(NULL, ring);
+    state->ring = NULL;
+}
+#else
+static _nsl_IoRing *_nsl_io_ring_new(void) { return NULL; }
+static void _nsl_io_ring_run(nsl_IoQueue *queue, _nsl_IoState *state, bool wait) {
+    (void)queue;
+    (void)state;
+    (void)wait;
+}
+static void _nsl_io_ring_free(nsl_IoQueue *queue, _nsl_IoState *state) {
+    (void)queue;
+    (void)state;
+}
+#endif
+
+_NSL_THREAD_FN(_nsl_io_thread, arg) {
+    nsl_IoQueue *queue = arg;
+    _nsl_IoState *state = queue->_state;
+    _nsl_mutex_lock(&state->lock);
+    while (true) {
+        while (!state->stop && state->next == state->pending.len) {
+            _nsl_cond_wait(&state->submitted, &state->lock);
+        }
+        nsl_IoRequest *request = _nsl_io_take(state);
+        if (request == NULL) break;
+        _nsl_mutex_unlock(&state->lock);
+
+        nsl_io_perform(queue, request);
+
+        _nsl_mutex_lock(&state->lock);
+        nsl_list_push(&state->done, request);
+        _nsl_cond_signal(&state->completed);
+    }
+    _nsl_mutex_unlock(&state->lock);
+    _NSL_THREAD_RETURN;
+}
+
+static _nsl_IoState *_nsl_io_state(nsl_IoQueue *queue) {
+    if (queue->_state) return queue->_state;
+    _nsl_IoState *state = nsl_arena_alloc_chunk(NULL, sizeof(_nsl_IoState));
+    memset(state, 0, sizeof(_nsl_IoState));
+    _nsl_mutex_init(&state->lock);
+    _nsl_cond_init(&state->submitted);
+    _nsl_cond_init(&state->completed);
+    queue->_state = state;
+    return state;
+}
+
+static _nsl_IoState *_nsl_io_start(nsl_IoQueue *queue) {
+    _nsl_IoState *state = _nsl_io_state(queue);
+    if (state->threads || state->ring) return state;
+    // io_uring completes the requests without any threads, the pool is the fallback
+    if (!queue->use_pool && (state->ring = _nsl_io_ring_new()) != NULL) return state;
+
+    const usize threads = queue->threads ? queue->threads : nsl_os_cpu_count();
+    state->threads = nsl_arena_alloc_chunk(NULL, threads * sizeof(_nsl_Thread));
+    while (state->count < threads) {
+        if (!_nsl_thread_start(&state->threads[state->count], _nsl_io_thread, queue)) break;
+        state->count++;
+    }
+    return state;
+}
+
+// the arena is shared by all workers, so reads allocate under the lock
+static void *_nsl_io_alloc(nsl_IoQueue *queue, usize size) {
+    _nsl_IoState *state = queue->_state;
+    if (state == NULL) {
+        // nothing was submitted, so there are no workers to share the arena with
+        if (queue->arena) return nsl_arena_alloc(queue->arena, size);
+        state = _nsl_io_state(queue);
+    }
+    _nsl_mutex_lock(&state->lock);
+    void *data = nsl_arena_alloc(queue->arena ? queue->arena : &state->arena, size);
+    _nsl_mutex_unlock(&state->lock);
+    return data;
+}
+
+NSL_API void nsl_io_submit(nsl_IoQueue *queue, usize count, nsl_IoRequest *requests) {
+    _nsl_IoState *state = _nsl_io_start(queue);
+    _nsl_mutex_lock(&state->lock);
+    state->outstanding += count;
+    for (usize i = 0; i < count; i++) {
+        // without workers the requests are completed right away
+        if (state->count == 0 && state->ring == NULL) {
+            _nsl_mutex_unlock(&state->lock);
+            nsl_io_perform(queue, &requests[i]);
+            _nsl_mutex_lock(&state->lock);
+            nsl_list_push(&state->done, &requests[i]);
+        } else {
+            nsl_list_push(&state->pending, &requests[i]);
+        }
+    }
+    if (state->ring) _nsl_io_ring_run(queue, state, false);
+    _nsl_cond_broadcast(&state->submitted);
+    _nsl_mutex_unlock(&state->lock);
+}
+
+NSL_API nsl_IoRequest *nsl_io_next(nsl_IoQueue *queue) {
+    _nsl_IoState *state = queue->_state;
+    if (state == NULL) return NULL;
+    _nsl_mutex_lock(&state->lock);
+    while (state->ring && state->done.len == 0 && state->outstanding) {
+        _nsl_io_ring_run(queue, state, true);
+    }
+    nsl_IoRequest *request = NULL;
+    if (state->done.len == 0 && (request = _nsl_io_take(state)) != NULL) {
+        // instead of waiting the caller completes a pending request itself
+        _nsl_mutex_unlock(&state->lock);
+        nsl_io_perform(queue, request);
+        _nsl_mutex_lock(&state->lock);
+    } else {
+        while (state->done.len == 0 && state->outstanding) {
+            _nsl_cond_wait(&state->completed, &state->lock);
+        }
+        if (state->done.len) request = nsl_list_pop(&state->done);
+    }
+    if (request) state->outstanding--;
+    _nsl_mutex_unlock(&state->lock);
+    return request;
+}
+
+NSL_API void nsl_io_wait(nsl_IoQueue *queue) {
+    _nsl_IoState *state = queue->_state;
+    if (state == NULL) return;
+    _nsl_mutex_lock(&state->lock);
+    while (state->ring && state->done.len < state->outstanding) {
+        _nsl_io_ring_run(queue, state, true);
+    }
+    for (nsl_IoRequest *request; (request = _nsl_io_take(state)) != NULL;) {
+        _nsl_mutex_unlock(&state->lock);
+        nsl_io_perform(queue, request);
+        _nsl_mutex_lock(&state->lock);
+        nsl_list_push(&state->done, request);
+    }
+    while (state->done.len < state->outstanding) {
+        _nsl_cond_wait(&state->completed, &state->lock);
+    }
+    state->outstanding = 0;
+    state->done.len = 0;
+    _nsl_mutex_unlock(&state->lock);
+}
+
+NSL_API void nsl_io_queue_free(nsl_IoQueue *queue) {
+    _nsl_IoState *state = queue->_state;
+    if (state == NULL) return;
+    if (state->ring) _nsl_io_ring_free(queue, state);
+    _nsl_mutex_lock(&state->lock);
+    state->stop = true;
+    _nsl_cond_broadcast(&state->submitted);
+    _nsl_mutex_unlock(&state->lock);
+    for (usize i = 0; i < state->count; i++) {
+        _nsl_thread_join(state->threads[i]);
+    }
+
+    _nsl_cond_destroy(&state->submitted);
+    _nsl_cond_destroy(&state->completed);
+    _nsl_mutex_destroy(&state->lock);
+    nsl_list_free(&state->pending);
+    nsl_list_free(&state->done);
+    nsl_arena_free(&state->arena);
+    nsl_arena_free_chunk(NULL, state->threads);
+    nsl_arena_free_chunk(NULL, state);
+    queue->_state = NULL;
+}
+
+NSL_API nsl_Error nsl_os_copy_dir_conf(nsl_Path src, nsl_Path dst, nsl_OsCopyConfig config) {
+    if (!nsl_os_exists(src)) return NSL_ERROR_FILE_NOT_FOUND;
+    if (!nsl_os_is_dir(src)) return NSL_ERROR_NOT_DIRECTORY;
+    nsl_Error result = nsl_os_mkdir(dst, .exists_ok = true, .parents = true);
+    if (result) return result;
+
+    nsl_Arena arena = {0};
+    // entries are joined to the source like this, so the prefix has the same length
+    const nsl_Path prefix[] = {src, NSL_PATH("")};
+    const nsl_Path base = nsl_path_join(NSL_ARRAY_LEN(prefix), prefix, &arena);
+    nsl_dir_walk(entry, src, true) {
+        nsl_Arena scratch = {0};
+        const nsl_Path parts[] = {dst, nsl_str_substring(entry->path, base.len, entry->path.len)};
+        const nsl_Path target = nsl_path_join(NSL_ARRAY_LEN(parts), parts, &scratch);
+        // parent directories are always visited before their entries
+        if (entry->is_dir) result = nsl_os_mkdir(target, .exists_ok = true);
+        else result = nsl_os_copy_file_conf(entry->path, target, config);
+        nsl_arena_free(&scratch);
+        if (result) break;
+    }
+
+    nsl_arena_free(&arena);
+    return result;
+}
+
+NSL_API void nsl_map_free(nsl_Map *map) {
+    nsl_arena_free_chunk(map->arena, map->items);
+}
+
+NSL_API void nsl_map_clear(nsl_Map* map) {
+    map->len = 0;
+    map->del = 0;
+    memset(map->items, 0, sizeof(map->items[0]) * map->cap);
+}
+
+NSL_API bool nsl_map_has(const nsl_Map *map, u64 hash) {
+    if (map->len == 0) {
+        return false;
+    }
+
+    // NOTE: rehash in the slight chance that the hash is 0 or NSL_MAP_DELETED
+    if (NSL_UNLIKELY(hash == 0 || hash == NSL_MAP_DELETED)) {
+        hash = nsl_u64_hash(hash);
+    }
+
+    usize idx = hash & (map->cap - 1);
+    for (usize i = 0; i < map->cap; i++) {
+        if (map->items[idx].hash == 0) {
+            return false;
+        }
+        if (map->items[idx].hash == hash) {
+            return true;
+        }
+        idx = (idx + i * i) & (map->cap - 1);
+    }
+
+    return false;
+}
+
+NSL_API void nsl_map_update(nsl_Map *map, nsl_Map *other) {
+    nsl_map_reserve(map, other->len);
+    for (usize i = 0; i < other->cap; ++i) {
+        if (other->items[i].hash && other->items[i].hash != NSL_MAP_DELETED) {
+            nsl_map_insert(map, other->items[i].hash, other->items[i].value);
+        }
+    }
+}
+
+NSL_API void nsl_map_extend(nsl_Map* map, usize count, const nsl_MapItem* items) {
+    nsl_map_reserve(map, count);
+    for (usize i = 0; i < count; i++) {
+        nsl_map_insert(map, items[i].hash, items[i].value);
+    }
+}
+
+NSL_API void nsl_map_resize(nsl_Map *map, usize size) {
+    if (size < map->cap) {
+        return;
+    }
+    usize old_cap = map->cap;
+    nsl_MapItem *old_items = map->items;
+
+    map->cap = size == 0 ? NSL_MAP_DEFAULT_SIZE : nsl_usize_next_pow2(size);
+    map->items = nsl_arena_calloc_chunk(map->arena, map->cap * sizeof(map->items[0]));
+
+    map->len = 0;
+    map->del = 0;
+    for (usize i = 0; i < old_cap; ++i) {
+        if (old_items[i].hash && old_items[i].hash != NSL_MAP_DELETED) {
+            nsl_map_insert(map, old_items[i].hash, old_items[i].value);
+        }
+    }
+    nsl_arena_free_chunk(map->arena, old_items);
+}
+
+NSL_API void nsl_map_reserve(nsl_Map *map, usize size) {
+    usize target = map->len + size;
+    if (target <= map->cap) return;
+    nsl_map_resize(map, target);
+}
+
+NSL_API bool nsl_map_remove(nsl_Map *map, u64 hash) {
+    if (map->len == 0) {
+        return false;
+    }
+
+    // NOTE: rehash in the slight chance that the hash is 0 or NSL_MAP_DELETED
+    if (NSL_UNLIKELY(hash == 0 || hash == NSL_MAP_DELETED)) {
+        hash = nsl_u64_hash(hash);
+    }
+
+    usize idx = hash & (map->cap - 1);
+    for (usize i = 0; i < map->cap; i++) {
+        if (map->items[idx].hash == 0) {
+            return false;
+        }
+        if (map->items[idx].hash && map->items[idx].hash == hash) {
+            map->items[idx].hash = NSL_MAP_DELETED;
+            map->len--;
+            map->del++;
+            return true;
+        }
+        idx = (idx + i * i) & (map->cap - 1);
+    }
+    return false;
+}
+
+bool nsl_map_insert(nsl_Map *map, u64 hash, u64 value) {
+    if (map->cap <= map->len + map->del) {
+        nsl_map_resize(map, map->cap * 2);
+    }
+
+    // NOTE: rehash in the slight chance that the hash is 0 or NSL_MAP_DELETED
+    if (NSL_UNLIKELY(hash == 0 || hash == NSL_MAP_DELETED)) {
+        hash = nsl_u64_hash(hash);
+    }
+
+    usize del_idx = (usize)-1;
+    while (true) {
+        usize idx = hash & (map->cap - 1);
+
+        for (usize i = 0; i < map->cap; i++) {
+            if (map->items[idx].hash == 0) {
+                // NOTE: reusing a deleted slot
+                if (del_idx != (usize)-1) {
+                    map->items[del_idx] = (nsl_MapItem){.hash = hash, .value = value};
+                    map->len++;
+                    map->del--;
+                    return true;
+                }
+                map->items[idx] = (nsl_MapItem){.hash = hash, .value = value};
+                map->len++;
+                return true;
+            } else if (map->items[idx].hash == hash) {
+                map->items[idx].value = value;
+                return false;
+            } else if (map->items[idx].hash == NSL_MAP_DELETED && del_idx == (usize)-1) {
+                del_idx = idx;
+            }
+            idx = (idx + i * i) & (map->cap - 1);
+        }
+
+        nsl_map_resize(map, map->cap * 2);
+    }
+
+    NSL_UNREACHABLE("nsl_map_insert");
+}
+
+u64 *nsl_map_get(nsl_Map *map, u64 hash) {
+    if (map->len == 0) {
+        return NULL;
+    }
+
+    // NOTE: rehash in the slight chance that the hash is 0 or NSL_MAP_DELETED
+    if (NSL_UNLIKELY(hash == 0 || hash == NSL_MAP_DELETED)) {
+        hash = nsl_u64_hash(hash);
+    }
+
+    usize idx = hash & (map->cap - 1);
+    for (usize i = 0; i < map->cap; i++) {
+        if (map->items[idx].hash == 0) {
+            return NULL;
+        }
+        if (map->items[idx].hash == hash) {
+            return &map->items[idx].value;
+        }
+        idx = (idx + i * i) & (map->cap - 1);
+    }
+
+    return NULL;
+}
+
+u64 *nsl_map_get_or_insert(nsl_Map *map, u64 hash, u64 value) {
+    if (map->cap <= map->len + map->del) {
+        nsl_map_resize(map, map->cap * 2);
+    }
+
+    // NOTE: rehash in the slight chance that the hash is 0 or NSL_MAP_DELETED
+    if (NSL_UNLIKELY(hash == 0 || hash == NSL_MAP_DELETED)) {
+        hash = nsl_u64_hash(hash);
+    }
+
+    usize del_idx = (usize)-1;
+    while (true) {
+        usize idx = hash & (map->cap - 1);
+
+        for (usize i = 0; i < map->cap; i++) {
+            if (map->items[idx].hash == 0) {
+                // NOTE: reusing a deleted slot
+                if (del_idx != (usize)-1) {
+                    map->items[del_idx] = (nsl_MapItem){.hash = hash, .value = value};
+                    map->len++;
+                    map->del--;
+                    return &map->items[idx].value;
+                }
+                map->items[idx] = (nsl_MapItem){.hash = hash, .value = value};
+                map->len++;
+                return &map->items[idx].value;
+            } else if (map->items[idx].hash == hash) {
+                return &map->items[idx].value;
+            } else if (map->items[idx].hash == NSL_MAP_DELETED && del_idx == (usize)-1) {
+                del_idx = idx;
+            }
+            idx = (idx + i * i) & (map->cap - 1);
+        }
+
+        nsl_map_resize(map, map->cap * 2);
+    }
+
+    NSL_UNREACHABLE("nsl_map_insert");
+}
+
+NSL_API bool nsl_map_eq(const nsl_Map *map, const nsl_Map *other) {
+    if (other->len != map->len) return false;
+
+    if (other->cap < map->cap) {
+        const nsl_Map *temp = map;
+        map = other;
+        other = temp;
+    }
+    for (usize i = 0; i < map->cap; i++) {
+        if (map->items[i].hash && map->items[i].hash != NSL_MAP_DELETED) {
+            if (!nsl_map_has(other, map->items[i].hash)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+NSL_API bool nsl_map_subset(const nsl_Map *map, const nsl_Map *other) {
+    if (other->len < map->len) return false;
+
+    for (usize i = 0; i < map->cap; i++) {
+        if (map->items[i].hash && map->items[i].hash != NSL_MAP_DELETED) {
+            if (!nsl_map_has(other, map->items[i].hash)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+NSL_API bool nsl_map_disjoint(const nsl_Map *map, const nsl_Map *other) {
+    if (other->len == 0 || map->len == 0) return true;
+
+    if (other->cap < map->cap) {
+        const nsl_Map *temp = map;
+        map = other;
+        other = temp;
+    }
+    for (usize i = 0; i < map->cap; i++) {
+        if (map->items[i].hash && map->items[i].hash != NSL_MAP_DELETED) {
+            if (nsl_map_has(other, map->items[i].hash)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+NSL_API void nsl_map_intersection(const nsl_Map *map, const nsl_Map *other, nsl_Map *out) {
+    if (other->cap < map->cap) {
         const nsl_Map *temp = map;
         map = other;
         other = temp;
     }
-    for (usize i = 0; i < map->cap; i++) {
-        if (map->items[i].hash && map->items[i].hash != NSL_MAP_DELETED) {
-            if (nsl_map_has(other, map->items[i].hash)) {
-                return false;
+
+    nsl_map_reserve(out, nsl_usize_min(map->len, other->len) * 2);
+    for (usize i = 0; i < map->cap; i++) {
+        if (map->items[i].hash && map->items[i].hash != NSL_MAP_DELETED) {
+            if (nsl_map_has(other, map->items[i].hash)) {
+                nsl_map_insert(out, map->items[i].hash, other->items[i].value);
+            }
+        }
+    }
+}
+
+NSL_API void nsl_map_difference(const nsl_Map *map, const nsl_Map *other, nsl_Map *out) {
+    nsl_map_reserve(out, map->len * 2);
+    for (usize i = 0; i < map->cap; i++) {
+        if (map->items[i].hash && map->items[i].hash != NSL_MAP_DELETED) {
+            if (!nsl_map_has(other, map->items[i].hash)) {
+                nsl_map_insert(out, map->items[i].hash, other->items[i].value);
+            }
+        }
+    }
+}
+
+NSL_API void nsl_map_union(const nsl_Map *map, const nsl_Map *other, nsl_Map *out) {
+    for (usize i = 0; i < map->cap; i++) {
+        if (map->items[i].hash && map->items[i].hash != NSL_MAP_DELETED) {
+            if (!nsl_map_has(other, map->items[i].hash)) {
+                nsl_map_insert(out, map->items[i].hash, other->items[i].value);
+            }
+        }
+    }
+
+    for (usize i = 0; i < other->cap; i++) {
+        if (other->items[i].hash && map->items[i].hash != NSL_MAP_DELETED) {
+            if (!nsl_map_has(map, other->items[i].hash)) {
+                nsl_map_insert(out, other->items[i].hash, other->items[i].value);
+            }
+        }
+    }
+}
+
+NSL_API void nsl_bitset_free(nsl_BitSet *set) {
+    nsl_arena_free_chunk(set->arena, set->words);
+}
+
+NSL_API void nsl_bitset_clear_all(nsl_BitSet *set) {
+    if (set->len) memset(set->words, 0, set->len * sizeof(u64));
+    set->len = 0;
+}
+
+// grows the set to 'len' words, the new words are zero
+static void _nsl_bitset_resize_words(nsl_BitSet *set, usize len) {
+    if (set->cap < len) {
+        const usize cap = nsl_usize_max(nsl_usize_next_pow2(len), 4);
+        set->words = nsl_arena_realloc_chunk(set->arena, set->words, cap * sizeof(u64));
+        memset(&set->words[set->cap], 0, (cap - set->cap) * sizeof(u64));
+        set->cap = cap;
+    }
+    if (set->len < len) set->len = len;
+}
+
+NSL_API void nsl_bitset_reserve(nsl_BitSet *set, usize bits) {
+    const usize cap = (bits + 63) / 64;
+    const usize len = set->len;
+    _nsl_bitset_resize_words(set, cap);
+    set->len = len;
+}
+
+NSL_API void nsl_bitset_set(nsl_BitSet *set, usize idx) {
+    if (set->len <= idx / 64) _nsl_bitset_resize_words(set, idx / 64 + 1);
+    set->words[idx / 64] |= 1ull << (idx % 64);
+}
+
+NSL_API void nsl_bitset_clear(nsl_BitSet *set, usize idx) {
+    if (set->len <= idx / 64) return;
+    set->words[idx / 64] &= ~(1ull << (idx % 64));
+}
+
+NSL_API bool nsl_bitset_test(const nsl_BitSet *set, usize idx) {
+    if (set->len <= idx / 64) return false;
+    return (set->words[idx / 64] >> (idx % 64)) & 1;
+}
+
+NSL_API usize nsl_bitset_count(const nsl_BitSet *set) {
+    return nsl_u64_count_ones_array(set->len, set->words);
+}
+
+NSL_API usize nsl_bitset_rank(const nsl_BitSet *set, usize idx) {
+    const usize word = nsl_usize_min(idx / 64, set->len);
+    usize rank = nsl_u64_count_ones_array(word, set->words);
+    if (word < set->len && idx % 64) {
+        rank += nsl_u64_count_ones(set->words[word] & (~0ull >> (64 - idx % 64)));
+    }
+    return rank;
+}
+
+NSL_API bool nsl_bitset_select(const nsl_BitSet *set, usize n, usize *out) {
+    for (usize i = 0; i < set->len; i++) {
+        u64 word = set->words[i];
+        const usize count = nsl_u64_count_ones(word);
+        if (n < count) {
+            for (; n; n--) word &= word - 1;
+            *out = i * 64 + nsl_u64_trailing_zeros(word);
+            return true;
+        }
+        n -= count;
+    }
+    return false;
+}
+
+NSL_API bool nsl_bitset_next(const nsl_BitSet *set, usize *idx) {
+    usize i = *idx / 64;
+    if (set->len <= i) return false;
+    u64 word = set->words[i] & (~0ull << (*idx % 64));
+    while (!word) {
+        if (++i == set->len) return false;
+        word = set->words[i];
+    }
+    *idx = i * 64 + nsl_u64_trailing_zeros(word);
+    return true;
+}
+
+NSL_API bool nsl_bitset_eq(const nsl_BitSet *set, const nsl_BitSet *other) {
+    if (other->len < set->len) {
+        const nsl_BitSet *temp = set;
+        set = other;
+        other = temp;
+    }
+    if (set->len && memcmp(set->words, other->words, set->len * sizeof(u64)) != 0) return false;
+    for (usize i = set->len; i < other->len; i++) {
+        if (other->words[i]) return false;
+    }
+    return true;
+}
+
+typedef enum {
+    _NSL_BITSET_AND,
+    _NSL_BITSET_ANDNOT,
+    _NSL_BITSET_OR,
+    _NSL_BITSET_XOR,
+} _nsl_BitSetOp;
+
+// words past the end of the shorter set count as zero
+static void _nsl_bitset_apply(
+    const nsl_BitSet *set, const nsl_BitSet *other, nsl_BitSet *out, _nsl_BitSetOp op
+) {
+    const usize common = nsl_usize_min(set->len, other->len);
+    const usize len = op == _NSL_BITSET_AND      ? common
+                    : op == _NSL_BITSET_ANDNOT ? set->len
+                                               : nsl_usize_max(set->len, other->len);
+    const usize out_len = out->len;
+    // the lengths change if 'out' is one of the inputs
+    const bool other_longer = set->len < other->len;
+    _nsl_bitset_resize_words(out, len);
+    // 'out' might be 'set' or 'other', so the words are loaded after the resize
+    const u64 *a = set->words;
+    const u64 *b = other->words;
+    u64 *o = out->words;
+
+    usize i = 0;
+#if defined(NSL_AVX2)
+    for (; i + 4 <= common; i += 4) {
+        const __m256i va = _mm256_loadu_si256((const __m256i *)(const void *)&a[i]);
+        const __m256i vb = _mm256_loadu_si256((const __m256i *)(const void *)&b[i]);
+        __m256i r;
+        switch (op) {
+        case _NSL_BITSET_AND: r = _mm256_and_si256(va, vb); break;
+        case _NSL_BITSET_ANDNOT: r = _mm256_andnot_si256(vb, va); break;
+        case _NSL_BITSET_OR: r = _mm256_or_si256(va, vb); break;
+        default: r = _mm256_xor_si256(va, vb); break;
+        }
+        _mm256_storeu_si256((__m256i *)(void *)&o[i], r);
+    }
+#endif
+#if defined(NSL_SSE2)
+    for (; i + 2 <= common; i += 2) {
+        const __m128i va = _mm_loadu_si128((const __m128i *)(const void *)&a[i]);
+        const __m128i vb = _mm_loadu_si128((const __m128i *)(const void *)&b[i]);
+        __m128i r;
+        switch (op) {
+        case _NSL_BITSET_AND: r = _mm_and_si128(va, vb); break;
+        case _NSL_BITSET_ANDNOT: r = _mm_andnot_si128(vb, va); break;
+        case _NSL_BITSET_OR: r = _mm_or_si128(va, vb); break;
+        default: r = _mm_xor_si128(va, vb); break;
+        }
+        _mm_storeu_si128((__m128i *)(void *)&o[i], r);
+    }
+#endif
+    for (; i < common; i++) {
+        switch (op) {
+        case _NSL_BITSET_AND: o[i] = a[i] & b[i]; break;
+        case _NSL_BITSET_ANDNOT: o[i] = a[i] & ~b[i]; break;
+        case _NSL_BITSET_OR: o[i] = a[i] | b[i]; break;
+        default: o[i] = a[i] ^ b[i]; break;
+        }
+    }
+
+    // the tail of the longer set
+    const u64 *rest = other_longer ? b : a;
+    if (len > common && rest != o) memcpy(&o[common], &rest[common], (len - common) * sizeof(u64));
+    // words from the previous content of 'out'
+    if (len < out_len) memset(&o[len], 0, (out_len - len) * sizeof(u64));
+    out->len = len;
+}
+
+NSL_API void nsl_bitset_intersection(const nsl_BitSet *set, const nsl_BitSet *other, nsl_BitSet *out) {
+    _nsl_bitset_apply(set, other, out, _NSL_BITSET_AND);
+}
+
+NSL_API void nsl_bitset_difference(const nsl_BitSet *set, const nsl_BitSet *other, nsl_BitSet *out) {
+    _nsl_bitset_apply(set, other, out, _NSL_BITSET_ANDNOT);
+}
+
+NSL_API void nsl_bitset_union(const nsl_BitSet *set, const nsl_BitSet *other, nsl_BitSet *out) {
+    _nsl_bitset_apply(set, other, out, _NSL_BITSET_OR);
+}
+
+NSL_API void nsl_bitset_symmetric_difference(const nsl_BitSet *set, const nsl_BitSet *other, nsl_BitSet *out) {
+    _nsl_bitset_apply(set, other, out, _NSL_BITSET_XOR);
+}
+
+#define _NSL_ROARING_ARRAY_MAX 4096
+#define _NSL_ROARING_WORDS     1024
+#define _NSL_ROARING_MAGIC     0x524c534e // "NSLR"
+
+typedef struct {
+    u16 start;
+    u16 length; // number of values - 1
+} _nsl_RoaringRun;
+
+static usize _nsl_roaring_find(const nsl_Roaring *r, u16 key) {
+    usize lo = 0, hi = r->len;
+    while (lo < hi) {
+        const usize mid = lo + (hi - lo) / 2;
+        if (r->items[mid].key < key) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static u32 _nsl_roaring_lower_bound(u32 len, const u16 *values, u32 value) {
+    u32 lo = 0, hi = len;
+    while (lo < hi) {
+        const u32 mid = lo + (hi - lo) / 2;
+        if (values[mid] < value) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static u32 _nsl_roaring_card(const nsl_RoaringContainer *c) {
+    if (c->kind != NSL_ROARING_RUN) return c->len;
+    const _nsl_RoaringRun *runs = c->data;
+    u32 card = 0;
+    for (u32 i = 0; i < c->len; i++) {
+        card += (u32)runs[i].length + 1;
+    }
+    return card;
+}
+
+static bool _nsl_roaring_container_has(const nsl_RoaringContainer *c, u16 value) {
+    if (c->kind == NSL_ROARING_ARRAY) {
+        const u16 *values = c->data;
+        const u32 i = _nsl_roaring_lower_bound(c->len, values, value);
+        return i < c->len && values[i] == value;
+    }
+    if (c->kind == NSL_ROARING_BITMAP) {
+        const u64 *words = c->data;
+        return (words[value / 64] >> (value % 64)) & 1;
+    }
+    // last run that starts before 'value'
+    const _nsl_RoaringRun *runs = c->data;
+    u32 lo = 0, hi = c->len;
+    while (lo < hi) {
+        const u32 mid = lo + (hi - lo) / 2;
+        if (runs[mid].start <= value) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo && value <= (u32)runs[lo - 1].start + runs[lo - 1].length;
+}
+
+static bool _nsl_roaring_container_next(const nsl_RoaringContainer *c, u32 low, u32 *out) {
+    if (0xffff < low) return false;
+    if (c->kind == NSL_ROARING_ARRAY) {
+        const u16 *values = c->data;
+        const u32 i = _nsl_roaring_lower_bound(c->len, values, low);
+        if (i == c->len) return false;
+        *out = values[i];
+        return true;
+    }
+    if (c->kind == NSL_ROARING_BITMAP) {
+        const u64 *words = c->data;
+        usize i = low / 64;
+        u64 word = words[i] & (~0ull << (low % 64));
+        while (!word) {
+            if (++i == _NSL_ROARING_WORDS) return false;
+            word = words[i];
+        }
+        *out = (u32)(i * 64 + nsl_u64_trailing_zeros(word));
+        return true;
+    }
+    // first run that ends at or after 'low'
+    const _nsl_RoaringRun *runs = c->data;
+    u32 lo = 0, hi = c->len;
+    while (lo < hi) {
+        const u32 mid = lo + (hi - lo) / 2;
+        if ((u32)runs[mid].start + runs[mid].length < low) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo == c->len) return false;
+    *out = nsl_u32_max(runs[lo].start, low);
+    return true;
+}
+
+static void _nsl_roaring_container_free(nsl_Arena *arena, nsl_RoaringContainer *c) {
+    if (c->cap) nsl_arena_free_chunk(arena, c->data);
+}
+
+static nsl_RoaringContainer _nsl_roaring_array_new(nsl_Arena *arena, u16 key, u32 cap) {
+    cap = nsl_u32_max(cap, 4);
+    return (nsl_RoaringContainer){
+        .key = key,
+        .kind = NSL_ROARING_ARRAY,
+        .cap = cap,
+        .data = nsl_arena_alloc_chunk(arena, cap * sizeof(u16)),
+    };
+}
+
+static nsl_RoaringContainer _nsl_roaring_bitmap_new(nsl_Arena *arena, u16 key) {
+    return (nsl_RoaringContainer){
+        .key = key,
+        .kind = NSL_ROARING_BITMAP,
+        .cap = _NSL_ROARING_WORDS,
+        .data = nsl_arena_calloc_chunk(arena, _NSL_ROARING_WORDS * sizeof(u64)),
+    };
+}
+
+static void _nsl_roaring_bitmap_set_range(u64 *words, u32 first, u32 last) {
+    for (u32 i = first / 64; i <= last / 64; i++) {
+        u64 mask = ~0ull;
+        if (i == first / 64) mask &= ~0ull << (first % 64);
+        if (i == last / 64) mask &= ~0ull >> (63 - last % 64);
+        words[i] |= mask;
+    }
+}
+
+static u32 _nsl_roaring_bitmap_extract(const u64 *words, u16 *out) {
+    u32 n = 0;
+    for (u32 i = 0; i < _NSL_ROARING_WORDS; i++) {
+        for (u64 word = words[i]; word; word &= word - 1) {
+            out[n++] = (u16)(i * 64 + nsl_u64_trailing_zeros(word));
+        }
+    }
+    return n;
+}
+
+static void _nsl_roaring_to_array(nsl_Arena *arena, nsl_RoaringContainer *c) {
+    nsl_RoaringContainer array = _nsl_roaring_array_new(arena, c->key, c->len);
+    array.len = _nsl_roaring_bitmap_extract(c->data, array.data);
+    _nsl_roaring_container_free(arena, c);
+    *c = array;
+}
+
+static void _nsl_roaring_to_bitmap(nsl_Arena *arena, nsl_RoaringContainer *c) {
+    nsl_RoaringContainer bitmap = _nsl_roaring_bitmap_new(arena, c->key);
+    u64 *words = bitmap.data;
+    const u16 *values = c->data;
+    for (u32 i = 0; i < c->len; i++) {
+        words[values[i] / 64] |= 1ull << (values[i] % 64);
+    }
+    bitmap.len = c->len;
+    _nsl_roaring_container_free(arena, c);
+    *c = bitmap;
+}
+
+// run containers are unpacked into an array or a bitmap
+static nsl_RoaringContainer _nsl_roaring_unpack(nsl_Arena *arena, const nsl_RoaringContainer *c) {
+    const _nsl_RoaringRun *runs = c->data;
+    const u32 card = _nsl_roaring_card(c);
+    if (card <= _NSL_ROARING_ARRAY_MAX) {
+        nsl_RoaringContainer array = _nsl_roaring_array_new(arena, c->key, card);
+        u16 *values = array.data;
+        for (u32 i = 0; i < c->len; i++) {
+            for (u32 v = runs[i].start; v <= (u32)runs[i].start + runs[i].length; v++) {
+                values[array.len++] = (u16)v;
             }
         }
+        return array;
+    }
+    nsl_RoaringContainer bitmap = _nsl_roaring_bitmap_new(arena, c->key);
+    for (u32 i = 0; i < c->len; i++) {
+        _nsl_roaring_bitmap_set_range(bitmap.data, runs[i].start, (u32)runs[i].start + runs[i].length);
+    }
+    bitmap.len = card;
+    return bitmap;
+}
+
+static nsl_RoaringContainer _nsl_roaring_container_copy(nsl_Arena *arena, const nsl_RoaringContainer *c) {
+    nsl_RoaringContainer copy = *c;
+    const usize size = c->kind == NSL_ROARING_ARRAY  ? c->len * sizeof(u16)
+                     : c->kind == NSL_ROARING_BITMAP ? _NSL_ROARING_WORDS * sizeof(u64)
+                                                     : c->len * sizeof(_nsl_RoaringRun);
+    copy.cap = c->kind == NSL_ROARING_BITMAP ? _NSL_ROARING_WORDS : c->len;
+    copy.data = nsl_arena_alloc_chunk(arena, size);
+    memcpy(copy.data, c->data, size);
+    return copy;
+}
+
+// owned array or bitmap
+static void _nsl_roaring_make_mutable(nsl_Arena *arena, nsl_RoaringContainer *c) {
+    if (c->kind == NSL_ROARING_RUN) {
+        nsl_RoaringContainer unpacked = _nsl_roaring_unpack(arena, c);
+        _nsl_roaring_container_free(arena, c);
+        *c = unpacked;
+    } else if (c->cap == 0) {
+        *c = _nsl_roaring_container_copy(arena, c);
     }
+}
+
+static bool _nsl_roaring_container_add(nsl_Arena *arena, nsl_RoaringContainer *c, u16 value) {
+    if (_nsl_roaring_container_has(c, value)) return false;
+    _nsl_roaring_make_mutable(arena, c);
+    if (c->kind == NSL_ROARING_ARRAY && c->len == _NSL_ROARING_ARRAY_MAX) {
+        _nsl_roaring_to_bitmap(arena, c);
+    }
+
+    if (c->kind == NSL_ROARING_BITMAP) {
+        u64 *words = c->data;
+        words[value / 64] |= 1ull << (value % 64);
+        c->len++;
+        return true;
+    }
+
+    if (c->len == c->cap) {
+        c->cap = nsl_u32_min(c->cap * 2, _NSL_ROARING_ARRAY_MAX);
+        c->data = nsl_arena_realloc_chunk(arena, c->data, c->cap * sizeof(u16));
+    }
+    u16 *values = c->data;
+    const u32 i = _nsl_roaring_lower_bound(c->len, values, value);
+    memmove(&values[i + 1], &values[i], (c->len - i) * sizeof(u16));
+    values[i] = value;
+    c->len++;
     return true;
 }
 
-NSL_API void nsl_map_intersection(const nsl_Map *map, const nsl_Map *other, nsl_Map *out) {
-    if (other->cap < map->cap) {
-        const nsl_Map *temp = map;
-        map = other;
-        other = temp;
+static bool _nsl_roaring_container_remove(nsl_Arena *arena, nsl_RoaringContainer *c, u16 value) {
+    if (!_nsl_roaring_container_has(c, value)) return false;
+    _nsl_roaring_make_mutable(arena, c);
+
+    if (c->kind == NSL_ROARING_BITMAP) {
+        u64 *words = c->data;
+        words[value / 64] &= ~(1ull << (value % 64));
+        if (--c->len <= _NSL_ROARING_ARRAY_MAX) _nsl_roaring_to_array(arena, c);
+        return true;
     }
 
-    nsl_map_reserve(out, nsl_usize_min(map->len, other->len) * 2);
-    for (usize i = 0; i < map->cap; i++) {
-        if (map->items[i].hash && map->items[i].hash != NSL_MAP_DELETED) {
-            if (nsl_map_has(other, map->items[i].hash)) {
-                nsl_map_insert(out, map->items[i].hash, other->items[i].value);
+    u16 *values = c->data;
+    const u32 i = _nsl_roaring_lower_bound(c->len, values, value);
+    memmove(&values[i], &values[i + 1], (c->len - i - 1) * sizeof(u16));
+    c->len--;
+    return true;
+}
+
+NSL_API void nsl_roaring_free(nsl_Roaring *r) {
+    nsl_roaring_clear(r);
+    nsl_list_free(r);
+}
+
+NSL_API void nsl_roaring_clear(nsl_Roaring *r) {
+    for (usize i = 0; i < r->len; i++) {
+        _nsl_roaring_container_free(r->arena, &r->items[i]);
+    }
+    r->len = 0;
+}
+
+NSL_API bool nsl_roaring_add(nsl_Roaring *r, u32 value) {
+    const u16 key = (u16)(value >> 16);
+    const usize i = _nsl_roaring_find(r, key);
+    if (i == r->len || r->items[i].key != key) {
+        nsl_list_insert(r, _nsl_roaring_array_new(r->arena, key, 0), i);
+    }
+    return _nsl_roaring_container_add(r->arena, &r->items[i], (u16)value);
+}
+
+NSL_API bool nsl_roaring_remove(nsl_Roaring *r, u32 value) {
+    const u16 key = (u16)(value >> 16);
+    const usize i = _nsl_roaring_find(r, key);
+    if (i == r->len || r->items[i].key != key) return false;
+    if (!_nsl_roaring_container_remove(r->arena, &r->items[i], (u16)value)) return false;
+    if (r->items[i].len == 0) {
+        _nsl_roaring_container_free(r->arena, &r->items[i]);
+        nsl_list_remove(r, i);
+    }
+    return true;
+}
+
+NSL_API bool nsl_roaring_has(const nsl_Roaring *r, u32 value) {
+    const u16 key = (u16)(value >> 16);
+    const usize i = _nsl_roaring_find(r, key);
+    if (i == r->len || r->items[i].key != key) return false;
+    return _nsl_roaring_container_has(&r->items[i], (u16)value);
+}
+
+NSL_API u64 nsl_roaring_count(const nsl_Roaring *r) {
+    u64 count = 0;
+    for (usize i = 0; i < r->len; i++) {
+        count += _nsl_roaring_card(&r->items[i]);
+    }
+    return count;
+}
+
+NSL_API bool nsl_roaring_next(const nsl_Roaring *r, u64 *value) {
+    if (UINT32_MAX < *value) return false;
+    const u16 key = (u16)(*value >> 16);
+    for (usize i = _nsl_roaring_find(r, key); i < r->len; i++) {
+        const u32 low = r->items[i].key == key ? (u32)(*value & 0xffff) : 0;
+        u32 next = 0;
+        if (_nsl_roaring_container_next(&r->items[i], low, &next)) {
+            *value = (u64)r->items[i].key << 16 | next;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void _nsl_roaring_run_push(_nsl_RoaringRun *runs, u32 *len, u32 value) {
+    if (*len && (u32)runs[*len - 1].start + runs[*len - 1].length + 1 == value) {
+        runs[*len - 1].length++;
+    } else {
+        runs[(*len)++] = (_nsl_RoaringRun){.start = (u16)value, .length = 0};
+    }
+}
+
+static u32 _nsl_roaring_count_runs(const nsl_RoaringContainer *c) {
+    u32 runs = 0;
+    if (c->kind == NSL_ROARING_ARRAY) {
+        const u16 *values = c->data;
+        for (u32 i = 0; i < c->len; i++) {
+            runs += i == 0 || values[i] != values[i - 1] + 1;
+        }
+    } else {
+        // a run starts at every set bit whose previous bit is not set
+        const u64 *words = c->data;
+        u64 carry = 0;
+        for (u32 i = 0; i < _NSL_ROARING_WORDS; i++) {
+            runs += (u32)nsl_u64_count_ones(words[i] & ~(words[i] << 1 | carry));
+            carry = words[i] >> 63;
+        }
+    }
+    return runs;
+}
+
+NSL_API void nsl_roaring_optimize(nsl_Roaring *r) {
+    for (usize i = 0; i < r->len; i++) {
+        nsl_RoaringContainer *c = &r->items[i];
+        if (c->kind == NSL_ROARING_RUN) continue;
+
+        const u32 count = _nsl_roaring_count_runs(c);
+        const usize size = c->kind == NSL_ROARING_ARRAY ? c->len * sizeof(u16) : _NSL_ROARING_WORDS * sizeof(u64);
+        if (size <= count * sizeof(_nsl_RoaringRun)) continue;
+
+        _nsl_RoaringRun *runs = nsl_arena_alloc_chunk(r->arena, count * sizeof(_nsl_RoaringRun));
+        u32 len = 0;
+        for (u32 value = 0; _nsl_roaring_container_next(c, value, &value); value++) {
+            _nsl_roaring_run_push(runs, &len, value);
+        }
+        _nsl_roaring_container_free(r->arena, c);
+        *c = (nsl_RoaringContainer){.key = c->key, .kind = NSL_ROARING_RUN, .len = len, .cap = len, .data = runs};
+    }
+}
+
+static nsl_RoaringContainer _nsl_roaring_and(
+    nsl_Arena *arena, const nsl_RoaringContainer *a, const nsl_RoaringContainer *b
+) {
+    if (a->kind == NSL_ROARING_BITMAP && b->kind == NSL_ROARING_BITMAP) {
+        nsl_RoaringContainer out = _nsl_roaring_bitmap_new(arena, a->key);
+        u64 *words = out.data;
+        const u64 *wa = a->data, *wb = b->data;
+        for (usize i = 0; i < _NSL_ROARING_WORDS; i++) {
+            words[i] = wa[i] & wb[i];
+        }
+        out.len = (u32)nsl_u64_count_ones_array(_NSL_ROARING_WORDS, words);
+        if (out.len <= _NSL_ROARING_ARRAY_MAX) _nsl_roaring_to_array(arena, &out);
+        return out;
+    }
+
+    if (a->kind == NSL_ROARING_BITMAP) {
+        const nsl_RoaringContainer *temp = a;
+        a = b;
+        b = temp;
+    }
+    nsl_RoaringContainer out = _nsl_roaring_array_new(arena, a->key, a->len);
+    const u16 *va = a->data;
+    u16 *values = out.data;
+    if (b->kind == NSL_ROARING_BITMAP) {
+        const u64 *words = b->data;
+        for (u32 i = 0; i < a->len; i++) {
+            values[out.len] = va[i];
+            out.len += (words[va[i] / 64] >> (va[i] % 64)) & 1;
+        }
+        return out;
+    }
+
+    const u16 *vb = b->data;
+    for (u32 i = 0, j = 0; i < a->len && j < b->len;) {
+        if (va[i] < vb[j]) i++;
+        else if (vb[j] < va[i]) j++;
+        else {
+            values[out.len++] = va[i];
+            i++, j++;
+        }
+    }
+    return out;
+}
+
+static nsl_RoaringContainer _nsl_roaring_or(
+    nsl_Arena *arena, const nsl_RoaringContainer *a, const nsl_RoaringContainer *b
+) {
+    if (a->kind == NSL_ROARING_ARRAY && b->kind == NSL_ROARING_ARRAY &&
+        a->len + b->len <= _NSL_ROARING_ARRAY_MAX) {
+        nsl_RoaringContainer out = _nsl_roaring_array_new(arena, a->key, a->len + b->len);
+        const u16 *va = a->data, *vb = b->data;
+        u16 *values = out.data;
+        u32 i = 0, j = 0;
+        while (i < a->len && j < b->len) {
+            const u16 v = va[i] < vb[j] ? va[i] : vb[j];
+            i += va[i] == v;
+            j += vb[j] == v;
+            values[out.len++] = v;
+        }
+        while (i < a->len) values[out.len++] = va[i++];
+        while (j < b->len) values[out.len++] = vb[j++];
+        return out;
+    }
+
+    nsl_RoaringContainer out = _nsl_roaring_bitmap_new(arena, a->key);
+    u64 *words = out.data;
+    const nsl_RoaringContainer *inputs[2] = {a, b};
+    for (usize n = 0; n < 2; n++) {
+        if (inputs[n]->kind == NSL_ROARING_BITMAP) {
+            const u64 *w = inputs[n]->data;
+            for (usize i = 0; i < _NSL_ROARING_WORDS; i++) {
+                words[i] |= w[i];
+            }
+        } else {
+            const u16 *values = inputs[n]->data;
+            for (u32 i = 0; i < inputs[n]->len; i++) {
+                words[values[i] / 64] |= 1ull << (values[i] % 64);
+            }
+        }
+    }
+    out.len = (u32)nsl_u64_count_ones_array(_NSL_ROARING_WORDS, words);
+    if (out.len <= _NSL_ROARING_ARRAY_MAX) _nsl_roaring_to_array(arena, &out);
+    return out;
+}
+
+typedef nsl_RoaringContainer (*_nsl_RoaringOp)(nsl_Arena *, const nsl_RoaringContainer *, const nsl_RoaringContainer *);
+
+// run containers are unpacked into temporaries before 'op' is applied
+static nsl_RoaringContainer _nsl_roaring_apply(
+    nsl_Arena *arena, const nsl_RoaringContainer *a, const nsl_RoaringContainer *b, _nsl_RoaringOp op
+) {
+    nsl_RoaringContainer ta = a->kind == NSL_ROARING_RUN ? _nsl_roaring_unpack(NULL, a) : *a;
+    nsl_RoaringContainer tb = b->kind == NSL_ROARING_RUN ? _nsl_roaring_unpack(NULL, b) : *b;
+    nsl_RoaringContainer out = op(arena, &ta, &tb);
+    if (a->kind == NSL_ROARING_RUN) _nsl_roaring_container_free(NULL, &ta);
+    if (b->kind == NSL_ROARING_RUN) _nsl_roaring_container_free(NULL, &tb);
+    return out;
+}
+
+NSL_API void nsl_roaring_intersection(const nsl_Roaring *r, const nsl_Roaring *other, nsl_Roaring *out) {
+    nsl_roaring_clear(out);
+    for (usize i = 0, j = 0; i < r->len && j < other->len;) {
+        if (r->items[i].key < other->items[j].key) i++;
+        else if (other->items[j].key < r->items[i].key) j++;
+        else {
+            nsl_RoaringContainer c = _nsl_roaring_apply(out->arena, &r->items[i], &other->items[j], _nsl_roaring_and);
+            if (c.len) nsl_list_push(out, c);
+            else _nsl_roaring_container_free(out->arena, &c);
+            i++, j++;
+        }
+    }
+}
+
+NSL_API void nsl_roaring_union(const nsl_Roaring *r, const nsl_Roaring *other, nsl_Roaring *out) {
+    nsl_roaring_clear(out);
+    nsl_list_reserve(out, r->len + other->len);
+    usize i = 0, j = 0;
+    while (i < r->len && j < other->len) {
+        if (r->items[i].key < other->items[j].key) {
+            nsl_list_push(out, _nsl_roaring_container_copy(out->arena, &r->items[i++]));
+        } else if (other->items[j].key < r->items[i].key) {
+            nsl_list_push(out, _nsl_roaring_container_copy(out->arena, &other->items[j++]));
+        } else {
+            nsl_list_push(out, _nsl_roaring_apply(out->arena, &r->items[i++], &other->items[j++], _nsl_roaring_or));
+        }
+    }
+    for (; i < r->len; i++) nsl_list_push(out, _nsl_roaring_container_copy(out->arena, &r->items[i]));
+    for (; j < other->len; j++) nsl_list_push(out, _nsl_roaring_container_copy(out->arena, &other->items[j]));
+}
+
+static usize _nsl_roaring_data_size(u16 kind, u32 len) {
+    if (kind == NSL_ROARING_ARRAY) return len * sizeof(u16);
+    if (kind == NSL_ROARING_BITMAP) return _NSL_ROARING_WORDS * sizeof(u64);
+    return len * sizeof(_nsl_RoaringRun);
+}
+
+#define _nsl_roaring_align8(n) (((n) + 7) & ~(usize)7)
+
+NSL_API nsl_Bytes nsl_roaring_serialize(const nsl_Roaring *r, nsl_ByteBuffer *bb) {
+    const usize start = bb->len;
+    nsl_u32_to_le_bytes(_NSL_ROARING_MAGIC, bb);
+    nsl_u32_to_le_bytes((u32)r->len, bb);
+
+    usize offset = _nsl_roaring_align8(8 + 12 * r->len);
+    for (usize i = 0; i < r->len; i++) {
+        const nsl_RoaringContainer *c = &r->items[i];
+        NSL_ASSERT(offset <= UINT32_MAX && "serialized roaring bitmap is too big");
+        nsl_u16_to_le_bytes(c->key, bb);
+        nsl_u16_to_le_bytes(c->kind, bb);
+        nsl_u32_to_le_bytes(c->len, bb);
+        nsl_u32_to_le_bytes((u32)offset, bb);
+        offset += _nsl_roaring_align8(_nsl_roaring_data_size(c->kind, c->len));
+    }
+
+    const u8 padding[8] = {0};
+    nsl_bb_push_bytes(bb, _nsl_roaring_align8(bb->len - start) - (bb->len - start), padding);
+    for (usize i = 0; i < r->len; i++) {
+        const nsl_RoaringContainer *c = &r->items[i];
+        if (c->kind == NSL_ROARING_BITMAP) {
+            nsl_bb_push_u64_le_array(bb, _NSL_ROARING_WORDS, c->data);
+        } else {
+            // runs are pairs of u16
+            nsl_bb_push_u16_le_array(bb, _nsl_roaring_data_size(c->kind, c->len) / sizeof(u16), c->data);
+        }
+        nsl_bb_push_bytes(bb, _nsl_roaring_align8(bb->len - start) - (bb->len - start), padding);
+    }
+    return nsl_bytes_from_parts(bb->len - start, &bb->items[start]);
+}
+
+// The other functions rely on sorted values and runs, and on 'len' matching the content.
+static bool _nsl_roaring_valid(const nsl_RoaringContainer *c) {
+    if (c->kind == NSL_ROARING_ARRAY) {
+        const u16 *values = c->data;
+        for (u32 i = 1; i < c->len; i++) {
+            if (values[i] <= values[i - 1]) return false;
+        }
+        return true;
+    }
+    if (c->kind == NSL_ROARING_BITMAP) {
+        return nsl_u64_count_ones_array(_NSL_ROARING_WORDS, c->data) == c->len;
+    }
+    const _nsl_RoaringRun *runs = c->data;
+    for (u32 i = 0; i < c->len; i++) {
+        if ((u32)runs[i].start + runs[i].length > UINT16_MAX) return false;
+        if (i && runs[i].start <= (u32)runs[i - 1].start + runs[i - 1].length) return false;
+    }
+    return true;
+}
+
+NSL_API nsl_Error nsl_roaring_from_bytes(nsl_Bytes bytes, nsl_Roaring *out) {
+    nsl_roaring_clear(out);
+    if (bytes.size < 8) return NSL_ERROR_PARSE;
+    if (nsl_u32_from_le_bytes(nsl_bytes_slice(bytes, 0, 4)) != _NSL_ROARING_MAGIC) return NSL_ERROR_PARSE;
+    const u32 count = nsl_u32_from_le_bytes(nsl_bytes_slice(bytes, 4, 8));
+    if ((bytes.size - 8) / 12 < count) return NSL_ERROR_PARSE;
+
+    nsl_list_reserve(out, count);
+    for (u32 i = 0; i < count; i++) {
+        const usize at = 8 + (usize)i * 12;
+        const nsl_Bytes header = nsl_bytes_slice(bytes, at, at + 12);
+        nsl_RoaringContainer c = {
+            .key = nsl_u16_from_le_bytes(nsl_bytes_slice(header, 0, 2)),
+            .kind = nsl_u16_from_le_bytes(nsl_bytes_slice(header, 2, 4)),
+            .len = nsl_u32_from_le_bytes(nsl_bytes_slice(header, 4, 8)),
+        };
+        const usize offset = nsl_u32_from_le_bytes(nsl_bytes_slice(header, 8, 12));
+
+        const u32 max_len = c.kind == NSL_ROARING_ARRAY ? _NSL_ROARING_ARRAY_MAX
+                          : c.kind == NSL_ROARING_BITMAP ? 1 << 16
+                                                         : 1 << 15;
+        const bool sorted = i == 0 || out->items[i - 1].key < c.key;
+        if (NSL_ROARING_RUN < c.kind || c.len == 0 || max_len < c.len || !sorted) goto error;
+        const usize size = _nsl_roaring_data_size(c.kind, c.len);
+        if (bytes.size < offset || bytes.size - offset < size) goto error;
+
+        const u8 *data = &bytes.data[offset];
+        const usize align = c.kind == NSL_ROARING_BITMAP ? sizeof(u64) : sizeof(u16);
+        if (NSL_BYTE_ORDER == NSL_ENDIAN_LITTLE && (usize)data % align == 0) {
+            c.data = (void *)data;
+        } else {
+            c.cap = c.kind == NSL_ROARING_BITMAP ? _NSL_ROARING_WORDS : c.len;
+            c.data = nsl_arena_alloc_chunk(out->arena, size);
+            const nsl_Bytes src = nsl_bytes_from_parts(size, data);
+            if (c.kind == NSL_ROARING_BITMAP) nsl_bytes_read_u64_le_array(src, _NSL_ROARING_WORDS, c.data);
+            else nsl_bytes_read_u16_le_array(src, size / sizeof(u16), c.data);
+        }
+        if (!_nsl_roaring_valid(&c)) {
+            if (c.cap) nsl_arena_free_chunk(out->arena, c.data);
+            goto error;
+        }
+        out->items[out->len++] = c;
+    }
+    return NSL_NO_ERROR;
+
+error:
+    nsl_roaring_clear(out);
+    return NSL_ERROR_PARSE;
+}
+
+NSL_API nsl_Bytes nsl_bytes_from_parts(usize size, const void *data) {
+    return (nsl_Bytes){.size = size, .data = data};
+}
+
+NSL_API nsl_Bytes nsl_bytes_copy(nsl_Bytes bytes, nsl_Arena *arena) {
+    u8 *buffer = nsl_arena_alloc(arena, bytes.size);
+    memcpy(buffer, bytes.data, bytes.size);
+    return nsl_bytes_from_parts(bytes.size, buffer);
+}
+
+NSL_API nsl_Bytes nsl_bytes_slice(nsl_Bytes bytes, usize idx1, usize idx2) {
+    if (idx2 <= idx1 || bytes.size <= idx1 || bytes.size < idx2) {
+        return nsl_bytes_from_parts(0, bytes.data);
+    }
+    return nsl_bytes_from_parts(idx2 - idx1, &bytes.data[idx1]);
+}
+
+NSL_API nsl_Bytes nsl_bytes_take(nsl_Bytes *bytes, usize count) {
+    count = nsl_usize_min(bytes->size, count);
+    nsl_Bytes ret = nsl_bytes_from_parts(count, bytes->data);
+    bytes->size -= count;
+    bytes->data += count;
+    return ret;
+}
+
+NSL_API bool nsl_bytes_eq(nsl_Bytes b1, nsl_Bytes b2) {
+    if (b1.size != b2.size) return false;
+    return memcmp(b1.data, b2.data, b1.size) == 0;
+}
+
+// https://github.com/wangyi-fudan/wyhash for the short inputs and the final mixing,
+// the 32 byte stripes accumulate like xxh3 so they map onto 32x32->64 SIMD multiplies.
+#define NSL_HASH_STRIPE 32
+// scramble the accumulators every 8 stripes (256 bytes)
+#define NSL_HASH_SCRAMBLE 8
+
+static const u64 _nsl_hash_secret[4] = {
+    0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull,
+};
+
+static u64 _nsl_read_u64(const u8 *p) {
+    u64 v;
+    memcpy(&v, p, sizeof(v));
+    return nsl_u64_from_le(v);
+}
+
+static u64 _nsl_read_u32(const u8 *p) {
+    u32 v;
+    memcpy(&v, p, sizeof(v));
+    return nsl_u32_from_le(v);
+}
+
+static void _nsl_hash_mum(u64 *a, u64 *b) {
+#if defined(__SIZEOF_INT128__)
+    __extension__ unsigned __int128 r = (unsigned __int128)*a * *b;
+    *a = (u64)r;
+    *b = (u64)(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    *a = _umul128(*a, *b, b);
+#else
+    const u64 ha = *a >> 32, hb = *b >> 32, la = (u32)*a, lb = (u32)*b;
+    const u64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    const u64 t = rl + (rm0 << 32);
+    const u64 c = t < rl;
+    const u64 lo = t + (rm1 << 32);
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c + (lo < t);
+#endif
+}
+
+static u64 _nsl_hash_mix(u64 a, u64 b) {
+    _nsl_hash_mum(&a, &b);
+    return a ^ b;
+}
+
+// 'index' is the number of stripes that were already processed
+static void _nsl_hash_stripes(u64 acc[4], const u8 *p, usize count, u64 index, u64 seed) {
+#if defined(NSL_AVX2)
+    const __m256i key = _mm256_xor_si256(
+        _mm256_loadu_si256((const __m256i *)(const void *)_nsl_hash_secret),
+        _mm256_set1_epi64x((long long)seed)
+    );
+    const __m256i prime = _mm256_set1_epi64x(0x9E3779B1);
+    __m256i a = _mm256_loadu_si256((const __m256i *)(void *)acc);
+    for (usize s = 0; s < count; s++, p += NSL_HASH_STRIPE) {
+        const __m256i d = _mm256_loadu_si256((const __m256i *)(const void *)p);
+        const __m256i k = _mm256_xor_si256(d, key);
+        const __m256i m = _mm256_mul_epu32(k, _mm256_srli_epi64(k, 32));
+        a = _mm256_add_epi64(a, _mm256_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2)));
+        a = _mm256_add_epi64(a, m);
+        if ((index + s + 1) % NSL_HASH_SCRAMBLE == 0) {
+            a = _mm256_xor_si256(a, _mm256_srli_epi64(a, 47));
+            a = _mm256_xor_si256(a, key);
+            const __m256i lo = _mm256_mul_epu32(a, prime);
+            const __m256i hi = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), prime);
+            a = _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32));
+        }
+    }
+    _mm256_storeu_si256((__m256i *)(void *)acc, a);
+#elif defined(NSL_SSE2) && NSL_BYTE_ORDER == NSL_ENDIAN_LITTLE
+    const __m128i s = _mm_set1_epi64x((long long)seed);
+    const __m128i key[2] = {
+        _mm_xor_si128(_mm_loadu_si128((const __m128i *)(const void *)&_nsl_hash_secret[0]), s),
+        _mm_xor_si128(_mm_loadu_si128((const __m128i *)(const void *)&_nsl_hash_secret[2]), s),
+    };
+    const __m128i prime = _mm_set1_epi64x(0x9E3779B1);
+    __m128i a[2] = {
+        _mm_loadu_si128((const __m128i *)(void *)&acc[0]),
+        _mm_loadu_si128((const __m128i *)(void *)&acc[2]),
+    };
+    for (usize n = 0; n < count; n++, p += NSL_HASH_STRIPE) {
+        for (usize i = 0; i < 2; i++) {
+            const __m128i d = _mm_loadu_si128((const __m128i *)(const void *)&p[i * 16]);
+            const __m128i k = _mm_xor_si128(d, key[i]);
+            const __m128i m = _mm_mul_epu32(k, _mm_srli_epi64(k, 32));
+            a[i] = _mm_add_epi64(a[i], _mm_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2)));
+            a[i] = _mm_add_epi64(a[i], m);
+        }
+        if ((index + n + 1) % NSL_HASH_SCRAMBLE == 0) {
+            for (usize i = 0; i < 2; i++) {
+                a[i] = _mm_xor_si128(a[i], _mm_srli_epi64(a[i], 47));
+                a[i] = _mm_xor_si128(a[i], key[i]);
+                const __m128i lo = _mm_mul_epu32(a[i], prime);
+                const __m128i hi = _mm_mul_epu32(_mm_srli_epi64(a[i], 32), prime);
+                a[i] = _mm_add_epi64(lo, _mm_slli_epi64(hi, 32));
+            }
+        }
+    }
+    _mm_storeu_si128((__m128i *)(void *)&acc[0], a[0]);
+    _mm_storeu_si128((__m128i *)(void *)&acc[2], a[1]);
+#else
+    for (usize n = 0; n < count; n++, p += NSL_HASH_STRIPE) {
+        for (usize i = 0; i < 4; i++) {
+            const u64 d = _nsl_read_u64(&p[i * 8]);
+            const u64 k = d ^ _nsl_hash_secret[i] ^ seed;
+            acc[i ^ 1] += d;
+            acc[i] += (k & 0xffffffff) * (k >> 32);
+        }
+        if ((index + n + 1) % NSL_HASH_SCRAMBLE == 0) {
+            for (usize i = 0; i < 4; i++) {
+                acc[i] ^= acc[i] >> 47;
+                acc[i] ^= _nsl_hash_secret[i] ^ seed;
+                acc[i] *= 0x9E3779B1;
             }
         }
     }
+#endif
+}
+
+// 'rem' is smaller than 'NSL_HASH_STRIPE'
+static u64 _nsl_hash_finish(const u64 acc[4], u64 seed, u64 len, const u8 *p, usize rem) {
+    const u64 *s = _nsl_hash_secret;
+    u64 h = seed ^ _nsl_hash_mix(seed ^ s[0], s[1]);
+    if (len >= NSL_HASH_STRIPE) {
+        for (usize i = 0; i < 4; i++) {
+            h = _nsl_hash_mix(acc[i] ^ s[i], h ^ s[(i + 1) & 3]);
+        }
+    }
+    while (rem > 16) {
+        h = _nsl_hash_mix(_nsl_read_u64(p) ^ s[1], _nsl_read_u64(&p[8]) ^ h);
+        p += 16;
+        rem -= 16;
+    }
+
+    u64 a = 0, b = 0;
+    if (rem >= 4) {
+        const usize off = (rem >> 3) << 2;
+        a = (_nsl_read_u32(p) << 32) | _nsl_read_u32(&p[off]);
+        b = (_nsl_read_u32(&p[rem - 4]) << 32) | _nsl_read_u32(&p[rem - 4 - off]);
+    } else if (rem > 0) {
+        a = ((u64)p[0] << 16) | ((u64)p[rem >> 1] << 8) | p[rem - 1];
+    }
+    a ^= s[1];
+    b ^= h;
+    _nsl_hash_mum(&a, &b);
+    return _nsl_hash_mix(a ^ s[0] ^ len, b ^ s[1]);
+}
+
+NSL_API u64 nsl_bytes_hash(nsl_Bytes bytes) {
+    return nsl_bytes_hash_seed(bytes, 0);
+}
+
+NSL_API u64 nsl_bytes_hash_seed(nsl_Bytes bytes, u64 seed) {
+    u64 acc[4] = {0};
+    const usize count = bytes.size / NSL_HASH_STRIPE;
+    _nsl_hash_stripes(acc, bytes.data, count, 0, seed);
+    const usize done = count * NSL_HASH_STRIPE;
+    return _nsl_hash_finish(acc, seed, bytes.size, &bytes.data[done], bytes.size - done);
+}
+
+NSL_API void nsl_hasher_update(nsl_Hasher *hasher, nsl_Bytes bytes) {
+    if (bytes.size == 0) return;
+    hasher->len += bytes.size;
+
+    if (hasher->buffered) {
+        const usize fill = nsl_usize_min(NSL_HASH_STRIPE - hasher->buffered, bytes.size);
+        memcpy(&hasher->buffer[hasher->buffered], bytes.data, fill);
+        hasher->buffered += fill;
+        bytes.data += fill;
+        bytes.size -= fill;
+        if (hasher->buffered < NSL_HASH_STRIPE) return;
+        const u64 index = (hasher->len - bytes.size) / NSL_HASH_STRIPE - 1;
+        _nsl_hash_stripes(hasher->acc, hasher->buffer, 1, index, hasher->seed);
+        hasher->buffered = 0;
+    }
+
+    const usize count = bytes.size / NSL_HASH_STRIPE;
+    const u64 index = (hasher->len - bytes.size) / NSL_HASH_STRIPE;
+    _nsl_hash_stripes(hasher->acc, bytes.data, count, index, hasher->seed);
+
+    const usize done = count * NSL_HASH_STRIPE;
+    memcpy(hasher->buffer, &bytes.data[done], bytes.size - done);
+    hasher->buffered = bytes.size - done;
+}
+
+NSL_API u64 nsl_hasher_finish(const nsl_Hasher *hasher) {
+    return _nsl_hash_finish(
+        hasher->acc, hasher->seed, hasher->len, hasher->buffer, hasher->buffered
+    );
+}
+
+static const u32 _nsl_crc32c_table[256] = {
+    0x00000000, 0xf26b8303, 0xe13b70f7, 0x1350f3f4, 0xc79a971f, 0x35f1141c, 0x26a1e7e8, 0xd4ca64eb,
+    0x8ad958cf, 0x78b2dbcc, 0x6be22838, 0x9989ab3b, 0x4d43cfd0, 0xbf284cd3, 0xac78bf27, 0x5e133c24,
+    0x105ec76f, 0xe235446c, 0xf165b798, 0x030e349b, 0xd7c45070, 0x25afd373, 0x36ff2087, 0xc494a384,
+    0x9a879fa0, 0x68ec1ca3, 0x7bbcef57, 0x89d76c54, 0x5d1d08bf, 0xaf768bbc, 0xbc267848, 0x4e4dfb4b,
+    0x20bd8ede, 0xd2d60ddd, 0xc186fe29, 0x33ed7d2a, 0xe72719c1, 0x154c9ac2, 0x061c6936, 0xf477ea35,
+    0xaa64d611, 0x580f5512, 0x4b5fa6e6, 0xb93425e5, 0x6dfe410e, 0x9f95c20d, 0x8cc531f9, 0x7eaeb2fa,
+    0x30e349b1, 0xc288cab2, 0xd1d83946, 0x23b3ba45, 0xf779deae, 0x05125dad, 0x1642ae59, 0xe4292d5a,
+    0xba3a117e, 0x4851927d, 0x5b016189, 0xa96ae28a, 0x7da08661, 0x8fcb0562, 0x9c9bf696, 0x6ef07595,
+    0x417b1dbc, 0xb3109ebf, 0xa0406d4b, 0x522bee48, 0x86e18aa3, 0x748a09a0, 0x67dafa54, 0x95b17957,
+    0xcba24573, 0x39c9c670, 0x2a993584, 0xd8f2b687, 0x0c38d26c, 0xfe53516f, 0xed03a29b, 0x1f682198,
+    0x5125dad3, 0xa34e59d0, 0xb01eaa24, 0x42752927, 0x96bf4dcc, 0x64d4cecf, 0x77843d3b, 0x85efbe38,
+    0xdbfc821c, 0x2997011f, 0x3ac7f2eb, 0xc8ac71e8, 0x1c661503, 0xee0d9600, 0xfd5d65f4, 0x0f36e6f7,
+    0x61c69362, 0x93ad1061, 0x80fde395, 0x72966096, 0xa65c047d, 0x5437877e, 0x4767748a, 0xb50cf789,
+    0xeb1fcbad, 0x197448ae, 0x0a24bb5a, 0xf84f3859, 0x2c855cb2, 0xdeeedfb1, 0xcdbe2c45, 0x3fd5af46,
+    0x7198540d, 0x83f3d70e, 0x90a324fa, 0x62c8a7f9, 0xb602c312, 0x44694011, 0x5739b3e5, 0xa55230e6,
+    0xfb410cc2, 0x092a8fc1, 0x1a7a7c35, 0xe811ff36, 0x3cdb9bdd, 0xceb018de, 0xdde0eb2a, 0x2f8b6829,
+    0x82f63b78, 0x709db87b, 0x63cd4b8f, 0x91a6c88c, 0x456cac67, 0xb7072f64, 0xa457dc90, 0x563c5f93,
+    0x082f63b7, 0xfa44e0b4, 0xe9141340, 0x1b7f9043, 0xcfb5f4a8, 0x3dde77ab, 0x2e8e845f, 0xdce5075c,
+    0x92a8fc17, 0x60c37f14, 0x73938ce0, 0x81f80fe3, 0x55326b08, 0xa759e80b, 0xb4091bff, 0x466298fc,
+    0x1871a4d8, 0xea1a27db, 0xf94ad42f, 0x0b21572c, 0xdfeb33c7, 0x2d80b0c4, 0x3ed04330, 0xccbbc033,
+    0xa24bb5a6, 0x502036a5, 0x4370c551, 0xb11b4652, 0x65d122b9, 0x97baa1ba, 0x84ea524e, 0x7681d14d,
+    0x2892ed69, 0xdaf96e6a, 0xc9a99d9e, 0x3bc21e9d, 0xef087a76, 0x1d63f975, 0x0e330a81, 0xfc588982,
+    0xb21572c9, 0x407ef1ca, 0x532e023e, 0xa145813d, 0x758fe5d6, 0x87e466d5, 0x94b49521, 0x66df1622,
+    0x38cc2a06, 0xcaa7a905, 0xd9f75af1, 0x2b9cd9f2, 0xff56bd19, 0x0d3d3e1a, 0x1e6dcdee, 0xec064eed,
+    0xc38d26c4, 0x31e6a5c7, 0x22b65633, 0xd0ddd530, 0x0417b1db, 0xf67c32d8, 0xe52cc12c, 0x1747422f,
+    0x49547e0b, 0xbb3ffd08, 0xa86f0efc, 0x5a048dff, 0x8ecee914, 0x7ca56a17, 0x6ff599e3, 0x9d9e1ae0,
+    0xd3d3e1ab, 0x21b862a8, 0x32e8915c, 0xc083125f, 0x144976b4, 0xe622f5b7, 0xf5720643, 0x07198540,
+    0x590ab964, 0xab613a67, 0xb831c993, 0x4a5a4a90, 0x9e902e7b, 0x6cfbad78, 0x7fab5e8c, 0x8dc0dd8f,
+    0xe330a81a, 0x115b2b19, 0x020bd8ed, 0xf0605bee, 0x24aa3f05, 0xd6c1bc06, 0xc5914ff2, 0x37faccf1,
+    0x69e9f0d5, 0x9b8273d6, 0x88d28022, 0x7ab90321, 0xae7367ca, 0x5c18e4c9, 0x4f48173d, 0xbd23943e,
+    0xf36e6f75, 0x0105ec76, 0x12551f82, 0xe03e9c81, 0x34f4f86a, 0xc69f7b69, 0xd5cf889d, 0x27a40b9e,
+    0x79b737ba, 0x8bdcb4b9, 0x988c474d, 0x6ae7c44e, 0xbe2da0a5, 0x4c4623a6, 0x5f16d052, 0xad7d5351,
+};
+
+// 'crc' is the inverted running value
+static u32 _nsl_crc32c(u32 crc, usize size, const u8 *p) {
+#if defined(NSL_SSE42)
+    for (; size && (usize)p % 8; size--) crc = _mm_crc32_u8(crc, *p++);
+#if defined(__x86_64__) || defined(_M_X64)
+    u64 crc64 = crc;
+    for (; 8 <= size; size -= 8, p += 8) crc64 = _mm_crc32_u64(crc64, _nsl_read_u64(p));
+    crc = (u32)crc64;
+#endif
+    for (; 4 <= size; size -= 4, p += 4) crc = _mm_crc32_u32(crc, (u32)_nsl_read_u32(p));
+    for (; size; size--) crc = _mm_crc32_u8(crc, *p++);
+#else
+    for (; size; size--) crc = (crc >> 8) ^ _nsl_crc32c_table[(crc ^ *p++) & 0xff];
+#endif
+    return crc;
+}
+
+NSL_API u32 nsl_bytes_crc32c(nsl_Bytes bytes) {
+    return ~_nsl_crc32c(~0u, bytes.size, bytes.data);
+}
+
+NSL_API void nsl_crc32c_update(nsl_Crc32c *crc, nsl_Bytes bytes) {
+    crc->crc = ~_nsl_crc32c(~crc->crc, bytes.size, bytes.data);
+}
+
+NSL_API u32 nsl_crc32c_finish(const nsl_Crc32c *crc) {
+    return crc->crc;
+}
+
+#define _NSL_XXH_P1 0x9E3779B185EBCA87ull
+#define _NSL_XXH_P2 0xC2B2AE3D27D4EB4Full
+#define _NSL_XXH_P3 0x165667B19E3779F9ull
+#define _NSL_XXH_P4 0x85EBCA77C2B2AE63ull
+#define _NSL_XXH_P5 0x27D4EB2F165667C5ull
+
+static u64 _nsl_rotl64(u64 x, u32 r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static u64 _nsl_xxh64_round(u64 acc, u64 input) {
+    acc += input * _NSL_XXH_P2;
+    return _nsl_rotl64(acc, 31) * _NSL_XXH_P1;
+}
+
+static void _nsl_xxh64_init(u64 acc[4], u64 seed) {
+    acc[0] = seed + _NSL_XXH_P1 + _NSL_XXH_P2;
+    acc[1] = seed + _NSL_XXH_P2;
+    acc[2] = seed;
+    acc[3] = seed - _NSL_XXH_P1;
+}
+
+static void _nsl_xxh64_stripes(u64 acc[4], const u8 *p, usize count) {
+    u64 a0 = acc[0], a1 = acc[1], a2 = acc[2], a3 = acc[3];
+    for (usize i = 0; i < count; i++, p += 32) {
+        a0 = _nsl_xxh64_round(a0, _nsl_read_u64(p));
+        a1 = _nsl_xxh64_round(a1, _nsl_read_u64(p + 8));
+        a2 = _nsl_xxh64_round(a2, _nsl_read_u64(p + 16));
+        a3 = _nsl_xxh64_round(a3, _nsl_read_u64(p + 24));
+    }
+    acc[0] = a0, acc[1] = a1, acc[2] = a2, acc[3] = a3;
+}
+
+static u64 _nsl_xxh64_finish(const u64 acc[4], u64 seed, u64 len, const u8 *p, usize rest) {
+    u64 h = seed + _NSL_XXH_P5;
+    if (32 <= len) {
+        h = _nsl_rotl64(acc[0], 1) + _nsl_rotl64(acc[1], 7) + _nsl_rotl64(acc[2], 12) + _nsl_rotl64(acc[3], 18);
+        for (usize i = 0; i < 4; i++) {
+            h = (h ^ _nsl_xxh64_round(0, acc[i])) * _NSL_XXH_P1 + _NSL_XXH_P4;
+        }
+    }
+    h += len;
+
+    for (; 8 <= rest; rest -= 8, p += 8) {
+        h ^= _nsl_xxh64_round(0, _nsl_read_u64(p));
+        h = _nsl_rotl64(h, 27) * _NSL_XXH_P1 + _NSL_XXH_P4;
+    }
+    if (4 <= rest) {
+        h ^= _nsl_read_u32(p) * _NSL_XXH_P1;
+        h = _nsl_rotl64(h, 23) * _NSL_XXH_P2 + _NSL_XXH_P3;
+        rest -= 4, p += 4;
+    }
+    for (; rest; rest--, p++) {
+        h ^= *p * _NSL_XXH_P5;
+        h = _nsl_rotl64(h, 11) * _NSL_XXH_P1;
+    }
+
+    h ^= h >> 33;
+    h *= _NSL_XXH_P2;
+    h ^= h >> 29;
+    h *= _NSL_XXH_P3;
+    h ^= h >> 32;
+    return h;
+}
+
+NSL_API u64 nsl_bytes_xxh64(nsl_Bytes bytes, u64 seed) {
+    u64 acc[4];
+    _nsl_xxh64_init(acc, seed);
+    const usize count = bytes.size / 32;
+    _nsl_xxh64_stripes(acc, bytes.data, count);
+    return _nsl_xxh64_finish(acc, seed, bytes.size, &bytes.data[count * 32], bytes.size - count * 32);
+}
+
+NSL_API void nsl_xxh64_update(nsl_Xxh64 *hasher, nsl_Bytes bytes) {
+    if (bytes.size == 0) return;
+    // the accumulators depend on the seed, so they are set up before the first stripe
+    if (hasher->len < 32 && 32 <= hasher->len + bytes.size) _nsl_xxh64_init(hasher->acc, hasher->seed);
+    hasher->len += bytes.size;
+
+    if (hasher->buffered) {
+        const usize fill = nsl_usize_min(32 - hasher->buffered, bytes.size);
+        memcpy(&hasher->buffer[hasher->buffered], bytes.data, fill);
+        hasher->buffered += fill;
+        bytes.data += fill;
+        bytes.size -= fill;
+        if (hasher->buffered < 32) return;
+        _nsl_xxh64_stripes(hasher->acc, hasher->buffer, 1);
+        hasher->buffered = 0;
+    }
+
+    const usize count = bytes.size / 32;
+    _nsl_xxh64_stripes(hasher->acc, bytes.data, count);
+    memcpy(hasher->buffer, &bytes.data[count * 32], bytes.size - count * 32);
+    hasher->buffered = bytes.size - count * 32;
+}
+
+NSL_API u64 nsl_xxh64_finish(const nsl_Xxh64 *hasher) {
+    return _nsl_xxh64_finish(hasher->acc, hasher->seed, hasher->len, hasher->buffer, hasher->buffered);
+}
+
+static const char _nsl_hex_digits[17] = "0123456789abcdef";
+
+#define X_ 0xff
+static const u8 _nsl_hex_values[256] = {
+    X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+    X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+    X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, X_, X_, X_, X_, X_, X_,
+    X_, 10, 11, 12, 13, 14, 15, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+    X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+    X_, 10, 11, 12, 13, 14, 15, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+    X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+    X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+    X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+    X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+    X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+    X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+    X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+    X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+    X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+};
+#undef X_
+
+static void _nsl_hex_encode(usize size, const u8 *bytes, char *out) {
+    usize i = 0;
+#if defined(NSL_AVX2)
+    const __m256i digits = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i *)(const void *)_nsl_hex_digits)
+    );
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    for (; i + 32 <= size; i += 32) {
+        const __m256i v = _mm256_loadu_si256((const __m256i *)(const void *)&bytes[i]);
+        const __m256i hi = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+        const __m256i lo = _mm256_shuffle_epi8(digits, _mm256_and_si256(v, nibble));
+        // unpack works inside of the 128 bit lanes
+        const __m256i a = _mm256_unpacklo_epi8(hi, lo);
+        const __m256i b = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256((__m256i *)(void *)&out[i * 2], _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256((__m256i *)(void *)&out[i * 2 + 32], _mm256_permute2x128_si256(a, b, 0x31));
+    }
+#endif
+#if defined(NSL_SSSE3)
+    const __m128i digits128 = _mm_loadu_si128((const __m128i *)(const void *)_nsl_hex_digits);
+    const __m128i nibble128 = _mm_set1_epi8(0x0f);
+    for (; i + 16 <= size; i += 16) {
+        const __m128i v = _mm_loadu_si128((const __m128i *)(const void *)&bytes[i]);
+        const __m128i hi = _mm_shuffle_epi8(digits128, _mm_and_si128(_mm_srli_epi16(v, 4), nibble128));
+        const __m128i lo = _mm_shuffle_epi8(digits128, _mm_and_si128(v, nibble128));
+        _mm_storeu_si128((__m128i *)(void *)&out[i * 2], _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i *)(void *)&out[i * 2 + 16], _mm_unpackhi_epi8(hi, lo));
+    }
+#endif
+    for (; i < size; i++) {
+        out[i * 2] = _nsl_hex_digits[bytes[i] >> 4];
+        out[i * 2 + 1] = _nsl_hex_digits[bytes[i] & 0x0f];
+    }
+}
+
+// 'len' is even. Returns false if 'hex' contains a non hex digit.
+static bool _nsl_hex_decode(usize len, const char *hex, u8 *out) {
+    usize i = 0;
+#if defined(NSL_SSSE3)
+    // (hi, lo) pairs are combined to 'hi * 16 + lo'
+    const __m128i weights = _mm_set1_epi16(0x0110);
+    for (; i + 32 <= len; i += 32) {
+        __m128i values[2];
+        __m128i invalid = _mm_setzero_si128();
+        for (usize j = 0; j < 2; j++) {
+            const __m128i v = _mm_loadu_si128((const __m128i *)(const void *)&hex[i + j * 16]);
+            const __m128i l = _mm_or_si128(v, _mm_set1_epi8(0x20));
+            const __m128i is_digit = _mm_and_si128(
+                _mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), v)
+            );
+            const __m128i is_alpha = _mm_and_si128(
+                _mm_cmpgt_epi8(l, _mm_set1_epi8('a' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('f' + 1), l)
+            );
+            const __m128i digit = _mm_and_si128(is_digit, _mm_sub_epi8(v, _mm_set1_epi8('0')));
+            const __m128i alpha = _mm_and_si128(is_alpha, _mm_sub_epi8(l, _mm_set1_epi8('a' - 10)));
+            invalid = _mm_or_si128(invalid, _mm_cmpeq_epi8(_mm_or_si128(is_digit, is_alpha), _mm_setzero_si128()));
+            values[j] = _mm_maddubs_epi16(_mm_or_si128(digit, alpha), weights);
+        }
+        if (_mm_movemask_epi8(invalid)) return false;
+        _mm_storeu_si128((__m128i *)(void *)&out[i / 2], _mm_packus_epi16(values[0], values[1]));
+    }
+#endif
+    for (; i < len; i += 2) {
+        const u8 hi = _nsl_hex_values[(u8)hex[i]];
+        const u8 lo = _nsl_hex_values[(u8)hex[i + 1]];
+        if ((hi | lo) == 0xff) return false;
+        out[i / 2] = (u8)(hi << 4 | lo);
+    }
+    return true;
+}
+
+NSL_API nsl_Str nsl_bytes_to_hex(nsl_Bytes bytes, nsl_Arena *arena) {
+    char *buf = nsl_arena_alloc(arena, bytes.size * 2 + 1);
+    _nsl_hex_encode(bytes.size, bytes.data, buf);
+    buf[bytes.size * 2] = '\0';
+    // the first byte is written without a leading zero
+    const usize skip = bytes.size && bytes.data[0] < 0x10;
+    return (nsl_Str){.len = bytes.size * 2 - skip, .data = buf + skip};
+}
+
+NSL_API nsl_Bytes nsl_bytes_from_hex(nsl_Str s, nsl_Arena *arena) {
+    if (nsl_str_startswith(s, NSL_STR("0x"))) {
+        s = nsl_str_substring(s, 2, s.len);
+    }
+
+    u8 *buffer = nsl_arena_alloc(arena, (s.len / 2) + (s.len % 2));
+    // to convert strings like "0x101".
+    // the first byte takes 1 or 2 chars depending if s.len is even or odd
+    usize idx = 0;
+    if (s.len % 2) {
+        const u8 v = _nsl_hex_values[(u8)s.data[0]];
+        buffer[idx++] = v == 0xff ? 0 : v;
+        s = nsl_str_substring(s, 1, s.len);
+    }
+    if (!_nsl_hex_decode(s.len, s.data, &buffer[idx])) {
+        // chars that are not hex digits are treated as 0
+        for (usize i = 0; i < s.len; i += 2) {
+            const u8 hi = _nsl_hex_values[(u8)s.data[i]];
+            const u8 lo = _nsl_hex_values[(u8)s.data[i + 1]];
+            buffer[idx + i / 2] = (u8)((hi == 0xff ? 0 : hi) << 4 | (lo == 0xff ? 0 : lo));
+        }
+    }
+    idx += s.len / 2;
+    return nsl_bytes_from_parts(idx, buffer);
+}
+
+NSL_API nsl_Str nsl_bytes_to_hex_sb(nsl_Bytes bytes, nsl_StrBuffer *sb) {
+    nsl_list_reserve(sb, bytes.size * 2);
+    char *out = &sb->items[sb->len];
+    _nsl_hex_encode(bytes.size, bytes.data, out);
+    sb->len += bytes.size * 2;
+    return nsl_str_from_parts(bytes.size * 2, out);
+}
+
+NSL_API nsl_Error nsl_bytes_from_hex_bb(nsl_Str s, nsl_ByteBuffer *bb) {
+    if (nsl_str_startswith(s, NSL_STR("0x"))) {
+        s = nsl_str_substring(s, 2, s.len);
+    }
+
+    nsl_list_reserve(bb, (s.len / 2) + (s.len % 2));
+    u8 *out = &bb->items[bb->len];
+    usize idx = 0;
+    if (s.len % 2) {
+        out[idx] = _nsl_hex_values[(u8)s.data[0]];
+        if (out[idx++] == 0xff) return NSL_ERROR_PARSE;
+        s = nsl_str_substring(s, 1, s.len);
+    }
+    if (!_nsl_hex_decode(s.len, s.data, &out[idx])) return NSL_ERROR_PARSE;
+
+    bb->len += idx + s.len / 2;
+    return NSL_NO_ERROR;
+}
+
+static const char _nsl_base64_chars[2][65] = {
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/",
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_",
+};
+
+#define X_ 0xff
+static const u8 _nsl_base64_values[2][256] = {
+    {
+        X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+        X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+        X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, 62, X_, X_, X_, 63,
+        52, 53, 54, 55, 56, 57, 58, 59, 60, 61, X_, X_, X_, X_, X_, X_,
+        X_,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
+        15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, X_, X_, X_, X_, X_,
+        X_, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+        41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, X_, X_, X_, X_, X_,
+        X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+        X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+        X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+        X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+        X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+        X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+        X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+        X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+    },
+    {
+        X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+        X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+        X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, 62, X_, X_,
+        52, 53, 54, 55, 56, 57, 58, 59, 60, 61, X_, X_, X_, X_, X_, X_,
+        X_,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
+        15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, X_, X_, X_, X_, 63,
+        X_, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+        41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, X_, X_, X_, X_, X_,
+        X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+        X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+        X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+        X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+        X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+        X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+        X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+        X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+    },
+};
+
+static const u8 _nsl_base32_values[256] = {
+    X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+    X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+    X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+    X_, X_, 26, 27, 28, 29, 30, 31, X_, X_, X_, X_, X_, X_, X_, X_,
+    X_,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, X_, X_, X_, X_, X_,
+    X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+    X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+    X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+    X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+    X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+    X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+    X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+    X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+    X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+    X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_, X_,
+};
+#undef X_
+
+// the simd decoders store 16 or 32 bytes for every 12 or 24 decoded bytes
+#define _NSL_BASE64_SLACK 8
+
+static usize _nsl_base64_encoded_len(usize size, nsl_Base64 alphabet) {
+    if (alphabet == NSL_BASE64_STD) return (size + 2) / 3 * 4;
+    return size / 3 * 4 + (size % 3 ? size % 3 + 1 : 0);
+}
+
+#if defined(NSL_SSSE3)
+// 12 bytes in the lower part of 'v' to 16 6-bit indices
+static __m128i _nsl_base64_ssse3_split(__m128i v) {
+    v = _mm_shuffle_epi8(v, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+    const __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(v, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+    const __m128i t1 = _mm_mullo_epi16(_mm_and_si128(v, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(t0, t1);
+}
+
+static __m128i _nsl_base64_ssse3_lookup(__m128i indices, __m128i offsets) {
+    // 0: 'a'-'z', 1-10: '0'-'9', 11: '+', 12: '/', 13: 'A'-'Z'
+    __m128i reduced = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    const __m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    reduced = _mm_or_si128(reduced, _mm_and_si128(upper, _mm_set1_epi8(13)));
+    return _mm_add_epi8(_mm_shuffle_epi8(offsets, reduced), indices);
+}
+
+static __m128i _nsl_base64_ssse3_in_range(__m128i v, char lo, char hi) {
+    const __m128i t = _mm_sub_epi8(v, _mm_set1_epi8(lo));
+    return _mm_cmpeq_epi8(_mm_min_epu8(t, _mm_set1_epi8((char)(hi - lo))), t);
+}
+
+// 16 chars to 16 6-bit values, 'invalid' collects chars outside of the alphabet
+static __m128i _nsl_base64_ssse3_values(__m128i v, const char *chars, __m128i *invalid) {
+    const __m128i upper = _nsl_base64_ssse3_in_range(v, 'A', 'Z');
+    const __m128i lower = _nsl_base64_ssse3_in_range(v, 'a', 'z');
+    const __m128i digit = _nsl_base64_ssse3_in_range(v, '0', '9');
+    const __m128i c62 = _mm_cmpeq_epi8(v, _mm_set1_epi8(chars[62]));
+    const __m128i c63 = _mm_cmpeq_epi8(v, _mm_set1_epi8(chars[63]));
+
+    __m128i offset = _mm_and_si128(upper, _mm_set1_epi8(-'A'));
+    offset = _mm_or_si128(offset, _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+    offset = _mm_or_si128(offset, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+    offset = _mm_or_si128(offset, _mm_and_si128(c62, _mm_set1_epi8((char)(62 - chars[62]))));
+    offset = _mm_or_si128(offset, _mm_and_si128(c63, _mm_set1_epi8((char)(63 - chars[63]))));
+
+    const __m128i valid = _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, _mm_or_si128(c62, c63)));
+    *invalid = _mm_or_si128(*invalid, _mm_cmpeq_epi8(valid, _mm_setzero_si128()));
+    return _mm_add_epi8(v, offset);
+}
+
+// 16 6-bit values to 12 bytes in the lower part of the result
+static __m128i _nsl_base64_ssse3_join(__m128i values) {
+    const __m128i ab_cd = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    const __m128i abcd = _mm_madd_epi16(ab_cd, _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(abcd, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+#endif
+
+static void _nsl_base64_encode(usize size, const u8 *bytes, nsl_Base64 alphabet, char *out) {
+    const char *chars = _nsl_base64_chars[alphabet];
+    usize i = 0;
+    usize o = 0;
+#if defined(NSL_SSSE3)
+    const __m128i offsets = _mm_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, (char)(chars[62] - 62), (char)(chars[63] - 63), 'A', 0, 0
+    );
+#if defined(NSL_AVX2)
+    for (; i + 28 <= size; i += 24, o += 32) {
+        const __m128i lo = _mm_loadu_si128((const __m128i *)(const void *)&bytes[i]);
+        const __m128i hi = _mm_loadu_si128((const __m128i *)(const void *)&bytes[i + 12]);
+        const __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        const __m256i split = _mm256_shuffle_epi8(v, _mm256_broadcastsi128_si256(
+            _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10)
+        ));
+        const __m256i t0 = _mm256_mulhi_epu16(
+            _mm256_and_si256(split, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040)
+        );
+        const __m256i t1 = _mm256_mullo_epi16(
+            _mm256_and_si256(split, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010)
+        );
+        const __m256i indices = _mm256_or_si256(t0, t1);
+        __m256i reduced = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+        const __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+        reduced = _mm256_or_si256(reduced, _mm256_and_si256(upper, _mm256_set1_epi8(13)));
+        const __m256i result = _mm256_add_epi8(
+            _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(offsets), reduced), indices
+        );
+        _mm256_storeu_si256((__m256i *)(void *)&out[o], result);
+    }
+#endif
+    for (; i + 16 <= size; i += 12, o += 16) {
+        const __m128i v = _mm_loadu_si128((const __m128i *)(const void *)&bytes[i]);
+        const __m128i result = _nsl_base64_ssse3_lookup(_nsl_base64_ssse3_split(v), offsets);
+        _mm_storeu_si128((__m128i *)(void *)&out[o], result);
+    }
+#endif
+    for (; i + 3 <= size; i += 3, o += 4) {
+        const u32 v = (u32)bytes[i] << 16 | (u32)bytes[i + 1] << 8 | bytes[i + 2];
+        out[o + 0] = chars[(v >> 18) & 0x3f];
+        out[o + 1] = chars[(v >> 12) & 0x3f];
+        out[o + 2] = chars[(v >> 6) & 0x3f];
+        out[o + 3] = chars[v & 0x3f];
+    }
+    if (i < size) {
+        const u32 v = (u32)bytes[i] << 16 | (i + 1 < size ? (u32)bytes[i + 1] << 8 : 0);
+        out[o++] = chars[(v >> 18) & 0x3f];
+        out[o++] = chars[(v >> 12) & 0x3f];
+        if (i + 1 < size) out[o++] = chars[(v >> 6) & 0x3f];
+        if (alphabet == NSL_BASE64_STD) {
+            while (o % 4) out[o++] = '=';
+        }
+    }
 }
 
-NSL_API void nsl_map_difference(const nsl_Map *map, const nsl_Map *other, nsl_Map *out) {
-    nsl_map_reserve(out, map->len * 2);
-    for (usize i = 0; i < map->cap; i++) {
-        if (map->items[i].hash && map->items[i].hash != NSL_MAP_DELETED) {
-            if (!nsl_map_has(other, map->items[i].hash)) {
-                nsl_map_insert(out, map->items[i].hash, other->items[i].value);
-            }
-        }
+// Strips the padding and returns the number of decoded bytes.
+static nsl_Error _nsl_base64_decoded_len(nsl_Str *s, nsl_Base64 alphabet, usize *out) {
+    usize padding = 0;
+    while (padding < 2 && padding < s->len && s->data[s->len - padding - 1] == '=') {
+        padding++;
     }
+    if ((padding || alphabet == NSL_BASE64_STD) && s->len % 4 != 0) return NSL_ERROR_PARSE;
+    s->len -= padding;
+    if (s->len % 4 == 1) return NSL_ERROR_PARSE;
+    *out = s->len / 4 * 3 + (s->len % 4 ? s->len % 4 - 1 : 0);
+    return NSL_NO_ERROR;
 }
 
-NSL_API void nsl_map_union(const nsl_Map *map, const nsl_Map *other, nsl_Map *out) {
-    for (usize i = 0; i < map->cap; i++) {
-        if (map->items[i].hash && map->items[i].hash != NSL_MAP_DELETED) {
-            if (!nsl_map_has(other, map->items[i].hash)) {
-                nsl_map_insert(out, map->items[i].hash, other->items[i].value);
-            }
-        }
+// 'out' needs '_NSL_BASE64_SLACK' bytes of extra space.
+static bool _nsl_base64_decode(usize len, const char *s, nsl_Base64 alphabet, u8 *out) {
+    const u8 *values = _nsl_base64_values[alphabet];
+    usize i = 0;
+    usize o = 0;
+#if defined(NSL_AVX2)
+    const char *chars = _nsl_base64_chars[alphabet];
+    for (; i + 32 <= len; i += 32, o += 24) {
+        const __m256i v = _mm256_loadu_si256((const __m256i *)(const void *)&s[i]);
+        __m128i invalid = _mm_setzero_si128();
+        const __m128i lo = _nsl_base64_ssse3_values(_mm256_castsi256_si128(v), chars, &invalid);
+        const __m128i hi = _nsl_base64_ssse3_values(_mm256_extracti128_si256(v, 1), chars, &invalid);
+        if (_mm_movemask_epi8(invalid)) return false;
+        const __m256i ab_cd = _mm256_maddubs_epi16(
+            _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1), _mm256_set1_epi32(0x01400140)
+        );
+        const __m256i abcd = _mm256_madd_epi16(ab_cd, _mm256_set1_epi32(0x00011000));
+        const __m256i packed = _mm256_shuffle_epi8(abcd, _mm256_broadcastsi128_si256(
+            _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1)
+        ));
+        const __m256i joined = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+        _mm256_storeu_si256((__m256i *)(void *)&out[o], joined);
+    }
+#elif defined(NSL_SSSE3)
+    const char *chars = _nsl_base64_chars[alphabet];
+#endif
+#if defined(NSL_SSSE3)
+    for (; i + 16 <= len; i += 16, o += 12) {
+        __m128i invalid = _mm_setzero_si128();
+        const __m128i v = _mm_loadu_si128((const __m128i *)(const void *)&s[i]);
+        const __m128i joined = _nsl_base64_ssse3_join(_nsl_base64_ssse3_values(v, chars, &invalid));
+        if (_mm_movemask_epi8(invalid)) return false;
+        _mm_storeu_si128((__m128i *)(void *)&out[o], joined);
     }
-
-    for (usize i = 0; i < other->cap; i++) {
-        if (other->items[i].hash && map->items[i].hash != NSL_MAP_DELETED) {
-            if (!nsl_map_has(map, other->items[i].hash)) {
-                nsl_map_insert(out, other->items[i].hash, other->items[i].value);
-            }
-        }
+#endif
+    for (; i + 4 <= len; i += 4, o += 3) {
+        const u8 a = values[(u8)s[i]], b = values[(u8)s[i + 1]];
+        const u8 c = values[(u8)s[i + 2]], d = values[(u8)s[i + 3]];
+        if ((a | b | c | d) == 0xff) return false;
+        const u32 v = (u32)a << 18 | (u32)b << 12 | (u32)c << 6 | d;
+        out[o + 0] = (u8)(v >> 16);
+        out[o + 1] = (u8)(v >> 8);
+        out[o + 2] = (u8)v;
+    }
+    if (i < len) {
+        const u8 a = values[(u8)s[i]], b = values[(u8)s[i + 1]];
+        const u8 c = i + 2 < len ? values[(u8)s[i + 2]] : 0;
+        if ((a | b | c) == 0xff) return false;
+        const u32 v = (u32)a << 18 | (u32)b << 12 | (u32)c << 6;
+        // the bits that do not make up a full byte have to be zero
+        if (i + 2 < len ? (v & 0xff) : (v & 0xffff)) return false;
+        out[o++] = (u8)(v >> 16);
+        if (i + 2 < len) out[o++] = (u8)(v >> 8);
     }
+    return true;
 }
 
-NSL_API nsl_Bytes nsl_bytes_from_parts(usize size, const void *data) {
-    return (nsl_Bytes){.size = size, .data = data};
+NSL_API nsl_Str nsl_bytes_to_base64(nsl_Bytes bytes, nsl_Base64 alphabet, nsl_Arena *arena) {
+    const usize len = _nsl_base64_encoded_len(bytes.size, alphabet);
+    char *buf = nsl_arena_alloc(arena, len + 1);
+    _nsl_base64_encode(bytes.size, bytes.data, alphabet, buf);
+    buf[len] = '\0';
+    return nsl_str_from_parts(len, buf);
 }
 
-NSL_API nsl_Bytes nsl_bytes_copy(nsl_Bytes bytes, nsl_Arena *arena) {
-    u8 *buffer = nsl_arena_alloc(arena, bytes.size);
-    memcpy(buffer, bytes.data, bytes.size);
-    return nsl_bytes_from_parts(bytes.size, buffer);
+NSL_API nsl_Str nsl_bytes_to_base64_sb(nsl_Bytes bytes, nsl_Base64 alphabet, nsl_StrBuffer *sb) {
+    const usize len = _nsl_base64_encoded_len(bytes.size, alphabet);
+    nsl_list_reserve(sb, len);
+    char *out = &sb->items[sb->len];
+    _nsl_base64_encode(bytes.size, bytes.data, alphabet, out);
+    sb->len += len;
+    return nsl_str_from_parts(len, out);
 }
 
-NSL_API nsl_Bytes nsl_bytes_slice(nsl_Bytes bytes, usize idx1, usize idx2) {
-    if (idx2 <= idx1 || bytes.size <= idx1 || bytes.size < idx2) {
-        return nsl_bytes_from_parts(0, bytes.data);
-    }
-    return nsl_bytes_from_parts(idx2 - idx1, &bytes.data[idx1]);
-}
+NSL_API nsl_Error nsl_bytes_from_base64(nsl_Str s, nsl_Base64 alphabet, nsl_Arena *arena, nsl_Bytes *out) {
+    usize size = 0;
+    nsl_Error error = _nsl_base64_decoded_len(&s, alphabet, &size);
+    if (error) return error;
 
-NSL_API nsl_Bytes nsl_bytes_take(nsl_Bytes *bytes, usize count) {
-    count = nsl_usize_min(bytes->size, count);
-    nsl_Bytes ret = nsl_bytes_from_parts(count, bytes->data);
-    bytes->size -= count;
-    bytes->data += count;
-    return ret;
+    u8 *buffer = nsl_arena_alloc(arena, size + _NSL_BASE64_SLACK);
+    if (!_nsl_base64_decode(s.len, s.data, alphabet, buffer)) return NSL_ERROR_PARSE;
+    *out = nsl_bytes_from_parts(size, buffer);
+    return NSL_NO_ERROR;
 }
 
-NSL_API bool nsl_bytes_eq(nsl_Bytes b1, nsl_Bytes b2) {
-    if (b1.size != b2.size) return false;
-    return memcmp(b1.data, b2.data, b1.size) == 0;
+NSL_API nsl_Error nsl_bytes_from_base64_bb(nsl_Str s, nsl_Base64 alphabet, nsl_ByteBuffer *bb) {
+    usize size = 0;
+    nsl_Error error = _nsl_base64_decoded_len(&s, alphabet, &size);
+    if (error) return error;
+
+    nsl_list_reserve(bb, size + _NSL_BASE64_SLACK);
+    if (!_nsl_base64_decode(s.len, s.data, alphabet, &bb->items[bb->len])) return NSL_ERROR_PARSE;
+    bb->len += size;
+    return NSL_NO_ERROR;
 }
 
-NSL_API u64 nsl_bytes_hash(nsl_Bytes bytes) {
-    const u64 offset = 2166136261UL;
-    const u64 prime = 16777619;
-    u64 hash = offset;
-    for (usize i = 0; i < bytes.size; i++) {
-        hash ^= (unsigned long)bytes.data[i];
-        hash *= prime;
+static void _nsl_base32_encode(usize size, const u8 *bytes, char *out) {
+    const char *chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+    usize o = 0;
+    u32 acc = 0;
+    u32 bits = 0;
+    for (usize i = 0; i < size; i++) {
+        acc = (acc << 8 | bytes[i]) & 0xfff;
+        bits += 8;
+        while (bits >= 5) {
+            bits -= 5;
+            out[o++] = chars[(acc >> bits) & 0x1f];
+        }
     }
-    return hash;
+    if (bits) out[o++] = chars[(acc << (5 - bits)) & 0x1f];
+    while (o % 8) out[o++] = '=';
 }
 
-NSL_API nsl_Str nsl_bytes_to_hex(nsl_Bytes bytes, nsl_Arena *arena) {
-    char *buf = nsl_arena_calloc(arena, bytes.size * 2 + 1);
-    usize idx = 0;
-    for (usize i = 0; i < bytes.size; i++) {
-        idx += (usize)snprintf(&buf[idx], 3, "%0*x", (i != 0) + 1, bytes.data[i]);
-    }
-    return (nsl_Str){.len = idx, .data = buf};
+NSL_API nsl_Str nsl_bytes_to_base32(nsl_Bytes bytes, nsl_Arena *arena) {
+    const usize len = (bytes.size + 4) / 5 * 8;
+    char *buf = nsl_arena_alloc(arena, len + 1);
+    _nsl_base32_encode(bytes.size, bytes.data, buf);
+    buf[len] = '\0';
+    return nsl_str_from_parts(len, buf);
 }
 
-NSL_API nsl_Bytes nsl_bytes_from_hex(nsl_Str s, nsl_Arena *arena) {
-    if (nsl_str_startswith(s, NSL_STR("0x"))) {
-        s = nsl_str_substring(s, 2, s.len);
+NSL_API nsl_Str nsl_bytes_to_base32_sb(nsl_Bytes bytes, nsl_StrBuffer *sb) {
+    const usize len = (bytes.size + 4) / 5 * 8;
+    nsl_list_reserve(sb, len);
+    char *out = &sb->items[sb->len];
+    _nsl_base32_encode(bytes.size, bytes.data, out);
+    sb->len += len;
+    return nsl_str_from_parts(len, out);
+}
+
+// Strips the padding and returns the number of decoded bytes.
+static nsl_Error _nsl_base32_decoded_len(nsl_Str *s, usize *out) {
+    if (s->len % 8 != 0) return NSL_ERROR_PARSE;
+    usize padding = 0;
+    while (padding < 6 && padding < s->len && s->data[s->len - padding - 1] == '=') {
+        padding++;
     }
+    // valid paddings for 1, 2, 3 and 4 trailing bytes
+    if (padding == 2 || padding == 5) return NSL_ERROR_PARSE;
+    s->len -= padding;
+    *out = s->len * 5 / 8;
+    return NSL_NO_ERROR;
+}
 
-    u8 *buffer = nsl_arena_calloc(arena, (s.len / 2) + (s.len % 2));
-    // to convert strings like "0x101".
-    // in the first iteration:
-    // take 1 or 2 chars depending if s.len is even or odd
-    usize idx = 0;
-    for (nsl_Str ch = {0}; nsl_str_try_take(&s, idx == 0 ? 2 - s.len % 2 : 2, &ch);) {
-        for (usize i = 0; i < ch.len; i++) {
-            buffer[idx] = (u8)(buffer[idx] << 4);
-            if (nsl_char_is_xdigit(ch.data[i])) {
-                buffer[idx] |= nsl_char_hex_to_u8(ch.data[i]);
-            }
+static bool _nsl_base32_decode(usize len, const char *s, u8 *out) {
+    usize o = 0;
+    u32 acc = 0;
+    u32 bits = 0;
+    for (usize i = 0; i < len; i++) {
+        const u8 v = _nsl_base32_values[(u8)s[i]];
+        if (v == 0xff) return false;
+        acc = (acc << 5 | v) & 0xfff;
+        bits += 5;
+        if (bits >= 8) {
+            bits -= 8;
+            out[o++] = (u8)(acc >> bits);
         }
-        idx++;
     }
-    return nsl_bytes_from_parts(idx, buffer);
+    return (acc & ((1u << bits) - 1)) == 0;
+}
+
+NSL_API nsl_Error nsl_bytes_from_base32(nsl_Str s, nsl_Arena *arena, nsl_Bytes *out) {
+    usize size = 0;
+    nsl_Error error = _nsl_base32_decoded_len(&s, &size);
+    if (error) return error;
+
+    u8 *buffer = nsl_arena_alloc(arena, size);
+    if (!_nsl_base32_decode(s.len, s.data, buffer)) return NSL_ERROR_PARSE;
+    *out = nsl_bytes_from_parts(size, buffer);
+    return NSL_NO_ERROR;
+}
+
+NSL_API nsl_Error nsl_bytes_from_base32_bb(nsl_Str s, nsl_ByteBuffer *bb) {
+    usize size = 0;
+    nsl_Error error = _nsl_base32_decoded_len(&s, &size);
+    if (error) return error;
+
+    nsl_list_reserve(bb, size);
+    if (!_nsl_base32_decode(s.len, s.data, &bb->items[bb->len])) return NSL_ERROR_PARSE;
+    bb->len += size;
+    return NSL_NO_ERROR;
 }
 
 #define NSL_DBASE 10
 #define NSL_XBASE 16
 
-NSL_API bool nsl_char_is_alnum(char c) { return isalnum(c); }
-NSL_API bool nsl_char_is_alpha(char c) { return isalpha(c); }
-NSL_API bool nsl_char_is_lower(char c) { return islower(c); }
-NSL_API bool nsl_char_is_upper(char c) { return isupper(c); }
-NSL_API bool nsl_char_is_space(char c) { return isspace(c); }
-NSL_API bool nsl_char_is_cntrl(char c) { return iscntrl(c); }
-NSL_API bool nsl_char_is_print(char c) { return isprint(c); }
-NSL_API bool nsl_char_is_graph(char c) { return isgraph(c); }
-NSL_API bool nsl_char_is_blank(char c) { return isblank(c); }
-NSL_API bool nsl_char_is_punct(char c) { return ispunct(c); }
-NSL_API bool nsl_char_is_digit(char c) { return isdigit(c); }
-NSL_API bool nsl_char_is_xdigit(char c) { return isxdigit(c); }
-NSL_API NSL_CONST_FN bool nsl_char_is_path_delimiter(char c) { return c == '/' || c == '\\'; }
-
-NSL_API char nsl_char_to_lower(char c) { return (char)tolower(c); }
-NSL_API char nsl_char_to_upper(char c) { return (char)toupper(c); }
+#if defined(NSL_SSE2)
+// sets every byte of 'v' that is in the range ['lo', 'hi'] to 0xff
+static __m128i _nsl_sse2_in_range(__m128i v, u8 lo, u8 hi) {
+    const __m128i t = _mm_sub_epi8(v, _mm_set1_epi8((char)lo));
+    const __m128i r = _mm_set1_epi8((char)(hi - lo));
+    return _mm_cmpeq_epi8(_mm_min_epu8(t, r), t);
+}
+
+static u32 _nsl_sse2_classify(__m128i v, u32 classes) {
+    __m128i m = _mm_setzero_si128();
+    if (classes & NSL_CHAR_CNTRL) {
+        m = _mm_or_si128(m, _nsl_sse2_in_range(v, 0, 31));
+        m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8(127)));
+    }
+    if (classes & NSL_CHAR_SPACE) {
+        m = _mm_or_si128(m, _nsl_sse2_in_range(v, '\t', '\r'));
+        m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8(' ')));
+    }
+    if (classes & NSL_CHAR_BLANK) {
+        m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('\t')));
+        m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8(' ')));
+    }
+    if (classes & NSL_CHAR_PUNCT) {
+        m = _mm_or_si128(m, _nsl_sse2_in_range(v, '!', '/'));
+        m = _mm_or_si128(m, _nsl_sse2_in_range(v, ':', '@'));
+        m = _mm_or_si128(m, _nsl_sse2_in_range(v, '[', '`'));
+        m = _mm_or_si128(m, _nsl_sse2_in_range(v, '{', '~'));
+    }
+    if (classes & (NSL_CHAR_DIGIT | NSL_CHAR_XDIGIT)) {
+        m = _mm_or_si128(m, _nsl_sse2_in_range(v, '0', '9'));
+    }
+    if (classes & NSL_CHAR_XDIGIT) {
+        // clearing bit 5 maps 'a'-'f' onto 'A'-'F'
+        const __m128i upper = _mm_andnot_si128(_mm_set1_epi8(0x20), v);
+        m = _mm_or_si128(m, _nsl_sse2_in_range(upper, 'A', 'F'));
+    }
+    if (classes & NSL_CHAR_UPPER) m = _mm_or_si128(m, _nsl_sse2_in_range(v, 'A', 'Z'));
+    if (classes & NSL_CHAR_LOWER) m = _mm_or_si128(m, _nsl_sse2_in_range(v, 'a', 'z'));
+    if (classes & NSL_CHAR_PRINT) m = _mm_or_si128(m, _nsl_sse2_in_range(v, ' ', '~'));
+    return (u32)_mm_movemask_epi8(m);
+}
+
+static __m128i _nsl_sse2_to_lower(__m128i v) {
+    const __m128i upper = _nsl_sse2_in_range(v, 'A', 'Z');
+    return _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+
+static __m128i _nsl_sse2_to_upper(__m128i v) {
+    const __m128i lower = _nsl_sse2_in_range(v, 'a', 'z');
+    return _mm_xor_si128(v, _mm_and_si128(lower, _mm_set1_epi8(0x20)));
+}
+#endif
+
+NSL_API u32 nsl_char_classify(usize len, const char *chars, u32 classes) {
+    u32 mask = 0;
+    usize i = 0;
+#if defined(NSL_SSE2)
+    for (; i + 16 <= len && i < 32; i += 16) {
+        const __m128i v = _mm_loadu_si128((const __m128i *)(const void *)&chars[i]);
+        mask |= _nsl_sse2_classify(v, classes) << i;
+    }
+#endif
+    for (; i < len && i < 32; i++) {
+        mask |= (u32)((_nsl_char_class[(u8)chars[i]] & classes) != 0) << i;
+    }
+    return mask;
+}
 
 NSL_API u8 nsl_char_to_u8(char c) {
   NSL_ASSERT(nsl_char_is_digit(c) && "char not convertible");
@@ -1360,94 +5394,125 @@ NSL_API char nsl_char_HEX_from_u8(u8 d) {
   return 0;
 }
 
+NSL_API nsl_ByteSet nsl_byteset_from_str(nsl_Str bytes) {
+    nsl_ByteSet set = {0};
+    for (usize i = 0; i < bytes.len; i++) {
+        nsl_byteset_add(&set, (u8)bytes.data[i]);
+    }
+    return set;
+}
+
+NSL_API nsl_ByteSet nsl_byteset_from_predicate(bool (*predicate)(char)) {
+    nsl_ByteSet set = {0};
+    for (usize i = 0; i < 256; i++) {
+        if (predicate((char)i)) nsl_byteset_add(&set, (u8)i);
+    }
+    return set;
+}
+
+NSL_API void nsl_byteset_add(nsl_ByteSet *set, u8 byte) {
+    set->bits[byte >> 6] |= (u64)1 << (byte & 63);
+    // 'lo' maps the low nibble to the high nibbles it appears with,
+    // 'hi' maps the high nibble to its bit. Index 1 is for bytes >= 0x80.
+    const usize half = byte >> 7;
+    const u8 bit = (u8)(1 << ((byte >> 4) & 7));
+    set->lo[half][byte & 15] |= bit;
+    set->hi[half][byte >> 4] = bit;
+}
+
+NSL_API bool nsl_byteset_has(const nsl_ByteSet *set, u8 byte) {
+    return (set->bits[byte >> 6] >> (byte & 63)) & 1;
+}
+
+// '_nsl_clz64' and '_nsl_ctz64' are undefined for 0, the callers handle it
+#if defined(__GNUC__) || defined(__clang__)
+#    define _nsl_popcount64(v) ((usize)__builtin_popcountll(v))
+#    define _nsl_clz64(v)      ((usize)__builtin_clzll(v))
+#    define _nsl_ctz64(v)      ((usize)__builtin_ctzll(v))
+#    define _nsl_bswap64(v)    __builtin_bswap64(v)
+#elif defined(_MSC_VER) && defined(_M_X64)
+#    define _nsl_popcount64(v) ((usize)__popcnt64(v))
+#    define _nsl_bswap64(v)    _byteswap_uint64(v)
+static usize _nsl_clz64(u64 v) {
+    unsigned long idx;
+    _BitScanReverse64(&idx, v);
+    return 63 - idx;
+}
+static usize _nsl_ctz64(u64 v) {
+    unsigned long idx;
+    _BitScanForward64(&idx, v);
+    return idx;
+}
+#else
+static usize _nsl_popcount64(u64 v) {
+    v = v - ((v >> 1) & 0x5555555555555555ull);
+    v = (v & 0x3333333333333333ull) + ((v >> 2) & 0x3333333333333333ull);
+    v = (v + (v >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return (usize)((v * 0x0101010101010101ull) >> 56);
+}
+static usize _nsl_clz64(u64 v) {
+    usize n = 0;
+    for (usize shift = 32; shift; shift >>= 1) {
+        if (!(v >> (64 - shift))) {
+            n += shift;
+            v <<= shift;
+        }
+    }
+    return n;
+}
+static usize _nsl_ctz64(u64 v) {
+    return _nsl_popcount64((v & (0 - v)) - 1);
+}
+static u64 _nsl_bswap64(u64 v) {
+    v = ((v & 0x00ff00ff00ff00ffull) << 8) | ((v >> 8) & 0x00ff00ff00ff00ffull);
+    v = ((v & 0x0000ffff0000ffffull) << 16) | ((v >> 16) & 0x0000ffff0000ffffull);
+    return (v << 32) | (v >> 32);
+}
+#endif
+
+static u64 _nsl_reverse_bits64(u64 v) {
+    v = ((v >> 1) & 0x5555555555555555ull) | ((v & 0x5555555555555555ull) << 1);
+    v = ((v >> 2) & 0x3333333333333333ull) | ((v & 0x3333333333333333ull) << 2);
+    v = ((v >> 4) & 0x0f0f0f0f0f0f0f0full) | ((v & 0x0f0f0f0f0f0f0f0full) << 4);
+    return _nsl_bswap64(v);
+}
+
 #define BITS(T) (sizeof(T) * 8)
+// zero extends signed values
+#define UBITS(T, v) ((u64)(v) & (~0ull >> (64 - BITS(T))))
 #define INTEGER_IMPL(T)                                                                            \
     NSL_API T nsl_##T##_reverse_bits(T value) {                                                    \
-        T reversed = 0;                                                                            \
-        for (usize i = 0; i < BITS(T); i++) {                                                      \
-            reversed = (T)(reversed << 1);                                                         \
-            if (value & 1) {                                                                       \
-                reversed = reversed | 1;                                                           \
-            }                                                                                      \
-            value = value >> 1;                                                                    \
-        }                                                                                          \
-        return reversed;                                                                           \
+        return (T)(_nsl_reverse_bits64(UBITS(T, value)) >> (64 - BITS(T)));                       \
     }                                                                                              \
                                                                                                    \
     NSL_API usize nsl_##T##_leading_ones(T value) {                                                \
-        usize count = 0;                                                                           \
-        for (usize i = 0; i < BITS(T); i++) {                                                      \
-            if (!(value >> (BITS(T) - i - 1) & (T)0x1)) {                                          \
-                break;                                                                             \
-            }                                                                                      \
-            count++;                                                                               \
-        }                                                                                          \
-        return count;                                                                              \
+        return nsl_##T##_leading_zeros((T)~value);                                                 \
     }                                                                                              \
                                                                                                    \
     NSL_API usize nsl_##T##_trailing_ones(T value) {                                               \
-        usize count = 0;                                                                           \
-        for (usize i = 0; i < BITS(T); i++) {                                                      \
-            if (!(value >> i & (T)0x1)) {                                                          \
-                break;                                                                             \
-            }                                                                                      \
-            count++;                                                                               \
-        }                                                                                          \
-        return count;                                                                              \
+        return nsl_##T##_trailing_zeros((T)~value);                                                \
     }                                                                                              \
                                                                                                    \
     NSL_API usize nsl_##T##_leading_zeros(T value) {                                               \
-        usize count = 0;                                                                           \
-        for (usize i = 0; i < BITS(T); i++) {                                                      \
-            if (value >> (BITS(T) - i - 1) & (T)0x1) {                                             \
-                break;                                                                             \
-            }                                                                                      \
-            count++;                                                                               \
-        }                                                                                          \
-        return count;                                                                              \
+        if (value == 0) return BITS(T);                                                            \
+        return _nsl_clz64(UBITS(T, value)) - (64 - BITS(T));                                       \
     }                                                                                              \
                                                                                                    \
     NSL_API usize nsl_##T##_trailing_zeros(T value) {                                              \
-        usize count = 0;                                                                           \
-        for (usize i = 0; i < BITS(T); i++) {                                                      \
-            if (value >> i & (T)0x1) {                                                             \
-                break;                                                                             \
-            }                                                                                      \
-            count++;                                                                               \
-        }                                                                                          \
-        return count;                                                                              \
+        if (value == 0) return BITS(T);                                                            \
+        return _nsl_ctz64(UBITS(T, value));                                                        \
     }                                                                                              \
                                                                                                    \
     NSL_API usize nsl_##T##_count_zeros(T value) {                                                 \
-        usize count = 0;                                                                           \
-        for (usize i = 0; i < BITS(T); i++) {                                                      \
-            if (!(value >> i & (T)0x1)) {                                                          \
-                count++;                                                                           \
-            }                                                                                      \
-        }                                                                                          \
-        return count;                                                                              \
+        return BITS(T) - _nsl_popcount64(UBITS(T, value));                                         \
     }                                                                                              \
                                                                                                    \
     NSL_API usize nsl_##T##_count_ones(T value) {                                                  \
-        usize count = 0;                                                                           \
-        for (usize i = 0; i < BITS(T); i++) {                                                      \
-            if (value >> i & (T)0x1) {                                                             \
-                count++;                                                                           \
-            }                                                                                      \
-        }                                                                                          \
-        return count;                                                                              \
+        return _nsl_popcount64(UBITS(T, value));                                                   \
     }                                                                                              \
                                                                                                    \
     NSL_API T nsl_##T##_swap_bytes(T value) {                                                      \
-        if (1 < sizeof(T)) {                                                                       \
-            u8 *bytes = (u8 *)&value;                                                              \
-            for (usize i = 0; i < (sizeof(T) + 1) / 2; i++) {                                      \
-                u8 temp = bytes[i];                                                                \
-                bytes[i] = bytes[sizeof(T) - i - 1];                                               \
-                bytes[sizeof(T) - i - 1] = temp;                                                   \
-            }                                                                                      \
-        }                                                                                          \
-        return value;                                                                              \
+        return (T)(_nsl_bswap64(UBITS(T, value)) >> (64 - BITS(T)));                               \
     }                                                                                              \
                                                                                                    \
     NSL_API T nsl_##T##_to_be(T value) {                                                           \
@@ -1581,6 +5646,221 @@ INTEGER_IMPL(usize)
 
 #undef INTEGER_IMPL
 #undef BITS
+#undef UBITS
+
+NSL_API usize nsl_u64_count_ones_array(usize count, const u64 *values) {
+    usize i = 0;
+    u64 total = 0;
+#if defined(NSL_SSSE3)
+    // popcount per nibble with a lookup, summed up per 64 bit lane by 'sad'
+    const __m128i lut = _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+#if defined(NSL_AVX2)
+    const __m256i lut256 = _mm256_broadcastsi128_si256(lut);
+    const __m256i nibble256 = _mm256_set1_epi8(0x0f);
+    __m256i acc256 = _mm256_setzero_si256();
+    for (; i + 4 <= count; i += 4) {
+        const __m256i v = _mm256_loadu_si256((const __m256i *)(const void *)&values[i]);
+        const __m256i lo = _mm256_shuffle_epi8(lut256, _mm256_and_si256(v, nibble256));
+        const __m256i hi = _mm256_shuffle_epi8(lut256, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble256));
+        acc256 = _mm256_add_epi64(acc256, _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256()));
+    }
+    u64 lanes256[4];
+    _mm256_storeu_si256((__m256i *)(void *)lanes256, acc256);
+    total += lanes256[0] + lanes256[1] + lanes256[2] + lanes256[3];
+#endif
+    const __m128i nibble = _mm_set1_epi8(0x0f);
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 2 <= count; i += 2) {
+        const __m128i v = _mm_loadu_si128((const __m128i *)(const void *)&values[i]);
+        const __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(v, nibble));
+        const __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(_mm_add_epi8(lo, hi), _mm_setzero_si128()));
+    }
+    u64 lanes[2];
+    _mm_storeu_si128((__m128i *)(void *)lanes, acc);
+    total += lanes[0] + lanes[1];
+#endif
+    for (; i < count; i++) {
+        total += _nsl_popcount64(values[i]);
+    }
+    return (usize)total;
+}
+
+static void _nsl_swap_array(usize width, usize count, const u8 *src, u8 *dst) {
+    const usize size = width * count;
+    usize i = 0;
+#if defined(NSL_SSSE3)
+    const __m128i mask = width == 2 ? _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14)
+                       : width == 4 ? _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)
+                                    : _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+#if defined(NSL_AVX2)
+    const __m256i mask256 = _mm256_broadcastsi128_si256(mask);
+    for (; i + 32 <= size; i += 32) {
+        const __m256i v = _mm256_loadu_si256((const __m256i *)(const void *)&src[i]);
+        _mm256_storeu_si256((__m256i *)(void *)&dst[i], _mm256_shuffle_epi8(v, mask256));
+    }
+#endif
+    for (; i + 16 <= size; i += 16) {
+        const __m128i v = _mm_loadu_si128((const __m128i *)(const void *)&src[i]);
+        _mm_storeu_si128((__m128i *)(void *)&dst[i], _mm_shuffle_epi8(v, mask));
+    }
+#endif
+    for (; i < size; i += width) {
+        if (width == 2) {
+            u16 v;
+            memcpy(&v, &src[i], sizeof(v));
+            v = nsl_u16_swap_bytes(v);
+            memcpy(&dst[i], &v, sizeof(v));
+        } else if (width == 4) {
+            u32 v;
+            memcpy(&v, &src[i], sizeof(v));
+            v = nsl_u32_swap_bytes(v);
+            memcpy(&dst[i], &v, sizeof(v));
+        } else {
+            u64 v;
+            memcpy(&v, &src[i], sizeof(v));
+            v = nsl_u64_swap_bytes(v);
+            memcpy(&dst[i], &v, sizeof(v));
+        }
+    }
+}
+
+static nsl_Bytes _nsl_bb_push_array(nsl_ByteBuffer *bb, usize width, usize count, const void *v, bool swap) {
+    const usize size = width * count;
+    nsl_list_reserve(bb, size);
+    u8 *out = &bb->items[bb->len];
+    if (swap) {
+        _nsl_swap_array(width, count, v, out);
+    } else if (size) {
+        memcpy(out, v, size);
+    }
+    bb->len += size;
+    return nsl_bytes_from_parts(size, out);
+}
+
+static usize _nsl_bytes_read_array(nsl_Bytes bytes, usize width, usize count, void *out, bool swap) {
+    count = nsl_usize_min(count, bytes.size / width);
+    if (swap) {
+        _nsl_swap_array(width, count, bytes.data, out);
+    } else if (count) {
+        memcpy(out, bytes.data, count * width);
+    }
+    return count;
+}
+
+#define ENDIAN_ARRAY_IMPL(T)                                                                       \
+    NSL_API nsl_Bytes nsl_bb_push_##T##_be_array(nsl_ByteBuffer *bb, usize count, const T *v) {    \
+        const bool swap = NSL_BYTE_ORDER == NSL_ENDIAN_LITTLE;                                     \
+        return _nsl_bb_push_array(bb, sizeof(T), count, v, swap);                                  \
+    }                                                                                              \
+                                                                                                   \
+    NSL_API nsl_Bytes nsl_bb_push_##T##_le_array(nsl_ByteBuffer *bb, usize count, const T *v) {    \
+        const bool swap = NSL_BYTE_ORDER == NSL_ENDIAN_BIG;                                        \
+        return _nsl_bb_push_array(bb, sizeof(T), count, v, swap);                                  \
+    }                                                                                              \
+                                                                                                   \
+    NSL_API usize nsl_bytes_read_##T##_be_array(nsl_Bytes bytes, usize count, T *out) {            \
+        const bool swap = NSL_BYTE_ORDER == NSL_ENDIAN_LITTLE;                                     \
+        return _nsl_bytes_read_array(bytes, sizeof(T), count, out, swap);                          \
+    }                                                                                              \
+                                                                                                   \
+    NSL_API usize nsl_bytes_read_##T##_le_array(nsl_Bytes bytes, usize count, T *out) {            \
+        const bool swap = NSL_BYTE_ORDER == NSL_ENDIAN_BIG;                                        \
+        return _nsl_bytes_read_array(bytes, sizeof(T), count, out, swap);                          \
+    }
+
+ENDIAN_ARRAY_IMPL(u16)
+ENDIAN_ARRAY_IMPL(i16)
+ENDIAN_ARRAY_IMPL(u32)
+ENDIAN_ARRAY_IMPL(i32)
+ENDIAN_ARRAY_IMPL(u64)
+ENDIAN_ARRAY_IMPL(i64)
+
+#undef ENDIAN_ARRAY_IMPL
+
+NSL_API u64 nsl_zigzag_encode(i64 value) {
+    return ((u64)value << 1) ^ (u64)(value >> 63);
+}
+
+NSL_API i64 nsl_zigzag_decode(u64 value) {
+    return (i64)((value >> 1) ^ (0 - (value & 1)));
+}
+
+// 'out' needs space for 10 bytes
+static usize _nsl_varint_encode(u64 value, u8 *out) {
+    usize len = 0;
+    while (value >= 0x80) {
+        out[len++] = (u8)(value | 0x80);
+        value >>= 7;
+    }
+    out[len++] = (u8)value;
+    return len;
+}
+
+NSL_API nsl_Bytes nsl_bb_push_varint(nsl_ByteBuffer *bb, u64 value) {
+    nsl_list_reserve(bb, 10);
+    u8 *out = &bb->items[bb->len];
+    const usize len = _nsl_varint_encode(value, out);
+    bb->len += len;
+    return nsl_bytes_from_parts(len, out);
+}
+
+NSL_API nsl_Bytes nsl_bb_push_varint_signed(nsl_ByteBuffer *bb, i64 value) {
+    return nsl_bb_push_varint(bb, nsl_zigzag_encode(value));
+}
+
+NSL_API nsl_Bytes nsl_bb_push_varint_array(nsl_ByteBuffer *bb, usize count, const u64 *values) {
+    nsl_list_reserve(bb, count * 10);
+    u8 *out = &bb->items[bb->len];
+    usize len = 0;
+    for (usize i = 0; i < count; i++) {
+        len += _nsl_varint_encode(values[i], &out[len]);
+    }
+    bb->len += len;
+    return nsl_bytes_from_parts(len, out);
+}
+
+NSL_API nsl_Error nsl_bytes_chop_varint(nsl_Bytes *bytes, u64 *out) {
+    if (8 <= bytes->size) {
+        // the length is the position of the first byte without the continuation bit
+        const u64 word = _nsl_read_u64(bytes->data);
+        const u64 stop = ~word & 0x8080808080808080ull;
+        if (stop) {
+            const usize len = nsl_u64_trailing_zeros(stop) / 8 + 1;
+            u64 value = 0;
+            for (usize i = 0; i < len; i++) {
+                value |= ((word >> (i * 8)) & 0x7f) << (i * 7);
+            }
+            *out = value;
+            bytes->data += len;
+            bytes->size -= len;
+            return NSL_NO_ERROR;
+        }
+    }
+
+    u64 value = 0;
+    for (usize i = 0; i < bytes->size && i < 10; i++) {
+        const u8 byte = bytes->data[i];
+        // the 10th byte only has room for the highest bit
+        if (i == 9 && 1 < byte) return NSL_ERROR_PARSE;
+        value |= (u64)(byte & 0x7f) << (i * 7);
+        if (!(byte & 0x80)) {
+            *out = value;
+            bytes->data += i + 1;
+            bytes->size -= i + 1;
+            return NSL_NO_ERROR;
+        }
+    }
+    return NSL_ERROR_PARSE;
+}
+
+NSL_API nsl_Error nsl_bytes_chop_varint_signed(nsl_Bytes *bytes, i64 *out) {
+    u64 value = 0;
+    nsl_Error error = nsl_bytes_chop_varint(bytes, &value);
+    if (error) return error;
+    *out = nsl_zigzag_decode(value);
+    return NSL_NO_ERROR;
+}
 
 NSL_API nsl_Path nsl_path_join(usize len, const nsl_Path *parts, nsl_Arena *arena) {
     if (len == 0) {
@@ -1795,6 +6075,40 @@ NSL_API nsl_Str nsl_str_wrap(nsl_Str s, nsl_Str wrap, nsl_Arena *arena) {
     return nsl_str_from_parts(new_size, buffer);
 }
 
+NSL_API nsl_Str nsl_str_to_lower(nsl_Str s, nsl_StrBuffer *sb) {
+    nsl_list_reserve(sb, s.len);
+    char *out = &sb->items[sb->len];
+    usize i = 0;
+#if defined(NSL_SSE2)
+    for (; i + 16 <= s.len; i += 16) {
+        const __m128i v = _mm_loadu_si128((const __m128i *)(const void *)&s.data[i]);
+        _mm_storeu_si128((__m128i *)(void *)&out[i], _nsl_sse2_to_lower(v));
+    }
+#endif
+    for (; i < s.len; i++) {
+        out[i] = nsl_char_to_lower(s.data[i]);
+    }
+    sb->len += s.len;
+    return nsl_str_from_parts(s.len, out);
+}
+
+NSL_API nsl_Str nsl_str_to_upper(nsl_Str s, nsl_StrBuffer *sb) {
+    nsl_list_reserve(sb, s.len);
+    char *out = &sb->items[sb->len];
+    usize i = 0;
+#if defined(NSL_SSE2)
+    for (; i + 16 <= s.len; i += 16) {
+        const __m128i v = _mm_loadu_si128((const __m128i *)(const void *)&s.data[i]);
+        _mm_storeu_si128((__m128i *)(void *)&out[i], _nsl_sse2_to_upper(v));
+    }
+#endif
+    for (; i < s.len; i++) {
+        out[i] = nsl_char_to_upper(s.data[i]);
+    }
+    sb->len += s.len;
+    return nsl_str_from_parts(s.len, out);
+}
+
 NSL_API nsl_Str nsl_str_join(nsl_Str sep, usize count, nsl_Str *s, nsl_Arena *arena) {
     if (count == 0) {
         return NSL_STR("");
@@ -1889,7 +6203,16 @@ NSL_API bool nsl_str_eq_ignorecase(nsl_Str s1, nsl_Str s2) {
     if (s1.len != s2.len) {
         return false;
     }
-    for (size_t i = 0; i < s1.len; i++) {
+    usize i = 0;
+#if defined(NSL_SSE2)
+    for (; i + 16 <= s1.len; i += 16) {
+        const __m128i a = _mm_loadu_si128((const __m128i *)(const void *)&s1.data[i]);
+        const __m128i b = _mm_loadu_si128((const __m128i *)(const void *)&s2.data[i]);
+        const __m128i eq = _mm_cmpeq_epi8(_nsl_sse2_to_lower(a), _nsl_sse2_to_lower(b));
+        if (_mm_movemask_epi8(eq) != 0xffff) return false;
+    }
+#endif
+    for (; i < s1.len; i++) {
         if (nsl_char_to_lower(s1.data[i]) != nsl_char_to_lower(s2.data[i])) {
             return false;
         }
@@ -1904,6 +6227,13 @@ NSL_API bool nsl_str_startswith(nsl_Str s1, nsl_Str prefix) {
     return memcmp(s1.data, prefix.data, prefix.len) == 0;
 }
 
+NSL_API bool nsl_str_startswith_ignorecase(nsl_Str s1, nsl_Str prefix) {
+    if (s1.len < prefix.len) {
+        return false;
+    }
+    return nsl_str_eq_ignorecase(nsl_str_from_parts(prefix.len, s1.data), prefix);
+}
+
 NSL_API bool nsl_str_endswith(nsl_Str s1, nsl_Str suffix) {
     if (s1.len < suffix.len) {
         return false;
@@ -2075,6 +6405,25 @@ NSL_API nsl_Str nsl_str_chop_by_predicate(nsl_Str *s, bool (*predicate)(char)) {
     return *s;
 }
 
+NSL_API bool nsl_str_try_chop_by_set(nsl_Str *s, const nsl_ByteSet *set, nsl_Str *chunk) {
+    if (s->len == 0) return false;
+
+    usize i = nsl_str_find_by_set(*s, set);
+    if (i == NSL_STR_NOT_FOUND) i = s->len;
+
+    if (chunk) *chunk = nsl_str_from_parts(i, s->data);
+    const usize new_len = nsl_usize_min(s->len, i + 1);
+    s->data += new_len;
+    s->len -= new_len;
+    return true;
+}
+
+NSL_API nsl_Str nsl_str_chop_by_set(nsl_Str *s, const nsl_ByteSet *set) {
+    nsl_Str chunk = *s;
+    nsl_str_try_chop_by_set(s, set, &chunk);
+    return chunk;
+}
+
 NSL_API nsl_Str nsl_str_chop_right_by_delim(nsl_Str *s, char delim) {
     usize i = 0;
     while (i < s->len && s->data[s->len - i - 1] != delim) {
@@ -2276,6 +6625,46 @@ NSL_API usize nsl_str_find(nsl_Str haystack, nsl_Str needle) {
     return NSL_STR_NOT_FOUND;
 }
 
+NSL_API usize nsl_str_find_ignorecase(nsl_Str haystack, nsl_Str needle) {
+    if (haystack.len < needle.len) {
+        return NSL_STR_NOT_FOUND;
+    }
+    if (needle.len == 0) {
+        return 0;
+    }
+    const usize last = needle.len - 1;
+    const usize end = haystack.len - needle.len + 1;
+    const char first_c = nsl_char_to_lower(needle.data[0]);
+    const char last_c = nsl_char_to_lower(needle.data[last]);
+    usize i = 0;
+#if defined(NSL_SSE2)
+    // only the positions where the first and the last char match are compared
+    const __m128i first = _mm_set1_epi8(first_c);
+    const __m128i lastv = _mm_set1_epi8(last_c);
+    for (; i + 16 <= end; i += 16) {
+        const __m128i a = _mm_loadu_si128((const __m128i *)(const void *)&haystack.data[i]);
+        const __m128i b = _mm_loadu_si128((const __m128i *)(const void *)&haystack.data[i + last]);
+        const __m128i eq = _mm_and_si128(
+            _mm_cmpeq_epi8(_nsl_sse2_to_lower(a), first),
+            _mm_cmpeq_epi8(_nsl_sse2_to_lower(b), lastv)
+        );
+        u32 mask = (u32)_mm_movemask_epi8(eq);
+        while (mask) {
+            const usize idx = i + nsl_u32_trailing_zeros(mask);
+            const nsl_Str candidate = nsl_str_from_parts(needle.len, &haystack.data[idx]);
+            if (nsl_str_eq_ignorecase(candidate, needle)) return idx;
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; i < end; i++) {
+        if (nsl_char_to_lower(haystack.data[i]) != first_c) continue;
+        if (nsl_char_to_lower(haystack.data[i + last]) != last_c) continue;
+        const nsl_Str candidate = nsl_str_from_parts(needle.len, &haystack.data[i]);
+        if (nsl_str_eq_ignorecase(candidate, needle)) return i;
+    }
+    return NSL_STR_NOT_FOUND;
+}
 
 NSL_API usize nsl_str_find_by_predicate(nsl_Str haystack, bool (*predicate)(char)) {
     if (haystack.len == 0) {
@@ -2289,6 +6678,62 @@ NSL_API usize nsl_str_find_by_predicate(nsl_Str haystack, bool (*predicate)(char
     return NSL_STR_NOT_FOUND;
 }
 
+#if defined(NSL_SSSE3)
+static __m128i _nsl_byteset_outside_ssse3(const nsl_ByteSet *set, __m128i v) {
+    const __m128i nibble = _mm_set1_epi8(0x0f);
+    const __m128i lo = _mm_and_si128(v, nibble);
+    const __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), nibble);
+    __m128i m = _mm_setzero_si128();
+    for (usize h = 0; h < 2; h++) {
+        const __m128i tlo = _mm_loadu_si128((const __m128i *)(const void *)set->lo[h]);
+        const __m128i thi = _mm_loadu_si128((const __m128i *)(const void *)set->hi[h]);
+        m = _mm_or_si128(m, _mm_and_si128(_mm_shuffle_epi8(tlo, lo), _mm_shuffle_epi8(thi, hi)));
+    }
+    return _mm_cmpeq_epi8(m, _mm_setzero_si128());
+}
+#endif
+
+#if defined(NSL_AVX2)
+static __m256i _nsl_byteset_outside_avx2(const nsl_ByteSet *set, __m256i v) {
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    const __m256i lo = _mm256_and_si256(v, nibble);
+    const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble);
+    __m256i m = _mm256_setzero_si256();
+    for (usize h = 0; h < 2; h++) {
+        const __m256i tlo = _mm256_broadcastsi128_si256(
+            _mm_loadu_si128((const __m128i *)(const void *)set->lo[h])
+        );
+        const __m256i thi = _mm256_broadcastsi128_si256(
+            _mm_loadu_si128((const __m128i *)(const void *)set->hi[h])
+        );
+        m = _mm256_or_si256(m, _mm256_and_si256(_mm256_shuffle_epi8(tlo, lo), _mm256_shuffle_epi8(thi, hi)));
+    }
+    return _mm256_cmpeq_epi8(m, _mm256_setzero_si256());
+}
+#endif
+
+NSL_API usize nsl_str_find_by_set(nsl_Str haystack, const nsl_ByteSet *set) {
+    usize i = 0;
+#if defined(NSL_AVX2)
+    for (; i + 32 <= haystack.len; i += 32) {
+        const __m256i v = _mm256_loadu_si256((const __m256i *)(const void *)&haystack.data[i]);
+        const u32 mask = ~(u32)_mm256_movemask_epi8(_nsl_byteset_outside_avx2(set, v));
+        if (mask) return i + nsl_u32_trailing_zeros(mask);
+    }
+#endif
+#if defined(NSL_SSSE3)
+    for (; i + 16 <= haystack.len; i += 16) {
+        const __m128i v = _mm_loadu_si128((const __m128i *)(const void *)&haystack.data[i]);
+        const u32 mask = ~(u32)_mm_movemask_epi8(_nsl_byteset_outside_ssse3(set, v)) & 0xffff;
+        if (mask) return i + nsl_u32_trailing_zeros(mask);
+    }
+#endif
+    for (; i < haystack.len; i++) {
+        if (nsl_byteset_has(set, (u8)haystack.data[i])) return i;
+    }
+    return NSL_STR_NOT_FOUND;
+}
+
 NSL_API usize nsl_str_find_last(nsl_Str haystack, nsl_Str needle) {
     if (haystack.len < needle.len) {
         return NSL_STR_NOT_FOUND;
@@ -2328,6 +6773,14 @@ NSL_API usize nsl_str_count(nsl_Str haystack, nsl_Str needle) {
     return count;
 }
 
+NSL_API usize nsl_str_split_all(nsl_Str s, const nsl_ByteSet *set, nsl_StrList *out) {
+    const usize len = out->len;
+    for (nsl_Str chunk = {0}; nsl_str_try_chop_by_set(&s, set, &chunk);) {
+        nsl_list_push(out, chunk);
+    }
+    return out->len - len;
+}
+
 NSL_API char nsl_str_getc(nsl_Str s, usize idx) {
     if (s.len <= idx) {
         return '\0';
@@ -2335,27 +6788,245 @@ NSL_API char nsl_str_getc(nsl_Str s, usize idx) {
     return s.data[idx];
 }
 
-NSL_API u64 nsl_str_hash(nsl_Str s) {
-    const uint64_t magic_prime = 0x00000100000001b3;
-    uint64_t hash = 0xcbf29ce484222325;
-    for (usize i = 0; i < s.len; ++i) {
-        hash = (hash ^ (u64)s.data[i]) * magic_prime;
+#if defined(NSL_SSSE3)
+// https://arxiv.org/abs/2010.03090 (Keiser, Lemire: Validating UTF-8 In Less Than One Instruction Per Byte)
+#define NSL_UTF8_TOO_SHORT      (1 << 0)
+#define NSL_UTF8_TOO_LONG       (1 << 1)
+#define NSL_UTF8_OVERLONG_3     (1 << 2)
+#define NSL_UTF8_TOO_LARGE      (1 << 3)
+#define NSL_UTF8_SURROGATE      (1 << 4)
+#define NSL_UTF8_OVERLONG_2     (1 << 5)
+#define NSL_UTF8_TOO_LARGE_1000 (1 << 6)
+#define NSL_UTF8_OVERLONG_4     (1 << 6)
+#define NSL_UTF8_TWO_CONTS      (1 << 7)
+#define NSL_UTF8_CARRY          (NSL_UTF8_TOO_SHORT | NSL_UTF8_TOO_LONG | NSL_UTF8_TWO_CONTS)
+
+static __m128i _nsl_utf8_check_block(__m128i input, __m128i prev_input) {
+    const __m128i nibble = _mm_set1_epi8(0x0f);
+    const __m128i prev1 = _mm_alignr_epi8(input, prev_input, 15);
+
+    const __m128i byte_1_high = _mm_shuffle_epi8(_mm_setr_epi8(
+        NSL_UTF8_TOO_LONG, NSL_UTF8_TOO_LONG, NSL_UTF8_TOO_LONG, NSL_UTF8_TOO_LONG,
+        NSL_UTF8_TOO_LONG, NSL_UTF8_TOO_LONG, NSL_UTF8_TOO_LONG, NSL_UTF8_TOO_LONG,
+        (char)NSL_UTF8_TWO_CONTS, (char)NSL_UTF8_TWO_CONTS,
+        (char)NSL_UTF8_TWO_CONTS, (char)NSL_UTF8_TWO_CONTS,
+        NSL_UTF8_TOO_SHORT | NSL_UTF8_OVERLONG_2,
+        NSL_UTF8_TOO_SHORT,
+        NSL_UTF8_TOO_SHORT | NSL_UTF8_OVERLONG_3 | NSL_UTF8_SURROGATE,
+        NSL_UTF8_TOO_SHORT | NSL_UTF8_TOO_LARGE | NSL_UTF8_TOO_LARGE_1000 | NSL_UTF8_OVERLONG_4
+    ), _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+
+    const __m128i byte_1_low = _mm_shuffle_epi8(_mm_setr_epi8(
+        (char)(NSL_UTF8_CARRY | NSL_UTF8_OVERLONG_3 | NSL_UTF8_OVERLONG_2 | NSL_UTF8_OVERLONG_4),
+        (char)(NSL_UTF8_CARRY | NSL_UTF8_OVERLONG_2),
+        (char)NSL_UTF8_CARRY,
+        (char)NSL_UTF8_CARRY,
+        (char)(NSL_UTF8_CARRY | NSL_UTF8_TOO_LARGE),
+        (char)(NSL_UTF8_CARRY | NSL_UTF8_TOO_LARGE | NSL_UTF8_TOO_LARGE_1000),
+        (char)(NSL_UTF8_CARRY | NSL_UTF8_TOO_LARGE | NSL_UTF8_TOO_LARGE_1000),
+        (char)(NSL_UTF8_CARRY | NSL_UTF8_TOO_LARGE | NSL_UTF8_TOO_LARGE_1000),
+        (char)(NSL_UTF8_CARRY | NSL_UTF8_TOO_LARGE | NSL_UTF8_TOO_LARGE_1000),
+        (char)(NSL_UTF8_CARRY | NSL_UTF8_TOO_LARGE | NSL_UTF8_TOO_LARGE_1000),
+        (char)(NSL_UTF8_CARRY | NSL_UTF8_TOO_LARGE | NSL_UTF8_TOO_LARGE_1000),
+        (char)(NSL_UTF8_CARRY | NSL_UTF8_TOO_LARGE | NSL_UTF8_TOO_LARGE_1000),
+        (char)(NSL_UTF8_CARRY | NSL_UTF8_TOO_LARGE | NSL_UTF8_TOO_LARGE_1000),
+        (char)(NSL_UTF8_CARRY | NSL_UTF8_TOO_LARGE | NSL_UTF8_TOO_LARGE_1000 | NSL_UTF8_SURROGATE),
+        (char)(NSL_UTF8_CARRY | NSL_UTF8_TOO_LARGE | NSL_UTF8_TOO_LARGE_1000),
+        (char)(NSL_UTF8_CARRY | NSL_UTF8_TOO_LARGE | NSL_UTF8_TOO_LARGE_1000)
+    ), _mm_and_si128(prev1, nibble));
+
+    const __m128i byte_2_high = _mm_shuffle_epi8(_mm_setr_epi8(
+        NSL_UTF8_TOO_SHORT, NSL_UTF8_TOO_SHORT, NSL_UTF8_TOO_SHORT, NSL_UTF8_TOO_SHORT,
+        NSL_UTF8_TOO_SHORT, NSL_UTF8_TOO_SHORT, NSL_UTF8_TOO_SHORT, NSL_UTF8_TOO_SHORT,
+        (char)(NSL_UTF8_TOO_LONG | NSL_UTF8_OVERLONG_2 | NSL_UTF8_TWO_CONTS |
+               NSL_UTF8_OVERLONG_3 | NSL_UTF8_TOO_LARGE_1000 | NSL_UTF8_OVERLONG_4),
+        (char)(NSL_UTF8_TOO_LONG | NSL_UTF8_OVERLONG_2 | NSL_UTF8_TWO_CONTS |
+               NSL_UTF8_OVERLONG_3 | NSL_UTF8_TOO_LARGE),
+        (char)(NSL_UTF8_TOO_LONG | NSL_UTF8_OVERLONG_2 | NSL_UTF8_TWO_CONTS |
+               NSL_UTF8_SURROGATE | NSL_UTF8_TOO_LARGE),
+        (char)(NSL_UTF8_TOO_LONG | NSL_UTF8_OVERLONG_2 | NSL_UTF8_TWO_CONTS |
+               NSL_UTF8_SURROGATE | NSL_UTF8_TOO_LARGE),
+        NSL_UTF8_TOO_SHORT, NSL_UTF8_TOO_SHORT, NSL_UTF8_TOO_SHORT, NSL_UTF8_TOO_SHORT
+    ), _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+
+    const __m128i special = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+
+    // the 3rd and 4th byte of a sequence have to be continuations ('TWO_CONTS' in 'special')
+    const __m128i prev2 = _mm_alignr_epi8(input, prev_input, 14);
+    const __m128i prev3 = _mm_alignr_epi8(input, prev_input, 13);
+    const __m128i third = _mm_subs_epu8(prev2, _mm_set1_epi8((char)(0xe0 - 0x80)));
+    const __m128i fourth = _mm_subs_epu8(prev3, _mm_set1_epi8((char)(0xf0 - 0x80)));
+    const __m128i must23 = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8((char)0x80));
+    return _mm_xor_si128(must23, special);
+}
+
+// non zero if the last bytes start a sequence that does not fit into the block
+static __m128i _nsl_utf8_incomplete(__m128i input) {
+    const __m128i max = _mm_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        (char)(0xf0 - 1), (char)(0xe0 - 1), (char)(0xc0 - 1)
+    );
+    return _mm_subs_epu8(input, max);
+}
+
+#undef NSL_UTF8_TOO_SHORT
+#undef NSL_UTF8_TOO_LONG
+#undef NSL_UTF8_OVERLONG_3
+#undef NSL_UTF8_TOO_LARGE
+#undef NSL_UTF8_SURROGATE
+#undef NSL_UTF8_OVERLONG_2
+#undef NSL_UTF8_TOO_LARGE_1000
+#undef NSL_UTF8_OVERLONG_4
+#undef NSL_UTF8_TWO_CONTS
+#undef NSL_UTF8_CARRY
+#endif
+
+// Returns the length of the sequence at the start of 's' or 0 if it is invalid.
+static usize _nsl_utf8_decode(nsl_Str s, u32 *codepoint) {
+    const u8 *p = (const u8 *)s.data;
+    if (p[0] < 0x80) {
+        *codepoint = p[0];
+        return 1;
+    }
+
+    usize len = 0;
+    u32 cp = 0, min = 0;
+    if ((p[0] & 0xe0) == 0xc0) {
+        len = 2, cp = p[0] & 0x1f, min = 0x80;
+    } else if ((p[0] & 0xf0) == 0xe0) {
+        len = 3, cp = p[0] & 0x0f, min = 0x800;
+    } else if ((p[0] & 0xf8) == 0xf0) {
+        len = 4, cp = p[0] & 0x07, min = 0x10000;
+    } else {
+        return 0;
+    }
+    if (s.len < len) return 0;
+
+    for (usize i = 1; i < len; i++) {
+        if ((p[i] & 0xc0) != 0x80) return 0;
+        cp = (cp << 6) | (p[i] & 0x3f);
+    }
+    if (cp < min || 0x10ffff < cp || (0xd800 <= cp && cp <= 0xdfff)) return 0;
+
+    *codepoint = cp;
+    return len;
+}
+
+NSL_API bool nsl_str_utf8_validate(nsl_Str s) {
+    usize i = 0;
+#if defined(NSL_SSSE3)
+    __m128i error = _mm_setzero_si128();
+    __m128i prev = _mm_setzero_si128();
+    __m128i prev_incomplete = _mm_setzero_si128();
+    for (; i < s.len; i += 16) {
+        __m128i input;
+        if (i + 16 <= s.len) {
+            input = _mm_loadu_si128((const __m128i *)(const void *)&s.data[i]);
+        } else {
+            // zero padding is ascii, so an incomplete sequence at the end is 'TOO_SHORT'
+            char tail[16] = {0};
+            memcpy(tail, &s.data[i], s.len - i);
+            input = _mm_loadu_si128((const __m128i *)(const void *)tail);
+        }
+
+        if (_mm_movemask_epi8(input) == 0) {
+            error = _mm_or_si128(error, prev_incomplete);
+            prev_incomplete = _mm_setzero_si128();
+        } else {
+            error = _mm_or_si128(error, _nsl_utf8_check_block(input, prev));
+            prev_incomplete = _nsl_utf8_incomplete(input);
+        }
+        prev = input;
+    }
+    error = _mm_or_si128(error, prev_incomplete);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xffff;
+#else
+    while (i < s.len) {
+        // skip 8 ascii bytes at once
+        if (i + 8 <= s.len) {
+            u64 word;
+            memcpy(&word, &s.data[i], sizeof(word));
+            if ((word & 0x8080808080808080ull) == 0) {
+                i += 8;
+                continue;
+            }
+        }
+        u32 cp = 0;
+        const usize len = _nsl_utf8_decode(nsl_str_from_parts(s.len - i, &s.data[i]), &cp);
+        if (len == 0) return false;
+        i += len;
+    }
+    return true;
+#endif
+}
+
+NSL_API bool nsl_str_utf8_try_chop(nsl_Str *s, u32 *codepoint) {
+    if (s->len == 0) return false;
+    u32 cp = 0;
+    usize len = _nsl_utf8_decode(*s, &cp);
+    if (len == 0) {
+        cp = 0xfffd;
+        len = 1;
+    }
+    if (codepoint) *codepoint = cp;
+    s->data += len;
+    s->len -= len;
+    return true;
+}
+
+NSL_API usize nsl_str_utf8_count(nsl_Str s) {
+    usize count = 0;
+    usize i = 0;
+#if defined(NSL_SSE2)
+    // every byte that is not a continuation byte (0b10xxxxxx) starts a code point
+    const __m128i cont = _mm_set1_epi8((char)0xbf);
+    for (; i + 16 <= s.len; i += 16) {
+        const __m128i v = _mm_loadu_si128((const __m128i *)(const void *)&s.data[i]);
+        const u32 mask = (u32)_mm_movemask_epi8(_mm_cmpgt_epi8(v, cont));
+        count += nsl_u32_count_ones(mask);
+    }
+#endif
+    for (; i < s.len; i++) {
+        count += ((u8)s.data[i] & 0xc0) != 0x80;
+    }
+    return count;
+}
+
+NSL_API usize nsl_str_utf8_index(nsl_Str s, usize offset) {
+    return nsl_str_utf8_count(nsl_str_from_parts(nsl_usize_min(offset, s.len), s.data));
+}
+
+NSL_API usize nsl_str_utf8_offset(nsl_Str s, usize index) {
+    for (usize i = 0; i < s.len; i++) {
+        if (((u8)s.data[i] & 0xc0) == 0x80) continue;
+        if (index == 0) return i;
+        index--;
     }
-    return hash;
+    return s.len;
+}
+
+NSL_API u64 nsl_str_hash(nsl_Str s) {
+    return nsl_bytes_hash_seed(nsl_str_to_bytes(s), 0);
+}
+
+NSL_API u64 nsl_str_hash_seed(nsl_Str s, u64 seed) {
+    return nsl_bytes_hash_seed(nsl_str_to_bytes(s), seed);
 }
 
 #if defined(NSL_POSIX)
 
 NSL_API nsl_Error nsl_dll_load(nsl_Dll* dll, nsl_Path path) {
-    if (!nsl_os_exists(path)) {
+    // names without a directory are searched by the dynamic loader
+    const bool search = nsl_str_find(path, NSL_STR("/")) == NSL_STR_NOT_FOUND;
+    if (!search && !nsl_os_exists(path)) {
         return NSL_ERROR_FILE_NOT_FOUND;
     }
     char lib_path[FILENAME_MAX] = {0};
-    memcpy(lib_path, path.data, nsl_usize_min(path.len, FILENAME_MAX));
+    memcpy(lib_path, path.data, nsl_usize_min(path.len, FILENAME_MAX - 1));
 
     dll->handle = dlopen(lib_path, RTLD_LAZY);
     if (dll->handle == NULL) {
-        return NSL_ERROR;
+        return search ? NSL_ERROR_FILE_NOT_FOUND : NSL_ERROR;
     }
 
     return NSL_NO_ERROR;
@@ -2370,7 +7041,7 @@ NSL_API nsl_Function nsl_dll_symbol(nsl_Dll *handle, nsl_Str symbol) {
     nsl_Arena arena = {0};
 
     const char* s = nsl_str_to_cstr(symbol, &arena);
-    *(void **)(&result) = dlsym(handle, s);
+    *(void **)(&result) = dlsym(handle->handle, s);
 
     nsl_arena_free(&arena);
     return result;
@@ -2519,103 +7190,652 @@ NSL_API nsl_Error nsl_os_mkdir_conf(nsl_Path path, nsl_OsDirConfig config) {
         NSL_PANIC(strerror(errno));
     }
 
-    return NSL_NO_ERROR;
+    return NSL_NO_ERROR;
+}
+
+NSL_API nsl_Error nsl_os_chdir(nsl_Path path) {
+    if (path.len >= NSL_OS_PATH_MAX - 1) return NSL_ERROR_PATH_TOO_LONG;
+
+    errno = 0;
+
+    char filepath[NSL_OS_PATH_MAX] = {0};
+    memcpy(filepath, path.data, path.len);
+    filepath[path.len] = '\0';
+
+    if (chdir(filepath) != 0) {
+        if (errno == EACCES)  return NSL_ERROR_ACCESS_DENIED;
+        if (errno == ENOENT)  return NSL_ERROR_FILE_NOT_FOUND;
+        if (errno == ENOTDIR) return NSL_ERROR_NOT_DIRECTORY;
+        NSL_PANIC(strerror(errno));
+    }
+
+    return NSL_NO_ERROR;
+}
+
+NSL_API nsl_Path nsl_os_cwd(nsl_Arena *arena) {
+    errno = 0;
+    char *temp_path = getcwd(NULL, 0);
+    if (temp_path == NULL) {
+        NSL_PANIC(strerror(errno));
+    }
+    nsl_Path path = nsl_str_copy(nsl_str_from_cstr(temp_path), arena);
+    free(temp_path);
+    return path;
+}
+
+NSL_API nsl_Str nsl_os_getenv(const char *env, nsl_Arena* arena) {
+    const char *var = getenv(env);
+    return var ? nsl_str_copy(nsl_str_from_cstr(var), arena) : (nsl_Str){0};
+}
+
+NSL_API usize nsl_os_cpu_count(void) {
+    const long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count < 1 ? 1 : (usize)count;
+}
+
+NSL_API bool nsl_os_exists(nsl_Path path) {
+    if (path.len >= NSL_OS_PATH_MAX - 1) return false;
+
+    char filepath[NSL_OS_PATH_MAX] = {0};
+    memcpy(filepath, path.data, path.len);
+    filepath[path.len] = '\0';
+
+    return access(filepath, 0) == 0;
+}
+
+NSL_API bool nsl_os_is_dir(nsl_Path path) {
+    if (path.len >= NSL_OS_PATH_MAX - 1) return NSL_ERROR_PATH_TOO_LONG;
+
+    char filepath[NSL_OS_PATH_MAX] = {0};
+    memcpy(filepath, path.data, path.len);
+    filepath[path.len] = '\0';
+
+    struct stat info;
+    if (stat(filepath, &info) == -1) {
+        return false;
+    }
+
+    return S_ISDIR(info.st_mode);
+}
+
+NSL_API nsl_Error nsl_os_remove(nsl_Path path) {
+    if (path.len >= NSL_OS_PATH_MAX - 1) return NSL_ERROR_PATH_TOO_LONG;
+
+    char filepath[NSL_OS_PATH_MAX] = {0};
+    memcpy(filepath, path.data, path.len);
+    filepath[path.len] = '\0';
+
+    errno = 0;
+    if (unlink(filepath) != 0) {
+        if (errno == EACCES) return NSL_ERROR_ACCESS_DENIED;
+        if (errno == ENOENT) return NSL_ERROR_FILE_NOT_FOUND;
+        if (errno == EISDIR) return NSL_ERROR_NOT_DIRECTORY;
+        if (errno == EBUSY)  return NSL_ERROR_FILE_BUSY;
+        NSL_PANIC(strerror(errno));
+    }
+
+    return NSL_NO_ERROR;
+}
+
+NSL_API bool nsl_os_older_than(nsl_Path p1, nsl_Path p2) {
+    if (p1.len >= NSL_OS_PATH_MAX - 1 || p1.len >= NSL_OS_PATH_MAX - 1) return false;
+
+    char filepath[NSL_OS_PATH_MAX] = {0};
+    struct stat info[2];
+
+    memcpy(filepath, p1.data, p1.len);
+    filepath[p1.len] = '\0';
+    if (stat(filepath, &info[0]) == -1) return false;
+
+    memcpy(filepath, p1.data, p1.len);
+    filepath[p2.len] = '\0';
+    if (stat(filepath, &info[1]) == -1) return false;
+
+    return info[0].st_mtime < info[1].st_mtime;
+}
+
+NSL_API nsl_Error nsl_file_map(nsl_Path path, nsl_FileMap *out) {
+    if (path.len >= NSL_OS_PATH_MAX - 1) return NSL_ERROR_PATH_TOO_LONG;
+
+    char filepath[NSL_OS_PATH_MAX] = {0};
+    memcpy(filepath, path.data, path.len);
+
+    errno = 0;
+    const int fd = open(filepath, O_RDONLY);
+    if (fd == -1) {
+        if (errno == ENOENT) return NSL_ERROR_FILE_NOT_FOUND;
+        if (errno == EACCES) return NSL_ERROR_ACCESS_DENIED;
+        NSL_PANIC(strerror(errno));
+    }
+
+    nsl_Error result = NSL_NO_ERROR;
+    struct stat info;
+    if (fstat(fd, &info) == -1 || !S_ISREG(info.st_mode)) NSL_DEFER(NSL_ERROR);
+
+    *out = (nsl_FileMap){0};
+    if (info.st_size == 0) NSL_DEFER(NSL_NO_ERROR);
+
+    void *data = mmap(NULL, (usize)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) NSL_DEFER(NSL_ERROR);
+    out->bytes = nsl_bytes_from_parts((usize)info.st_size, data);
+
+defer:
+    // the mapping keeps its own reference to the file
+    close(fd);
+    return result;
+}
+
+NSL_API void nsl_file_map_advise(const nsl_FileMap *map, nsl_FileMapAdvice advice) {
+    if (map->bytes.size == 0) return;
+    void *data = (void *)(usize)map->bytes.data;
+    if (advice & NSL_FILE_MAP_SEQUENTIAL) madvise(data, map->bytes.size, MADV_SEQUENTIAL);
+    if (advice & NSL_FILE_MAP_RANDOM)     madvise(data, map->bytes.size, MADV_RANDOM);
+    if (advice & NSL_FILE_MAP_WILLNEED)   madvise(data, map->bytes.size, MADV_WILLNEED);
+#if defined(MADV_HUGEPAGE)
+    if (advice & NSL_FILE_MAP_HUGEPAGE)   madvise(data, map->bytes.size, MADV_HUGEPAGE);
+#endif
+}
+
+NSL_API void nsl_file_unmap(nsl_FileMap *map) {
+    if (map->bytes.size) munmap((void *)(usize)map->bytes.data, map->bytes.size);
+    *map = (nsl_FileMap){0};
+}
+
+#if defined(__linux__) && !defined(FICLONE)
+#   define FICLONE _IOW(0x94, 9, int)
+#endif
+
+static nsl_Error _nsl_os_copy_fd(int in, int out, usize size) {
+    usize copied = 0;
+#if defined(__linux__)
+    // shares the extents on copy on write file systems (btrfs, xfs)
+    if (ioctl(out, FICLONE, in) == 0) return NSL_NO_ERROR;
+#if defined(SYS_copy_file_range)
+    // can be offloaded to the file system or the storage
+    while (copied < size) {
+        const long n = syscall(SYS_copy_file_range, in, NULL, out, NULL, size - copied, 0u);
+        if (n <= 0) break;
+        copied += (usize)n;
+    }
+#endif
+    while (copied < size) {
+        const ssize_t n = sendfile(out, in, NULL, size - copied);
+        if (n <= 0) break;
+        copied += (usize)n;
+    }
+#endif
+    // the file offsets moved with every copy, so this continues where the others stopped. Also
+    // copies files that report no size
+    nsl_Error result = NSL_NO_ERROR;
+    const usize cap = 1024 * 1024;
+    u8 *buffer = nsl_arena_alloc_chunk(NULL, cap);
+    while (true) {
+        const ssize_t n = read(in, buffer, cap);
+        if (n == -1 && errno == EINTR) continue;
+        if (n == -1) NSL_DEFER(NSL_ERROR);
+        if (n == 0) break;
+        for (ssize_t len = 0; len < n;) {
+            const ssize_t written = write(out, &buffer[len], (usize)(n - len));
+            if (written == -1 && errno == EINTR) continue;
+            if (written == -1) NSL_DEFER(NSL_ERROR);
+            len += written;
+        }
+    }
+
+defer:
+    nsl_arena_free_chunk(NULL, buffer);
+    return result;
+}
+
+NSL_API nsl_Error nsl_os_copy_file_conf(nsl_Path src, nsl_Path dst, nsl_OsCopyConfig config) {
+    if (src.len >= NSL_OS_PATH_MAX - 1) return NSL_ERROR_PATH_TOO_LONG;
+    if (dst.len >= NSL_OS_PATH_MAX - 1) return NSL_ERROR_PATH_TOO_LONG;
+
+    char srcpath[NSL_OS_PATH_MAX] = {0};
+    memcpy(srcpath, src.data, src.len);
+    char dstpath[NSL_OS_PATH_MAX] = {0};
+    memcpy(dstpath, dst.data, dst.len);
+
+    errno = 0;
+    const int in = open(srcpath, O_RDONLY);
+    if (in == -1) {
+        if (errno == ENOENT) return NSL_ERROR_FILE_NOT_FOUND;
+        if (errno == EACCES) return NSL_ERROR_ACCESS_DENIED;
+        NSL_PANIC(strerror(errno));
+    }
+
+    nsl_Error result = NSL_NO_ERROR;
+    int out = -1;
+    struct stat info[2];
+    if (fstat(in, &info[0]) == -1) NSL_DEFER(NSL_ERROR);
+    if (S_ISDIR(info[0].st_mode)) NSL_DEFER(NSL_ERROR_IS_DIRECTORY);
+    const bool exists = stat(dstpath, &info[1]) == 0;
+    // truncating the destination would delete the source
+    if (exists && info[0].st_dev == info[1].st_dev && info[0].st_ino == info[1].st_ino) {
+        NSL_DEFER(NSL_ERROR_ALREADY_EXISTS);
+    }
+
+    const int flags = O_WRONLY | O_CREAT | (config.overwrite ? O_TRUNC : O_EXCL);
+    out = open(dstpath, flags, info[0].st_mode & 0777);
+    if (out == -1) {
+        if (errno == EEXIST) NSL_DEFER(NSL_ERROR_ALREADY_EXISTS);
+        if (errno == ENOENT) NSL_DEFER(NSL_ERROR_FILE_NOT_FOUND);
+        if (errno == EACCES) NSL_DEFER(NSL_ERROR_ACCESS_DENIED);
+        if (errno == EISDIR) NSL_DEFER(NSL_ERROR_IS_DIRECTORY);
+        NSL_DEFER(NSL_ERROR);
+    }
+    // an existing file keeps its mode on open and a new one is masked by the umask. The setuid,
+    // setgid and sticky bits are not copied. An existing file that is writable but owned by someone
+    // else can't be changed, it is already truncated so the copy continues with its mode
+    if (fchmod(out, info[0].st_mode & 0777) == -1 && !exists) NSL_DEFER(NSL_ERROR);
+    result = _nsl_os_copy_fd(in, out, (usize)info[0].st_size);
+
+defer:
+    close(in);
+    if (out != -1 && close(out) == -1 && result == NSL_NO_ERROR) result = NSL_ERROR;
+    return result;
+}
+
+static bool _nsl_follower_open(nsl_FileFollower *follower, const char *filepath) {
+    const int fd = open(filepath, O_RDONLY);
+    if (fd == -1) return false;
+    struct stat info;
+    if (fstat(fd, &info) == -1 || lseek(fd, (off_t)follower->offset, SEEK_SET) == -1) {
+        close(fd);
+        return false;
+    }
+    follower->_file = fd;
+    follower->_opened = true;
+    follower->_id[0] = (u64)info.st_dev;
+    follower->_id[1] = (u64)info.st_ino;
+    return true;
+}
+
+// watches the directory, so a file that replaces the followed one is noticed as well
+static void _nsl_follower_watch(nsl_FileFollower *follower) {
+#if defined(__linux__)
+    char dirpath[NSL_OS_PATH_MAX] = {0};
+    const nsl_Path parent = nsl_path_parent(follower->path);
+    memcpy(dirpath, parent.data, parent.len);
+    const u32 mask = IN_MODIFY | IN_ATTRIB | IN_CREATE | IN_MOVED_TO | IN_DELETE;
+    const int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd != -1 && inotify_add_watch(fd, dirpath, mask) != -1) {
+        follower->_watch = fd;
+        follower->_watching = true;
+    } else if (fd != -1) {
+        close(fd);
+    }
+#else
+    (void)follower;
+#endif
+}
+
+static void _nsl_follower_wait(nsl_FileFollower *follower, i32 timeout_ms) {
+#if defined(__linux__)
+    if (follower->_watching) {
+        struct pollfd watch = {.fd = (int)follower->_watch, .events = POLLIN};
+        if (poll(&watch, 1, timeout_ms) <= 0) return;
+        // the events only wake the follower, the file is checked either way
+        char events[4096];
+        while (read((int)follower->_watch, events, sizeof(events)) > 0) continue;
+        return;
+    }
+#endif
+    poll(NULL, 0, timeout_ms < 0 ? 100 : timeout_ms);
+}
+
+NSL_API bool nsl_file_follower_next(nsl_FileFollower *follower, i32 timeout_ms, nsl_Str *line) {
+    NSL_ASSERT(follower->path.len < NSL_OS_PATH_MAX - 1 && "path too long");
+    char filepath[NSL_OS_PATH_MAX] = {0};
+    memcpy(filepath, follower->path.data, follower->path.len);
+    // the watch has to exist before the file is read to the end, or an append in between is missed
+    if (timeout_ms != 0 && !follower->_watching) _nsl_follower_watch(follower);
+
+    bool waited = false;
+    while (true) {
+        if (_nsl_follower_line(follower, line)) return true;
+
+        if (follower->_opened || _nsl_follower_open(follower, filepath)) {
+            const int fd = (int)follower->_file;
+            const usize size = _nsl_follower_reserve(follower);
+            const ssize_t n = read(fd, &follower->buffer[follower->end], size);
+            if (n == -1 && errno == EINTR) continue;
+            if (n > 0) {
+                follower->end += (usize)n;
+                follower->offset += (u64)n;
+                continue;
+            }
+
+            // at the end of the file: it might have been truncated or replaced
+            struct stat info;
+            if (fstat(fd, &info) == 0 && (u64)info.st_size < follower->offset) {
+                lseek(fd, 0, SEEK_SET);
+                follower->offset = 0;
+                follower->start = follower->end = 0;
+                continue;
+            }
+            const bool exists = stat(filepath, &info) == 0;
+            if (!exists || (u64)info.st_dev != follower->_id[0] || (u64)info.st_ino != follower->_id[1]) {
+                close(fd);
+                follower->_opened = false;
+                follower->offset = 0;
+                if (_nsl_follower_rest(follower, line)) return true;
+                if (exists) continue;
+            }
+        }
+
+        if (timeout_ms == 0 || (waited && 0 < timeout_ms)) return false;
+        _nsl_follower_wait(follower, timeout_ms);
+        waited = true;
+    }
+}
+
+NSL_API void nsl_file_follower_free(nsl_FileFollower *follower) {
+    if (follower->_opened) close((int)follower->_file);
+    if (follower->_watching) close((int)follower->_watch);
+    follower->_opened = follower->_watching = false;
+    nsl_arena_free_chunk(follower->arena, follower->buffer);
+    follower->buffer = NULL;
+    follower->start = follower->end = 0;
+}
+
+// room for the suffix of temporary files
+#define _NSL_TEMP_SUFFIX_MAX 32
+
+// temporary files can be created from several threads at once
+static u32 _nsl_temp_counter = 0;
+
+// creates a new file next to 'filepath' and stores its name in 'temp'
+static nsl_Error _nsl_file_write_temp(const char *filepath, nsl_Bytes content, bool sync, char *temp, u64 *device) {
+    errno = 0;
+    int fd = -1;
+    for (usize tries = 0; fd == -1 && tries < 100; tries++) {
+        snprintf(temp, NSL_OS_PATH_MAX, "%s.%ld-%u.tmp", filepath, (long)getpid(), __atomic_add_fetch(&_nsl_temp_counter, 1, __ATOMIC_RELAXED));
+        fd = open(temp, O_WRONLY | O_CREAT | O_EXCL, 0644);
+        if (fd == -1 && errno != EEXIST) break;
+    }
+    if (fd == -1) {
+        if (errno == ENOENT) return NSL_ERROR_FILE_NOT_FOUND;
+        if (errno == EACCES) return NSL_ERROR_ACCESS_DENIED;
+        return NSL_ERROR;
+    }
+
+    nsl_Error result = NSL_NO_ERROR;
+    // the rename replaces the mode of an existing file as well
+    struct stat target;
+    if (stat(filepath, &target) == 0 && fchmod(fd, target.st_mode & 07777) == -1) NSL_DEFER(NSL_ERROR);
+    for (usize len = 0; len < content.size;) {
+        const ssize_t n = write(fd, &content.data[len], content.size - len);
+        if (n == -1 && errno == EINTR) continue;
+        if (n == -1) NSL_DEFER(NSL_ERROR);
+        len += (usize)n;
+    }
+    struct stat info;
+    if (fstat(fd, &info) == -1) NSL_DEFER(NSL_ERROR);
+    *device = (u64)info.st_dev;
+    if (sync && fsync(fd) == -1) NSL_DEFER(NSL_ERROR);
+
+defer:
+    if (close(fd) == -1 && result == NSL_NO_ERROR) result = NSL_ERROR;
+    if (result) unlink(temp);
+    return result;
+}
+
+static nsl_Error _nsl_os_sync(const char *filepath) {
+    const int fd = open(filepath, O_RDONLY);
+    if (fd == -1) return NSL_ERROR;
+    const nsl_Error result = fsync(fd) == -1 ? NSL_ERROR : NSL_NO_ERROR;
+    close(fd);
+    return result;
 }
 
-NSL_API nsl_Error nsl_os_chdir(nsl_Path path) {
-    if (path.len >= NSL_OS_PATH_MAX - 1) return NSL_ERROR_PATH_TOO_LONG;
+// a rename is only durable once the directory is synced as well
+static nsl_Error _nsl_os_sync_parent(nsl_Path path) {
+    char dirpath[NSL_OS_PATH_MAX] = {0};
+    const nsl_Path parent = nsl_path_parent(path);
+    memcpy(dirpath, parent.data, parent.len);
+    return _nsl_os_sync(dirpath);
+}
 
-    errno = 0;
+static nsl_Error _nsl_os_rename_error(void) {
+    if (errno == EACCES) return NSL_ERROR_ACCESS_DENIED;
+    if (errno == EISDIR) return NSL_ERROR_IS_DIRECTORY;
+    if (errno == ENOENT) return NSL_ERROR_FILE_NOT_FOUND;
+    return NSL_ERROR;
+}
+
+NSL_API nsl_Error nsl_file_write_atomic(nsl_Path path, nsl_Bytes content) {
+    if (path.len >= NSL_OS_PATH_MAX - _NSL_TEMP_SUFFIX_MAX) return NSL_ERROR_PATH_TOO_LONG;
 
     char filepath[NSL_OS_PATH_MAX] = {0};
     memcpy(filepath, path.data, path.len);
-    filepath[path.len] = '\0';
-
-    if (chdir(filepath) != 0) {
-        if (errno == EACCES)  return NSL_ERROR_ACCESS_DENIED;
-        if (errno == ENOENT)  return NSL_ERROR_FILE_NOT_FOUND;
-        if (errno == ENOTDIR) return NSL_ERROR_NOT_DIRECTORY;
-        NSL_PANIC(strerror(errno));
-    }
 
-    return NSL_NO_ERROR;
-}
+    char temp[NSL_OS_PATH_MAX] = {0};
+    u64 device = 0;
+    nsl_Error error = _nsl_file_write_temp(filepath, content, true, temp, &device);
+    if (error) return error;
 
-NSL_API nsl_Path nsl_os_cwd(nsl_Arena *arena) {
-    errno = 0;
-    char *temp_path = getcwd(NULL, 0);
-    if (temp_path == NULL) {
-        NSL_PANIC(strerror(errno));
+    if (rename(temp, filepath) == -1) {
+        error = _nsl_os_rename_error();
+        unlink(temp);
+        return error;
     }
-    nsl_Path path = nsl_str_copy(nsl_str_from_cstr(temp_path), arena);
-    free(temp_path);
-    return path;
-}
-
-NSL_API nsl_Str nsl_os_getenv(const char *env, nsl_Arena* arena) {
-    const char *var = getenv(env);
-    return var ? nsl_str_copy(nsl_str_from_cstr(var), arena) : (nsl_Str){0};
+    return _nsl_os_sync_parent(path);
 }
 
-NSL_API bool nsl_os_exists(nsl_Path path) {
-    if (path.len >= NSL_OS_PATH_MAX - 1) return false;
+NSL_API nsl_Error nsl_file_batch_write(nsl_FileBatch *batch, nsl_Path path, nsl_Bytes content) {
+    if (path.len >= NSL_OS_PATH_MAX - _NSL_TEMP_SUFFIX_MAX) return NSL_ERROR_PATH_TOO_LONG;
 
     char filepath[NSL_OS_PATH_MAX] = {0};
     memcpy(filepath, path.data, path.len);
-    filepath[path.len] = '\0';
 
-    return access(filepath, 0) == 0;
+    char temp[NSL_OS_PATH_MAX] = {0};
+    u64 device = 0;
+    nsl_Error error = _nsl_file_write_temp(filepath, content, false, temp, &device);
+    if (error) return error;
+
+    nsl_AtomicWrite write = {
+        .path = nsl_str_copy(path, &batch->arena),
+        .temp = nsl_str_copy(nsl_str_from_cstr(temp), &batch->arena),
+        .device = device,
+    };
+    nsl_list_push(&batch->writes, write);
+    return NSL_NO_ERROR;
 }
 
-NSL_API bool nsl_os_is_dir(nsl_Path path) {
-    if (path.len >= NSL_OS_PATH_MAX - 1) return NSL_ERROR_PATH_TOO_LONG;
+// 'syncfs' writes everything on the file system, so one file per device is enough
+static nsl_Error _nsl_file_batch_sync(const nsl_FileBatch *batch, bool temp) {
+    nsl_Error result = NSL_NO_ERROR;
+    nsl_Arena scratch = {0};
+    nsl_List(nsl_Str) synced = {.arena = &scratch};
+    for (usize i = 0; i < batch->writes.len; i++) {
+        const nsl_AtomicWrite *write = &batch->writes.items[i];
+        const nsl_Path path = temp ? write->temp : nsl_path_parent(write->path);
+#if defined(SYS_syncfs)
+        const nsl_Str key = nsl_str_from_parts(sizeof(write->device), (const char *)&write->device);
+#else
+        // without 'syncfs' every file and every directory is synced once
+        const nsl_Str key = path;
+#endif
+        bool seen = false;
+        for (usize j = 0; j < synced.len && !seen; j++) {
+            seen = nsl_str_eq(synced.items[j], key);
+        }
+        if (seen) continue;
+        nsl_list_push(&synced, key);
+
+        nsl_Str filepath = nsl_str_copy(path, &scratch);
+#if defined(SYS_syncfs)
+        const int fd = open(filepath.data, O_RDONLY);
+        if (fd == -1 || syscall(SYS_syncfs, fd) == -1) result = NSL_ERROR;
+        if (fd != -1) close(fd);
+#else
+        if (_nsl_os_sync(filepath.data)) result = NSL_ERROR;
+#endif
+    }
+    nsl_arena_free(&scratch);
+    return result;
+}
 
-    char filepath[NSL_OS_PATH_MAX] = {0};
-    memcpy(filepath, path.data, path.len);
-    filepath[path.len] = '\0';
+NSL_API nsl_Error nsl_file_batch_commit(nsl_FileBatch *batch) {
+    nsl_Error result = _nsl_file_batch_sync(batch, true);
+    if (result) return result;
 
-    struct stat info;
-    if (stat(filepath, &info) == -1) {
-        return false;
+    bool *renamed = nsl_arena_alloc_chunk(NULL, batch->writes.len * sizeof(bool) + 1);
+    for (usize i = 0; i < batch->writes.len; i++) {
+        const nsl_AtomicWrite *write = &batch->writes.items[i];
+        renamed[i] = rename(write->temp.data, write->path.data) == 0;
+        if (!renamed[i] && result == NSL_NO_ERROR) result = _nsl_os_rename_error();
     }
+    const nsl_Error error = _nsl_file_batch_sync(batch, false);
+    if (result == NSL_NO_ERROR) result = error;
 
-    return S_ISDIR(info.st_mode);
+    // the temporary files that are left are removed by 'nsl_file_batch_free'
+    usize failed = 0;
+    for (usize i = 0; i < batch->writes.len; i++) {
+        if (!renamed[i]) batch->writes.items[failed++] = batch->writes.items[i];
+    }
+    batch->writes.len = failed;
+    nsl_arena_free_chunk(NULL, renamed);
+    if (failed == 0) nsl_arena_reset(&batch->arena);
+    return result;
 }
 
-NSL_API nsl_Error nsl_os_remove(nsl_Path path) {
+NSL_API nsl_Error nsl_writer_open(nsl_Path path, nsl_Writer *out) {
     if (path.len >= NSL_OS_PATH_MAX - 1) return NSL_ERROR_PATH_TOO_LONG;
 
     char filepath[NSL_OS_PATH_MAX] = {0};
     memcpy(filepath, path.data, path.len);
-    filepath[path.len] = '\0';
 
     errno = 0;
-    if (unlink(filepath) != 0) {
-        if (errno == EACCES) return NSL_ERROR_ACCESS_DENIED;
+    const int fd = open(filepath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) {
         if (errno == ENOENT) return NSL_ERROR_FILE_NOT_FOUND;
-        if (errno == EISDIR) return NSL_ERROR_NOT_DIRECTORY;
-        if (errno == EBUSY)  return NSL_ERROR_FILE_BUSY;
+        if (errno == EACCES) return NSL_ERROR_ACCESS_DENIED;
+        if (errno == EISDIR) return NSL_ERROR_IS_DIRECTORY;
         NSL_PANIC(strerror(errno));
     }
-
+    out->fd = fd;
     return NSL_NO_ERROR;
 }
 
-NSL_API bool nsl_os_older_than(nsl_Path p1, nsl_Path p2) {
-    if (p1.len >= NSL_OS_PATH_MAX - 1 || p1.len >= NSL_OS_PATH_MAX - 1) return false;
+static void _nsl_writer_write_all(nsl_Writer *writer, usize count, struct iovec *vec) {
+    while (count) {
+        const ssize_t n = writev(writer->fd, vec, (int)count);
+        if (n == -1 && errno == EINTR) continue;
+        if (n == -1) {
+            writer->error = NSL_ERROR;
+            return;
+        }
+        // skips what was written, a partial write continues inside a segment
+        usize written = (usize)n;
+        while (count && vec->iov_len <= written) {
+            written -= vec->iov_len;
+            vec++, count--;
+        }
+        if (count) {
+            vec->iov_base = (u8 *)vec->iov_base + written;
+            vec->iov_len -= written;
+        }
+    }
+}
+
+NSL_API void nsl_writer_writev(nsl_Writer *writer, usize count, const nsl_Bytes *parts) {
+    bool buffered = writer->len != 0;
+    usize next = 0;
+    while (!writer->error && (buffered || next < count)) {
+        struct iovec vec[64];
+        usize len = 0;
+        if (buffered) {
+            vec[len].iov_base = writer->buffer;
+            vec[len++].iov_len = writer->len;
+            buffered = false;
+        }
+        for (; next < count && len < NSL_ARRAY_LEN(vec); next++) {
+            if (parts[next].size == 0) continue;
+            vec[len].iov_base = (void *)(usize)parts[next].data;
+            vec[len++].iov_len = parts[next].size;
+        }
+        _nsl_writer_write_all(writer, len, vec);
+    }
+    writer->len = 0;
+}
+
+NSL_API nsl_Error nsl_writer_close(nsl_Writer *writer) {
+    nsl_Error error = nsl_writer_free(writer);
+    if (close(writer->fd) == -1 && error == NSL_NO_ERROR) error = NSL_ERROR;
+    writer->fd = -1;
+    return error;
+}
+
+NSL_API nsl_Error nsl_record_writer_append(nsl_Path path, nsl_RecordWriter *out) {
+    nsl_Error error = _nsl_record_writer_load(path, out);
+    if (error) return error;
 
     char filepath[NSL_OS_PATH_MAX] = {0};
-    struct stat info[2];
+    memcpy(filepath, path.data, path.len);
 
-    memcpy(filepath, p1.data, p1.len);
-    filepath[p1.len] = '\0';
-    if (stat(filepath, &info[0]) == -1) return false;
+    errno = 0;
+    const int fd = open(filepath, O_WRONLY);
+    if (fd == -1 || lseek(fd, (off_t)out->offset, SEEK_SET) == -1) {
+        if (errno == ENOENT) error = NSL_ERROR_FILE_NOT_FOUND;
+        else if (errno == EACCES) error = NSL_ERROR_ACCESS_DENIED;
+        else error = NSL_ERROR;
+        if (fd != -1) close(fd);
+        nsl_list_free(&out->index);
+        return error;
+    }
+    out->writer.fd = fd;
+    _nsl_record_writer_align(out);
+    return NSL_NO_ERROR;
+}
 
-    memcpy(filepath, p1.data, p1.len);
-    filepath[p2.len] = '\0';
-    if (stat(filepath, &info[1]) == -1) return false;
+NSL_API void nsl_io_perform(nsl_IoQueue *queue, nsl_IoRequest *request) {
+    nsl_Error result = NSL_NO_ERROR;
+    int fd = -1;
+    if (request->path.len >= NSL_OS_PATH_MAX - 1) NSL_DEFER(NSL_ERROR_PATH_TOO_LONG);
 
-    return info[0].st_mtime < info[1].st_mtime;
+    char filepath[NSL_OS_PATH_MAX] = {0};
+    memcpy(filepath, request->path.data, request->path.len);
+
+    int flags = O_RDONLY;
+    if (request->op == NSL_IO_WRITE)  flags = O_WRONLY | O_CREAT | O_TRUNC;
+    if (request->op == NSL_IO_APPEND) flags = O_WRONLY | O_CREAT | O_APPEND;
+    fd = open(filepath, flags, 0644);
+    if (fd == -1) {
+        if (errno == ENOENT) NSL_DEFER(NSL_ERROR_FILE_NOT_FOUND);
+        if (errno == EACCES) NSL_DEFER(NSL_ERROR_ACCESS_DENIED);
+        if (errno == EISDIR) NSL_DEFER(NSL_ERROR_IS_DIRECTORY);
+        NSL_DEFER(NSL_ERROR);
+    }
+
+    if (request->op == NSL_IO_READ) {
+        struct stat info;
+        if (fstat(fd, &info) == -1 || !S_ISREG(info.st_mode)) NSL_DEFER(NSL_ERROR);
+        const usize size = (usize)info.st_size;
+        u8 *data = _nsl_io_alloc(queue, size + 1);
+        usize len = 0;
+        while (len < size) {
+            const ssize_t n = read(fd, &data[len], size - len);
+            if (n == -1 && errno == EINTR) continue;
+            if (n == -1) NSL_DEFER(NSL_ERROR);
+            if (n == 0) break;
+            len += (usize)n;
+        }
+        data[len] = '\0';
+        request->data = nsl_bytes_from_parts(len, data);
+    } else {
+        for (usize len = 0; len < request->data.size;) {
+            const ssize_t n = write(fd, &request->data.data[len], request->data.size - len);
+            if (n == -1 && errno == EINTR) continue;
+            if (n == -1) NSL_DEFER(NSL_ERROR);
+            len += (usize)n;
+        }
+    }
+
+defer:
+    if (fd != -1) close(fd);
+    request->error = result;
 }
 
 #elif defined(NSL_WIN32)
@@ -2790,11 +8010,18 @@ NSL_API nsl_DirEntry* nsl_dir_next(nsl_DirIter *it) {
 }
 
 NSL_API nsl_Error nsl_dll_load(nsl_Dll *dll, nsl_Path path) {
+    char lib_path[MAX_PATH] = {0};
+    memcpy(lib_path, path.data, nsl_usize_min(path.len, MAX_PATH - 1));
+
+    if (nsl_str_find_by_predicate(path, nsl_char_is_path_delimiter) == NSL_STR_NOT_FOUND) {
+        // the system dlls can not be copied, they are searched by the loader
+        dll->handle = LoadLibraryA(lib_path);
+        dll->_copy = false;
+        return dll->handle ? NSL_NO_ERROR : NSL_ERROR_FILE_NOT_FOUND;
+    }
     if (!nsl_os_exists(path)) {
         return NSL_ERROR_FILE_NOT_FOUND;
     }
-    char lib_path[MAX_PATH] = {0};
-    memcpy(lib_path, path.data, nsl_usize_max(path.len, FILENAME_MAX));
 
     char temp_path[MAX_PATH];
     GetTempPathA(MAX_PATH, temp_path);
@@ -2804,6 +8031,7 @@ NSL_API nsl_Error nsl_dll_load(nsl_Dll *dll, nsl_Path path) {
     CopyFile(lib_path, temp_file_name, 0);
 
     dll->handle = LoadLibraryA(temp_file_name);
+    dll->_copy = true;
     if (dll->handle == NULL) {
         DWORD ec = GetLastError();
         if (ec == ERROR_FILE_NOT_FOUND) return NSL_ERROR_FILE_NOT_FOUND;
@@ -2827,7 +8055,7 @@ NSL_API void nsl_dll_close(nsl_Dll *dll) {
   char temp_file_name[MAX_PATH];
   GetModuleFileNameA(dll->handle, temp_file_name, MAX_PATH);
   FreeLibrary(dll->handle);
-  DeleteFileA(temp_file_name);
+  if (dll->_copy) DeleteFileA(temp_file_name);
 }
 
 NSL_API nsl_Function nsl_dll_symbol(nsl_Dll *dll, nsl_Str symbol) {
@@ -2956,6 +8184,12 @@ NSL_API nsl_Str nsl_os_getenv(const char *env, nsl_Arena *arena) {
     return result;
 }
 
+NSL_API usize nsl_os_cpu_count(void) {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors < 1 ? 1 : (usize)info.dwNumberOfProcessors;
+}
+
 NSL_API bool nsl_os_exists(nsl_Path path) {
     if (path.len >= NSL_OS_PATH_MAX - 1) return false;
 
@@ -3032,6 +8266,399 @@ defer:
     return result;
 }
 
+NSL_API nsl_Error nsl_file_map(nsl_Path path, nsl_FileMap *out) {
+    if (path.len >= NSL_OS_PATH_MAX - 1) return NSL_ERROR_PATH_TOO_LONG;
+
+    char filepath[NSL_OS_PATH_MAX] = {0};
+    memcpy(filepath, path.data, path.len);
+
+    HANDLE file = CreateFile(filepath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        DWORD ec = GetLastError();
+        if (ec == ERROR_FILE_NOT_FOUND) return NSL_ERROR_FILE_NOT_FOUND;
+        if (ec == ERROR_PATH_NOT_FOUND) return NSL_ERROR_FILE_NOT_FOUND;
+        if (ec == ERROR_ACCESS_DENIED)  return NSL_ERROR_ACCESS_DENIED;
+        return NSL_ERROR;
+    }
+
+    nsl_Error result = NSL_NO_ERROR;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) NSL_DEFER(NSL_ERROR);
+
+    *out = (nsl_FileMap){0};
+    if (size.QuadPart == 0) NSL_DEFER(NSL_NO_ERROR);
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL) NSL_DEFER(NSL_ERROR);
+
+    void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == NULL) {
+        CloseHandle(mapping);
+        NSL_DEFER(NSL_ERROR);
+    }
+    out->bytes = nsl_bytes_from_parts((usize)size.QuadPart, data);
+    out->_handle = mapping;
+
+defer:
+    CloseHandle(file);
+    return result;
+}
+
+NSL_API void nsl_file_map_advise(const nsl_FileMap *map, nsl_FileMapAdvice advice) {
+    (void)map;
+    (void)advice;
+}
+
+NSL_API void nsl_file_unmap(nsl_FileMap *map) {
+    if (map->bytes.size) {
+        UnmapViewOfFile(map->bytes.data);
+        CloseHandle(map->_handle);
+    }
+    *map = (nsl_FileMap){0};
+}
+
+NSL_API nsl_Error nsl_os_copy_file_conf(nsl_Path src, nsl_Path dst, nsl_OsCopyConfig config) {
+    if (src.len >= NSL_OS_PATH_MAX - 1) return NSL_ERROR_PATH_TOO_LONG;
+    if (dst.len >= NSL_OS_PATH_MAX - 1) return NSL_ERROR_PATH_TOO_LONG;
+
+    char srcpath[NSL_OS_PATH_MAX] = {0};
+    memcpy(srcpath, src.data, src.len);
+    char dstpath[NSL_OS_PATH_MAX] = {0};
+    memcpy(dstpath, dst.data, dst.len);
+
+    // the copy stays inside the system and uses block cloning where the file system supports it
+    if (!CopyFileA(srcpath, dstpath, !config.overwrite)) {
+        DWORD ec = GetLastError();
+        if (ec == ERROR_FILE_NOT_FOUND) return NSL_ERROR_FILE_NOT_FOUND;
+        if (ec == ERROR_PATH_NOT_FOUND) return NSL_ERROR_FILE_NOT_FOUND;
+        if (ec == ERROR_FILE_EXISTS)    return NSL_ERROR_ALREADY_EXISTS;
+        if (ec == ERROR_ACCESS_DENIED)  return NSL_ERROR_ACCESS_DENIED;
+        return NSL_ERROR;
+    }
+    return NSL_NO_ERROR;
+}
+
+static HANDLE _nsl_follower_handle(const char *filepath, u64 *id) {
+    const DWORD share = FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE;
+    HANDLE file = CreateFile(filepath, GENERIC_READ, share, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return file;
+    BY_HANDLE_FILE_INFORMATION info;
+    if (!GetFileInformationByHandle(file, &info)) {
+        CloseHandle(file);
+        return INVALID_HANDLE_VALUE;
+    }
+    id[0] = info.dwVolumeSerialNumber;
+    id[1] = ((u64)info.nFileIndexHigh << 32) | info.nFileIndexLow;
+    return file;
+}
+
+// watches the directory, so a file that replaces the followed one is noticed as well
+static void _nsl_follower_watch(nsl_FileFollower *follower) {
+    char dirpath[NSL_OS_PATH_MAX] = {0};
+    const nsl_Path parent = nsl_path_parent(follower->path);
+    memcpy(dirpath, parent.data, parent.len);
+    const DWORD filter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE;
+    HANDLE watch = FindFirstChangeNotificationA(dirpath, FALSE, filter);
+    if (watch != INVALID_HANDLE_VALUE) {
+        follower->_watch = (isize)watch;
+        follower->_watching = true;
+    }
+}
+
+static void _nsl_follower_wait(nsl_FileFollower *follower, i32 timeout_ms) {
+    if (follower->_watching) {
+        HANDLE watch = (HANDLE)follower->_watch;
+        if (WaitForSingleObject(watch, timeout_ms < 0 ? INFINITE : (DWORD)timeout_ms) == WAIT_OBJECT_0) {
+            FindNextChangeNotification(watch);
+        }
+        return;
+    }
+    Sleep(timeout_ms < 0 ? 100 : (DWORD)timeout_ms);
+}
+
+NSL_API bool nsl_file_follower_next(nsl_FileFollower *follower, i32 timeout_ms, nsl_Str *line) {
+    NSL_ASSERT(follower->path.len < NSL_OS_PATH_MAX - 1 && "path too long");
+    char filepath[NSL_OS_PATH_MAX] = {0};
+    memcpy(filepath, follower->path.data, follower->path.len);
+    // the watch has to exist before the file is read to the end, or an append in between is missed
+    if (timeout_ms != 0 && !follower->_watching) _nsl_follower_watch(follower);
+
+    bool waited = false;
+    while (true) {
+        if (_nsl_follower_line(follower, line)) return true;
+
+        if (!follower->_opened) {
+            HANDLE file = _nsl_follower_handle(filepath, follower->_id);
+            follower->_opened = file != INVALID_HANDLE_VALUE;
+            follower->_file = (isize)file;
+        }
+        if (follower->_opened) {
+            HANDLE file = (HANDLE)follower->_file;
+            const usize size = _nsl_follower_reserve(follower);
+            // reads at the offset, like 'pread'
+            OVERLAPPED at = {0};
+            at.Offset = (DWORD)follower->offset;
+            at.OffsetHigh = (DWORD)(follower->offset >> 32);
+            DWORD n = 0;
+            const DWORD chunk = (DWORD)nsl_usize_min(size, 1u << 30);
+            if (ReadFile(file, &follower->buffer[follower->end], chunk, &n, &at) && n > 0) {
+                follower->end += n;
+                follower->offset += n;
+                continue;
+            }
+
+            // at the end of the file: it might have been truncated or replaced
+            LARGE_INTEGER file_size;
+            if (GetFileSizeEx(file, &file_size) && (u64)file_size.QuadPart < follower->offset) {
+                follower->offset = 0;
+                follower->start = follower->end = 0;
+                continue;
+            }
+            u64 id[2] = {0};
+            HANDLE current = _nsl_follower_handle(filepath, id);
+            const bool exists = current != INVALID_HANDLE_VALUE;
+            if (exists) CloseHandle(current);
+            if (!exists || id[0] != follower->_id[0] || id[1] != follower->_id[1]) {
+                CloseHandle(file);
+                follower->_opened = false;
+                follower->offset = 0;
+                if (_nsl_follower_rest(follower, line)) return true;
+                if (exists) continue;
+            }
+        }
+
+        if (timeout_ms == 0 || (waited && 0 < timeout_ms)) return false;
+        _nsl_follower_wait(follower, timeout_ms);
+        waited = true;
+    }
+}
+
+NSL_API void nsl_file_follower_free(nsl_FileFollower *follower) {
+    if (follower->_opened) CloseHandle((HANDLE)follower->_file);
+    if (follower->_watching) FindCloseChangeNotification((HANDLE)follower->_watch);
+    follower->_opened = follower->_watching = false;
+    nsl_arena_free_chunk(follower->arena, follower->buffer);
+    follower->buffer = NULL;
+    follower->start = follower->end = 0;
+}
+
+// room for the suffix of temporary files
+#define _NSL_TEMP_SUFFIX_MAX 32
+// temporary files can be created from several threads at once
+static volatile LONG _nsl_temp_counter = 0;
+
+// creates a new file next to 'filepath' and stores its name in 'temp'
+static nsl_Error _nsl_file_write_temp(const char *filepath, nsl_Bytes content, bool sync, char *temp) {
+    HANDLE file = INVALID_HANDLE_VALUE;
+    for (usize tries = 0; file == INVALID_HANDLE_VALUE && tries < 100; tries++) {
+        snprintf(temp, NSL_OS_PATH_MAX, "%s.%lu-%lu.tmp", filepath, GetCurrentProcessId(), (unsigned long)InterlockedIncrement(&_nsl_temp_counter));
+        file = CreateFile(temp, GENERIC_WRITE, 0, NULL, CREATE_NEW, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE && GetLastError() != ERROR_FILE_EXISTS) break;
+    }
+    if (file == INVALID_HANDLE_VALUE) {
+        DWORD ec = GetLastError();
+        if (ec == ERROR_PATH_NOT_FOUND) return NSL_ERROR_FILE_NOT_FOUND;
+        if (ec == ERROR_ACCESS_DENIED)  return NSL_ERROR_ACCESS_DENIED;
+        return NSL_ERROR;
+    }
+
+    nsl_Error result = NSL_NO_ERROR;
+    for (usize len = 0; len < content.size;) {
+        DWORD n = 0;
+        const DWORD chunk = (DWORD)nsl_usize_min(content.size - len, 1u << 30);
+        if (!WriteFile(file, &content.data[len], chunk, &n, NULL)) NSL_DEFER(NSL_ERROR);
+        len += n;
+    }
+    if (sync && !FlushFileBuffers(file)) NSL_DEFER(NSL_ERROR);
+
+defer:
+    CloseHandle(file);
+    if (result) DeleteFileA(temp);
+    return result;
+}
+
+static nsl_Error _nsl_os_rename_error(void) {
+    DWORD ec = GetLastError();
+    if (ec == ERROR_ACCESS_DENIED)  return NSL_ERROR_ACCESS_DENIED;
+    if (ec == ERROR_PATH_NOT_FOUND) return NSL_ERROR_FILE_NOT_FOUND;
+    return NSL_ERROR;
+}
+
+NSL_API nsl_Error nsl_file_write_atomic(nsl_Path path, nsl_Bytes content) {
+    if (path.len >= NSL_OS_PATH_MAX - _NSL_TEMP_SUFFIX_MAX) return NSL_ERROR_PATH_TOO_LONG;
+
+    char filepath[NSL_OS_PATH_MAX] = {0};
+    memcpy(filepath, path.data, path.len);
+
+    char temp[NSL_OS_PATH_MAX] = {0};
+    nsl_Error error = _nsl_file_write_temp(filepath, content, true, temp);
+    if (error) return error;
+
+    if (!MoveFileExA(temp, filepath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        error = _nsl_os_rename_error();
+        DeleteFileA(temp);
+        return error;
+    }
+    return NSL_NO_ERROR;
+}
+
+NSL_API nsl_Error nsl_file_batch_write(nsl_FileBatch *batch, nsl_Path path, nsl_Bytes content) {
+    if (path.len >= NSL_OS_PATH_MAX - _NSL_TEMP_SUFFIX_MAX) return NSL_ERROR_PATH_TOO_LONG;
+
+    char filepath[NSL_OS_PATH_MAX] = {0};
+    memcpy(filepath, path.data, path.len);
+
+    char temp[NSL_OS_PATH_MAX] = {0};
+    nsl_Error error = _nsl_file_write_temp(filepath, content, false, temp);
+    if (error) return error;
+
+    nsl_AtomicWrite write = {
+        .path = nsl_str_copy(path, &batch->arena),
+        .temp = nsl_str_copy(nsl_str_from_cstr(temp), &batch->arena),
+    };
+    nsl_list_push(&batch->writes, write);
+    return NSL_NO_ERROR;
+}
+
+NSL_API nsl_Error nsl_file_batch_commit(nsl_FileBatch *batch) {
+    // there is no unprivileged volume flush, every file is flushed on its own
+    for (usize i = 0; i < batch->writes.len; i++) {
+        const nsl_AtomicWrite *write = &batch->writes.items[i];
+        HANDLE file = CreateFile(write->temp.data, GENERIC_WRITE, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE) return NSL_ERROR;
+        const bool flushed = FlushFileBuffers(file);
+        CloseHandle(file);
+        if (!flushed) return NSL_ERROR;
+    }
+
+    nsl_Error result = NSL_NO_ERROR;
+    usize failed = 0;
+    for (usize i = 0; i < batch->writes.len; i++) {
+        const nsl_AtomicWrite write = batch->writes.items[i];
+        const DWORD flags = MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH;
+        if (MoveFileExA(write.temp.data, write.path.data, flags)) continue;
+        if (result == NSL_NO_ERROR) result = _nsl_os_rename_error();
+        // the temporary files that are left are removed by 'nsl_file_batch_free'
+        batch->writes.items[failed++] = write;
+    }
+
+    batch->writes.len = failed;
+    if (failed == 0) nsl_arena_reset(&batch->arena);
+    return result;
+}
+
+NSL_API nsl_Error nsl_writer_open(nsl_Path path, nsl_Writer *out) {
+    if (path.len >= NSL_OS_PATH_MAX - 1) return NSL_ERROR_PATH_TOO_LONG;
+
+    char filepath[NSL_OS_PATH_MAX] = {0};
+    memcpy(filepath, path.data, path.len);
+
+    errno = 0;
+    const int fd = _open(filepath, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+    if (fd == -1) {
+        if (errno == ENOENT) return NSL_ERROR_FILE_NOT_FOUND;
+        if (errno == EACCES) return NSL_ERROR_ACCESS_DENIED;
+        NSL_PANIC(strerror(errno));
+    }
+    out->fd = fd;
+    return NSL_NO_ERROR;
+}
+
+static void _nsl_writer_write_all(nsl_Writer *writer, nsl_Bytes bytes) {
+    for (usize len = 0; !writer->error && len < bytes.size;) {
+        const int n = _write(writer->fd, &bytes.data[len], (unsigned)nsl_usize_min(bytes.size - len, 1u << 30));
+        if (n <= 0) writer->error = NSL_ERROR;
+        else len += (usize)n;
+    }
+}
+
+NSL_API void nsl_writer_writev(nsl_Writer *writer, usize count, const nsl_Bytes *parts) {
+    // no vectored writes for file descriptors
+    _nsl_writer_write_all(writer, nsl_bytes_from_parts(writer->len, writer->buffer));
+    for (usize i = 0; i < count; i++) {
+        _nsl_writer_write_all(writer, parts[i]);
+    }
+    writer->len = 0;
+}
+
+NSL_API nsl_Error nsl_writer_close(nsl_Writer *writer) {
+    nsl_Error error = nsl_writer_free(writer);
+    if (_close(writer->fd) == -1 && error == NSL_NO_ERROR) error = NSL_ERROR;
+    writer->fd = -1;
+    return error;
+}
+
+NSL_API nsl_Error nsl_record_writer_append(nsl_Path path, nsl_RecordWriter *out) {
+    nsl_Error error = _nsl_record_writer_load(path, out);
+    if (error) return error;
+
+    char filepath[NSL_OS_PATH_MAX] = {0};
+    memcpy(filepath, path.data, path.len);
+
+    errno = 0;
+    const int fd = _open(filepath, _O_WRONLY | _O_BINARY);
+    if (fd == -1 || _lseeki64(fd, (i64)out->offset, SEEK_SET) == -1) {
+        if (errno == ENOENT) error = NSL_ERROR_FILE_NOT_FOUND;
+        else if (errno == EACCES) error = NSL_ERROR_ACCESS_DENIED;
+        else error = NSL_ERROR;
+        if (fd != -1) _close(fd);
+        nsl_list_free(&out->index);
+        return error;
+    }
+    out->writer.fd = fd;
+    _nsl_record_writer_align(out);
+    return NSL_NO_ERROR;
+}
+
+NSL_API void nsl_io_perform(nsl_IoQueue *queue, nsl_IoRequest *request) {
+    nsl_Error result = NSL_NO_ERROR;
+    HANDLE file = INVALID_HANDLE_VALUE;
+    if (request->path.len >= NSL_OS_PATH_MAX - 1) NSL_DEFER(NSL_ERROR_PATH_TOO_LONG);
+
+    char filepath[NSL_OS_PATH_MAX] = {0};
+    memcpy(filepath, request->path.data, request->path.len);
+
+    DWORD access = GENERIC_READ;
+    DWORD disposition = OPEN_EXISTING;
+    if (request->op == NSL_IO_WRITE)  access = GENERIC_WRITE, disposition = CREATE_ALWAYS;
+    if (request->op == NSL_IO_APPEND) access = FILE_APPEND_DATA, disposition = OPEN_ALWAYS;
+    file = CreateFile(filepath, access, FILE_SHARE_READ, NULL, disposition, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        DWORD ec = GetLastError();
+        if (ec == ERROR_FILE_NOT_FOUND) NSL_DEFER(NSL_ERROR_FILE_NOT_FOUND);
+        if (ec == ERROR_PATH_NOT_FOUND) NSL_DEFER(NSL_ERROR_FILE_NOT_FOUND);
+        if (ec == ERROR_ACCESS_DENIED)  NSL_DEFER(NSL_ERROR_ACCESS_DENIED);
+        NSL_DEFER(NSL_ERROR);
+    }
+
+    if (request->op == NSL_IO_READ) {
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) NSL_DEFER(NSL_ERROR);
+        u8 *data = _nsl_io_alloc(queue, (usize)size.QuadPart + 1);
+        usize len = 0;
+        while (len < (usize)size.QuadPart) {
+            DWORD n = 0;
+            const DWORD chunk = (DWORD)nsl_usize_min((usize)size.QuadPart - len, 1u << 30);
+            if (!ReadFile(file, &data[len], chunk, &n, NULL)) NSL_DEFER(NSL_ERROR);
+            if (n == 0) break;
+            len += n;
+        }
+        data[len] = '\0';
+        request->data = nsl_bytes_from_parts(len, data);
+    } else {
+        for (usize len = 0; len < request->data.size;) {
+            DWORD n = 0;
+            const DWORD chunk = (DWORD)nsl_usize_min(request->data.size - len, 1u << 30);
+            if (!WriteFile(file, &request->data.data[len], chunk, &n, NULL)) NSL_DEFER(NSL_ERROR);
+            len += n;
+        }
+    }
+
+defer:
+    if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+    request->error = result;
+}
+
 #else
 #   error "unknown platform"
 #endif
@@ -0,0 +1,147 @@
+#include "../nsl.h"
+
+static void test_init(void) {
+    nsl_BitSet set = {0};
+    NSL_ASSERT(nsl_bitset_test(&set, 0) == false);
+    NSL_ASSERT(nsl_bitset_count(&set) == 0);
+
+    nsl_bitset_set(&set, 3);
+    nsl_bitset_set(&set, 64);
+    nsl_bitset_set(&set, 1000);
+    NSL_ASSERT(nsl_bitset_test(&set, 3));
+    NSL_ASSERT(nsl_bitset_test(&set, 64));
+    NSL_ASSERT(nsl_bitset_test(&set, 1000));
+    NSL_ASSERT(nsl_bitset_test(&set, 4) == false);
+    NSL_ASSERT(nsl_bitset_test(&set, 100000) == false);
+    NSL_ASSERT(nsl_bitset_count(&set) == 3);
+
+    nsl_bitset_clear(&set, 64);
+    nsl_bitset_clear(&set, 100000);
+    NSL_ASSERT(nsl_bitset_test(&set, 64) == false);
+    NSL_ASSERT(nsl_bitset_count(&set) == 2);
+
+    nsl_bitset_clear_all(&set);
+    NSL_ASSERT(nsl_bitset_count(&set) == 0);
+    NSL_ASSERT(nsl_bitset_test(&set, 1000) == false);
+
+    nsl_bitset_free(&set);
+}
+
+static void test_rank_select(void) {
+    nsl_BitSet set = {0};
+    for (usize i = 0; i < 1000; i += 3) {
+        nsl_bitset_set(&set, i);
+    }
+
+    NSL_ASSERT(nsl_bitset_rank(&set, 0) == 0);
+    NSL_ASSERT(nsl_bitset_rank(&set, 1) == 1);
+    NSL_ASSERT(nsl_bitset_rank(&set, 64) == 22);
+    NSL_ASSERT(nsl_bitset_rank(&set, 999) == 333);
+    NSL_ASSERT(nsl_bitset_rank(&set, 100000) == 334);
+
+    usize idx = 0;
+    NSL_ASSERT(nsl_bitset_select(&set, 0, &idx) && idx == 0);
+    NSL_ASSERT(nsl_bitset_select(&set, 22, &idx) && idx == 66);
+    NSL_ASSERT(nsl_bitset_select(&set, 333, &idx) && idx == 999);
+    NSL_ASSERT(nsl_bitset_select(&set, 334, &idx) == false);
+
+    usize count = 0;
+    for (usize i = 0; nsl_bitset_next(&set, &i); i++) {
+        NSL_ASSERT(i == count * 3);
+        NSL_ASSERT(nsl_bitset_rank(&set, i) == count);
+        count++;
+    }
+    NSL_ASSERT(count == 334);
+
+    nsl_bitset_free(&set);
+}
+
+static void test_set_algebra(void) {
+    nsl_BitSet evens = {0};
+    nsl_BitSet threes = {0};
+    for (usize i = 0; i < 2000; i += 2) nsl_bitset_set(&evens, i);
+    for (usize i = 0; i < 900; i += 3) nsl_bitset_set(&threes, i);
+
+    nsl_BitSet out = {0};
+    nsl_bitset_intersection(&evens, &threes, &out);
+    for (usize i = 0; i < 2100; i++) {
+        NSL_ASSERT(nsl_bitset_test(&out, i) == (i % 6 == 0 && i < 900));
+    }
+
+    nsl_bitset_union(&evens, &threes, &out);
+    for (usize i = 0; i < 2100; i++) {
+        NSL_ASSERT(nsl_bitset_test(&out, i) == ((i % 2 == 0 && i < 2000) || (i % 3 == 0 && i < 900)));
+    }
+
+    nsl_bitset_difference(&threes, &evens, &out);
+    for (usize i = 0; i < 2100; i++) {
+        NSL_ASSERT(nsl_bitset_test(&out, i) == (i % 3 == 0 && i % 2 == 1 && i < 900));
+    }
+
+    nsl_bitset_symmetric_difference(&evens, &threes, &out);
+    for (usize i = 0; i < 2100; i++) {
+        const bool even = i % 2 == 0 && i < 2000;
+        const bool three = i % 3 == 0 && i < 900;
+        NSL_ASSERT(nsl_bitset_test(&out, i) == (even != three));
+    }
+
+    nsl_bitset_intersection(&evens, &threes, &evens);
+    NSL_ASSERT(nsl_bitset_count(&evens) == 150);
+    nsl_bitset_difference(&threes, &evens, &evens);
+    NSL_ASSERT(nsl_bitset_count(&evens) == 150);
+    NSL_ASSERT(nsl_bitset_test(&evens, 3) && !nsl_bitset_test(&evens, 6));
+
+    nsl_BitSet copy = {0};
+    nsl_bitset_union(&evens, &copy, &copy);
+    nsl_bitset_set(&copy, 5000);
+    nsl_bitset_clear(&copy, 5000);
+    NSL_ASSERT(nsl_bitset_eq(&copy, &evens));
+    nsl_bitset_set(&copy, 0);
+    NSL_ASSERT(nsl_bitset_eq(&copy, &evens) == false);
+
+    nsl_bitset_free(&evens);
+    nsl_bitset_free(&threes);
+    nsl_bitset_free(&out);
+    nsl_bitset_free(&copy);
+}
+
+static void test_set_algebra_in_place(void) {
+    nsl_BitSet large = {0};
+    nsl_bitset_set(&large, 3);
+    nsl_bitset_set(&large, 1000);
+
+    // 'out' is 'set' and the shorter one
+    nsl_BitSet a = {0};
+    nsl_bitset_set(&a, 3);
+    nsl_bitset_union(&a, &large, &a);
+    NSL_ASSERT(nsl_bitset_test(&a, 1000) && nsl_bitset_count(&a) == 2);
+
+    nsl_BitSet b = {0};
+    nsl_bitset_set(&b, 5);
+    nsl_bitset_symmetric_difference(&b, &large, &b);
+    NSL_ASSERT(nsl_bitset_test(&b, 1000) && nsl_bitset_count(&b) == 3);
+
+    // 'out' is 'other' and the shorter one
+    nsl_BitSet c = {0};
+    nsl_bitset_set(&c, 3);
+    nsl_bitset_union(&large, &c, &c);
+    NSL_ASSERT(nsl_bitset_test(&c, 1000) && nsl_bitset_count(&c) == 2);
+
+    nsl_BitSet d = {0};
+    nsl_bitset_set(&d, 3);
+    nsl_bitset_symmetric_difference(&large, &d, &d);
+    NSL_ASSERT(nsl_bitset_test(&d, 1000) && !nsl_bitset_test(&d, 3) && nsl_bitset_count(&d) == 1);
+
+    nsl_bitset_free(&large);
+    nsl_bitset_free(&a);
+    nsl_bitset_free(&b);
+    nsl_bitset_free(&c);
+    nsl_bitset_free(&d);
+}
+
+int main(void) {
+    test_init();
+    test_rank_select();
+    test_set_algebra();
+    test_set_algebra_in_place();
+}
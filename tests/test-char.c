@@ -1,5 +1,7 @@
 #include "../nsl.h"
 
+#include <ctype.h>
+
 static void test_char_test(void) {
     NSL_ASSERT(nsl_char_is_alnum('a') == true && "Did not test correctly");
     NSL_ASSERT(nsl_char_is_alnum('A') == true && "Did not test correctly");
@@ -48,6 +50,40 @@ static void test_char_test(void) {
     NSL_ASSERT(nsl_char_is_xdigit('z') == false && "Did not test correctly");
 }
 
+static void test_char_table(void) {
+    for (i32 i = 0; i < 128; i++) {
+        const char c = (char)i;
+        NSL_ASSERT(nsl_char_is_alnum(c) == (isalnum(i) != 0) && "Did not test correctly");
+        NSL_ASSERT(nsl_char_is_space(c) == (isspace(i) != 0) && "Did not test correctly");
+        NSL_ASSERT(nsl_char_is_punct(c) == (ispunct(i) != 0) && "Did not test correctly");
+        NSL_ASSERT(nsl_char_is_print(c) == (isprint(i) != 0) && "Did not test correctly");
+        NSL_ASSERT(nsl_char_is_xdigit(c) == (isxdigit(i) != 0) && "Did not test correctly");
+        NSL_ASSERT(nsl_char_to_lower(c) == (char)tolower(i) && "Did not convert correctly");
+        NSL_ASSERT(nsl_char_to_upper(c) == (char)toupper(i) && "Did not convert correctly");
+    }
+
+    NSL_ASSERT(nsl_char_is_alpha((char)0xe4) == false && "Did not test correctly");
+    NSL_ASSERT(nsl_char_is_print((char)0xff) == false && "Did not test correctly");
+    NSL_ASSERT(nsl_char_is('_', NSL_CHAR_PUNCT | NSL_CHAR_DIGIT) == true && "Did not test correctly");
+}
+
+static void test_char_classify(void) {
+    const char *s = "Hello World\t42 is the answer, or is it? \xff";
+    const usize len = strlen(s);
+
+    const u32 mask = nsl_char_classify(len, s, NSL_CHAR_SPACE);
+    for (usize i = 0; i < 32; i++) {
+        const bool bit = (mask >> i) & 1;
+        NSL_ASSERT(bit == nsl_char_is_space(s[i]) && "Did not classify correctly");
+    }
+
+    const u32 digits = nsl_char_classify(len, s, NSL_CHAR_DIGIT);
+    NSL_ASSERT(digits == 0x3000 && "Did not classify correctly");
+
+    const u32 short_mask = nsl_char_classify(5, s, NSL_CHAR_ALPHA);
+    NSL_ASSERT(short_mask == 0x1f && "Did not respect length");
+}
+
 static void test_char_convertion(void) {
     NSL_ASSERT(nsl_char_to_upper('a') == 'A' && "should be 'A'");
     NSL_ASSERT(nsl_char_to_lower('A') == 'a' && "should be 'a'");
@@ -66,5 +102,7 @@ static void test_char_convertion(void) {
 
 int main(void) {
     test_char_test();
+    test_char_table();
+    test_char_classify();
     test_char_convertion();
 }
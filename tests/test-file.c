@@ -54,6 +54,65 @@ static void test_file_read_line(void) {
 
     nsl_file_close(file);
     nsl_list_free(&sb);
+
+    // the last line has no newline, it ends without a trailing 'EOF' char
+    error = nsl_file_open(&file, NSL_PATH("build/no-newline.txt"), "w");
+    NSL_ASSERT(file && error == 0);
+    nsl_file_write_str(file, NSL_STR("first\nlast"));
+    nsl_file_close(file);
+
+    error = nsl_file_open(&file, NSL_PATH("build/no-newline.txt"), "r");
+    NSL_ASSERT(file && error == 0);
+    line = nsl_file_read_line(file, &sb);
+    NSL_ASSERT(nsl_str_eq(line, NSL_STR("first\n")));
+    line = nsl_file_read_line(file, &sb);
+    NSL_ASSERT(nsl_str_eq(line, NSL_STR("last")));
+    line = nsl_file_read_line(file, &sb);
+    NSL_ASSERT(line.len == 0);
+    NSL_ASSERT(sb.len == 10);
+
+    nsl_file_close(file);
+    nsl_list_free(&sb);
+}
+
+static void test_line_reader(void) {
+    FILE* file = NULL;
+    nsl_Error error = nsl_file_open(&file, NSL_PATH(__FILE__), "rb");
+    NSL_ASSERT(file && error == 0);
+    nsl_StrBuffer sb = {0};
+    nsl_Str content = nsl_file_read_sb(file, &sb);
+    rewind(file);
+
+    // a tiny buffer, so lines straddle refills and the buffer has to grow
+    nsl_LineReader reader = {.file = file, .cap = 16};
+    usize offset = 0;
+    nsl_Str line = {0};
+    while (nsl_line_reader_next(&reader, &line)) {
+        NSL_ASSERT(nsl_str_endswith(line, NSL_STR("\n")));
+        NSL_ASSERT(nsl_str_eq(line, nsl_str_substring(content, offset, offset + line.len)));
+        offset += line.len;
+    }
+    NSL_ASSERT(offset == content.len && "did not read all lines");
+    NSL_ASSERT(nsl_line_reader_next(&reader, &line) == false);
+    nsl_line_reader_free(&reader);
+    nsl_file_close(file);
+
+    error = nsl_file_open(&file, NSL_PATH("build/lines.txt"), "wb");
+    NSL_ASSERT(error == NSL_NO_ERROR);
+    nsl_file_write_str(file, NSL_STR("first\n\nlast"));
+    nsl_file_close(file);
+
+    error = nsl_file_open(&file, NSL_PATH("build/lines.txt"), "rb");
+    NSL_ASSERT(error == NSL_NO_ERROR);
+    reader = (nsl_LineReader){.file = file};
+    NSL_ASSERT(nsl_line_reader_next(&reader, &line) && nsl_str_eq(line, NSL_STR("first\n")));
+    NSL_ASSERT(nsl_line_reader_next(&reader, &line) && nsl_str_eq(line, NSL_STR("\n")));
+    NSL_ASSERT(nsl_line_reader_next(&reader, &line) && nsl_str_eq(line, NSL_STR("last")));
+    NSL_ASSERT(nsl_line_reader_next(&reader, &line) == false);
+    nsl_line_reader_free(&reader);
+    nsl_file_close(file);
+
+    nsl_list_free(&sb);
 }
 
 static void test_file_read_bytes(void) {
@@ -92,12 +151,542 @@ static void test_file_write_bytes(void) {
     nsl_file_close(file);
 }
 
+static void test_file_checksum(void) {
+    FILE* file = NULL;
+    nsl_Error error = nsl_file_open(&file, NSL_PATH(__FILE__), "rb");
+    NSL_ASSERT(file && error == 0);
+
+    nsl_StrBuffer sb = {0};
+    nsl_Str content = nsl_file_read_sb(file, &sb);
+    nsl_file_close(file);
+
+    u64 checksum = 0;
+    error = nsl_file_checksum(NSL_PATH(__FILE__), &checksum);
+    NSL_ASSERT(error == NSL_NO_ERROR);
+    NSL_ASSERT(checksum == nsl_bytes_xxh64(nsl_str_to_bytes(content), 0));
+
+    error = nsl_file_checksum(NSL_PATH("build/does-not-exist"), &checksum);
+    NSL_ASSERT(error == NSL_ERROR_FILE_NOT_FOUND);
+
+    nsl_list_free(&sb);
+}
+
+static void test_file_map(void) {
+    FILE* file = NULL;
+    nsl_Error error = nsl_file_open(&file, NSL_PATH(__FILE__), "rb");
+    NSL_ASSERT(file && error == 0);
+    nsl_StrBuffer sb = {0};
+    nsl_Str content = nsl_file_read_sb(file, &sb);
+    nsl_file_close(file);
+
+    nsl_FileMap map = {0};
+    error = nsl_file_map(NSL_PATH(__FILE__), &map);
+    NSL_ASSERT(error == NSL_NO_ERROR);
+    nsl_file_map_advise(&map, NSL_FILE_MAP_SEQUENTIAL | NSL_FILE_MAP_WILLNEED | NSL_FILE_MAP_HUGEPAGE);
+    NSL_ASSERT(nsl_str_eq(nsl_str_from_bytes(map.bytes), content));
+    nsl_file_unmap(&map);
+    NSL_ASSERT(map.bytes.size == 0);
+
+    error = nsl_file_open(&file, NSL_PATH("build/empty.txt"), "w");
+    NSL_ASSERT(error == NSL_NO_ERROR);
+    nsl_file_close(file);
+    error = nsl_file_map(NSL_PATH("build/empty.txt"), &map);
+    NSL_ASSERT(error == NSL_NO_ERROR && map.bytes.size == 0);
+    nsl_file_unmap(&map);
+
+    NSL_ASSERT(nsl_file_map(NSL_PATH("build/does-not-exist"), &map) == NSL_ERROR_FILE_NOT_FOUND);
+
+    nsl_list_free(&sb);
+}
+
+typedef struct {
+    u64 sum;
+    usize lines;
+    bool aligned;
+} Totals;
+
+static void *sum_chunk(void *ctx, nsl_Str chunk, nsl_Arena *arena) {
+    const char delim = *(const char *)ctx;
+    Totals *totals = nsl_arena_calloc(arena, sizeof(Totals));
+    totals->aligned = chunk.len && chunk.data[chunk.len - 1] == delim;
+    for (nsl_Str field; nsl_str_try_chop_by_delim(&chunk, delim, &field);) {
+        u64 value = 0;
+        if (nsl_str_u64(field, &value) == NSL_NO_ERROR) totals->sum += value;
+        totals->lines++;
+    }
+    return totals;
+}
+
+static Totals reduced;
+static void sum_reduce(void *ctx, void *result) {
+    (void)ctx;
+    const Totals *totals = result;
+    reduced.sum += totals->sum;
+    reduced.lines += totals->lines;
+    reduced.aligned &= totals->aligned;
+}
+
+static void test_file_process_chunks(void) {
+    FILE *file = NULL;
+    nsl_Error error = nsl_file_open(&file, NSL_PATH("build/numbers.txt"), "wb");
+    NSL_ASSERT(error == NSL_NO_ERROR);
+    for (usize i = 1; i <= 100000; i++) {
+        nsl_file_write_fmt(file, "%zu\n", i);
+    }
+    nsl_file_close(file);
+
+    char delim = '\n';
+    reduced = (Totals){.aligned = true};
+    error = nsl_file_process_chunks(NSL_PATH("build/numbers.txt"), .ctx = &delim, .map = sum_chunk, .reduce = sum_reduce);
+    NSL_ASSERT(error == NSL_NO_ERROR);
+    NSL_ASSERT(reduced.lines == 100000);
+    NSL_ASSERT(reduced.sum == 100000ull * 100001 / 2);
+    NSL_ASSERT(reduced.aligned && "chunks do not end at a delimiter");
+
+    // more chunks than fields and no delimiter at the end
+    delim = ',';
+    reduced = (Totals){0};
+    nsl_str_process_chunks(NSL_STR("1,2,3,4,5"), .threads = 3, .chunks = 20, .delim = ',', .ctx = &delim, .map = sum_chunk, .reduce = sum_reduce);
+    NSL_ASSERT(reduced.lines == 5 && reduced.sum == 15);
+
+    error = nsl_file_process_chunks(NSL_PATH("build/does-not-exist"), .map = sum_chunk);
+    NSL_ASSERT(error == NSL_ERROR_FILE_NOT_FOUND);
+}
+
+// io_uring on linux, unless the pool is requested
+static void io_queue_roundtrip(bool use_pool) {
+    nsl_Arena arena = {0};
+    nsl_IoQueue queue = {.threads = 4, .use_pool = use_pool, .arena = &arena};
+
+    nsl_IoRequest writes[64] = {0};
+    for (usize i = 0; i < NSL_ARRAY_LEN(writes); i++) {
+        writes[i].op = NSL_IO_WRITE;
+        writes[i].path = nsl_str_format(&arena, "build/io-%zu.txt", i);
+        writes[i].data = nsl_str_to_bytes(nsl_str_format(&arena, "file %zu\n", i));
+    }
+    nsl_io_submit(&queue, NSL_ARRAY_LEN(writes), writes);
+    nsl_io_wait(&queue);
+    for (usize i = 0; i < NSL_ARRAY_LEN(writes); i++) {
+        NSL_ASSERT(writes[i].error == NSL_NO_ERROR);
+    }
+    NSL_ASSERT(nsl_io_next(&queue) == NULL);
+
+    nsl_IoRequest append = {.op = NSL_IO_APPEND, .path = writes[0].path, .data = NSL_BYTES_STR("more\n")};
+    nsl_io_perform(&queue, &append);
+    NSL_ASSERT(append.error == NSL_NO_ERROR);
+
+    nsl_IoRequest reads[NSL_ARRAY_LEN(writes) + 1] = {0};
+    for (usize i = 0; i < NSL_ARRAY_LEN(reads); i++) {
+        reads[i].op = NSL_IO_READ;
+        reads[i].path = i < NSL_ARRAY_LEN(writes) ? writes[i].path : NSL_PATH("build/does-not-exist");
+        reads[i].ctx = &writes[i];
+    }
+    nsl_io_submit(&queue, NSL_ARRAY_LEN(reads), reads);
+
+    usize completed = 0;
+    for (nsl_IoRequest *request; (request = nsl_io_next(&queue)) != NULL; completed++) {
+        if (request == &reads[NSL_ARRAY_LEN(writes)]) {
+            NSL_ASSERT(request->error == NSL_ERROR_FILE_NOT_FOUND);
+            continue;
+        }
+        const nsl_IoRequest *written = request->ctx;
+        NSL_ASSERT(request->error == NSL_NO_ERROR);
+        nsl_Str content = nsl_str_from_bytes(request->data);
+        if (request == &reads[0]) {
+            NSL_ASSERT(nsl_str_eq(content, NSL_STR("file 0\nmore\n")));
+        } else {
+            NSL_ASSERT(nsl_str_eq(content, nsl_str_from_bytes(written->data)));
+        }
+    }
+    NSL_ASSERT(completed == NSL_ARRAY_LEN(reads));
+
+    // freeing completes the requests that are still pending
+    nsl_IoRequest late = {.op = NSL_IO_READ, .path = writes[1].path};
+    nsl_io_submit(&queue, 1, &late);
+    nsl_io_queue_free(&queue);
+    NSL_ASSERT(late.error == NSL_NO_ERROR && nsl_str_eq(nsl_str_from_bytes(late.data), NSL_STR("file 1\n")));
+    nsl_arena_free(&arena);
+}
+
+static void test_io_queue(void) {
+    io_queue_roundtrip(false);
+    io_queue_roundtrip(true);
+
+    nsl_Arena arena = {0};
+    // a single request does not start the workers
+    nsl_IoQueue single = {.arena = &arena};
+    nsl_IoRequest first = {.op = NSL_IO_READ, .path = NSL_PATH("build/io-2.txt")};
+    nsl_io_perform(&single, &first);
+    NSL_ASSERT(first.error == NSL_NO_ERROR && nsl_str_eq(nsl_str_from_bytes(first.data), NSL_STR("file 2\n")));
+    NSL_ASSERT(single._state == NULL);
+    nsl_arena_free(&arena);
+
+    // requests are completed on the calling thread without an arena as well
+    nsl_IoQueue inline_queue = {0};
+    nsl_IoRequest read = {.op = NSL_IO_READ, .path = NSL_PATH("build/io-1.txt")};
+    nsl_io_perform(&inline_queue, &read);
+    NSL_ASSERT(read.error == NSL_NO_ERROR && nsl_str_eq(nsl_str_from_bytes(read.data), NSL_STR("file 1\n")));
+    nsl_io_queue_free(&inline_queue);
+}
+
+static void test_writer(void) {
+    nsl_Writer writer = {.cap = 16};
+    nsl_Error error = nsl_writer_open(NSL_PATH("build/writer.txt"), &writer);
+    NSL_ASSERT(error == NSL_NO_ERROR);
+
+    nsl_writer_write_str(&writer, NSL_STR("Hello"));
+    nsl_writer_write_bytes(&writer, NSL_BYTES_STR(", World\n"));
+    nsl_writer_write_u64(&writer, 0);
+    nsl_writer_write_str(&writer, NSL_STR(" "));
+    nsl_writer_write_u64(&writer, UINT64_MAX);
+    nsl_writer_write_str(&writer, NSL_STR(" "));
+    nsl_writer_write_i64(&writer, INT64_MIN);
+    nsl_writer_write_str(&writer, NSL_STR(" "));
+    nsl_writer_write_i64(&writer, -5);
+    // fits after a flush, larger than the buffer
+    nsl_writer_write_fmt(&writer, " %s", "formatted");
+    nsl_writer_write_fmt(&writer, " %s %d\n", "longer than the buffer", 69);
+    const nsl_Bytes parts[] = {NSL_BYTES_STR("a"), NSL_BYTES_STR(""), NSL_BYTES_STR("b\n")};
+    nsl_writer_writev(&writer, NSL_ARRAY_LEN(parts), parts);
+    NSL_ASSERT(nsl_writer_close(&writer) == NSL_NO_ERROR);
+
+    FILE *file = NULL;
+    error = nsl_file_open(&file, NSL_PATH("build/writer.txt"), "r");
+    NSL_ASSERT(error == NSL_NO_ERROR);
+    nsl_Arena arena = {0};
+    nsl_Str content = nsl_file_read_str(file, &arena);
+    NSL_ASSERT(nsl_str_eq(
+        content,
+        NSL_STR("Hello, World\n0 18446744073709551615 -9223372036854775808 -5 formatted longer than "
+                "the buffer 69\nab\n")
+    ));
+    nsl_file_close(file);
+    nsl_arena_free(&arena);
+
+    error = nsl_writer_open(NSL_PATH("build/does-not-exist/writer.txt"), &writer);
+    NSL_ASSERT(error == NSL_ERROR_FILE_NOT_FOUND);
+}
+
+static nsl_Str read_file(nsl_Path path, nsl_Arena *arena) {
+    FILE *file = NULL;
+    NSL_ASSERT(nsl_file_open(&file, path, "rb") == NSL_NO_ERROR);
+    nsl_Str content = nsl_file_read_str(file, arena);
+    nsl_file_close(file);
+    return content;
+}
+
+static usize count_temp_files(nsl_Path directory) {
+    usize count = 0;
+    nsl_dir_walk(e, directory, false) {
+        count += nsl_str_endswith(e->path, NSL_STR(".tmp"));
+    }
+    return count;
+}
+
+static void test_file_write_atomic(void) {
+    nsl_Arena arena = {0};
+    nsl_Error error = nsl_os_mkdir(NSL_PATH("build/atomic"), .exists_ok = true);
+    NSL_ASSERT(error == NSL_NO_ERROR);
+
+    error = nsl_file_write_atomic(NSL_PATH("build/atomic/state"), NSL_BYTES_STR("first"));
+    NSL_ASSERT(error == NSL_NO_ERROR);
+    error = nsl_file_write_atomic(NSL_PATH("build/atomic/state"), NSL_BYTES_STR("second"));
+    NSL_ASSERT(error == NSL_NO_ERROR);
+    NSL_ASSERT(nsl_str_eq(read_file(NSL_PATH("build/atomic/state"), &arena), NSL_STR("second")));
+
+    error = nsl_file_write_atomic(NSL_PATH("build/does-not-exist/state"), NSL_BYTES_STR("first"));
+    NSL_ASSERT(error == NSL_ERROR_FILE_NOT_FOUND);
+
+#if !defined(_WIN32)
+    // the mode of the replaced file is kept
+    struct stat info;
+    NSL_ASSERT(chmod("build/atomic/state", 0600) == 0);
+    error = nsl_file_write_atomic(NSL_PATH("build/atomic/state"), NSL_BYTES_STR("second"));
+    NSL_ASSERT(error == NSL_NO_ERROR);
+    NSL_ASSERT(stat("build/atomic/state", &info) == 0 && (info.st_mode & 0777) == 0600);
+#endif
+
+    nsl_FileBatch batch = {0};
+    for (usize i = 0; i < 20; i++) {
+        nsl_Path path = nsl_str_format(&arena, "build/atomic/batch-%zu", i);
+        nsl_Str content = nsl_str_format(&arena, "batch %zu", i);
+        error = nsl_file_batch_write(&batch, path, nsl_str_to_bytes(content));
+        NSL_ASSERT(error == NSL_NO_ERROR);
+    }
+    NSL_ASSERT(count_temp_files(NSL_PATH("build/atomic")) == 20);
+    NSL_ASSERT(nsl_file_batch_commit(&batch) == NSL_NO_ERROR);
+    NSL_ASSERT(count_temp_files(NSL_PATH("build/atomic")) == 0);
+    for (usize i = 0; i < 20; i++) {
+        nsl_Path path = nsl_str_format(&arena, "build/atomic/batch-%zu", i);
+        NSL_ASSERT(nsl_str_eq(read_file(path, &arena), nsl_str_format(&arena, "batch %zu", i)));
+    }
+
+    // nothing changes without a commit
+    error = nsl_file_batch_write(&batch, NSL_PATH("build/atomic/state"), NSL_BYTES_STR("third"));
+    NSL_ASSERT(error == NSL_NO_ERROR);
+    nsl_file_batch_free(&batch);
+    NSL_ASSERT(count_temp_files(NSL_PATH("build/atomic")) == 0);
+    NSL_ASSERT(nsl_str_eq(read_file(NSL_PATH("build/atomic/state"), &arena), NSL_STR("second")));
+
+    nsl_arena_free(&arena);
+}
+
+static void write_file(nsl_Path path, const char *mode, nsl_Str content) {
+    FILE *file = NULL;
+    NSL_ASSERT(nsl_file_open(&file, path, mode) == NSL_NO_ERROR);
+    nsl_file_write_str(file, content);
+    nsl_file_close(file);
+}
+
+static void test_file_follower(void) {
+    const nsl_Path path = NSL_PATH("build/follow.log");
+    nsl_os_remove(path);
+
+    nsl_FileFollower follower = {.path = path, .cap = 4};
+    nsl_Str line = {0};
+    NSL_ASSERT(nsl_file_follower_next(&follower, 0, &line) == false && "the file does not exist");
+
+    write_file(path, "w", NSL_STR("a\nb"));
+    NSL_ASSERT(nsl_file_follower_next(&follower, 0, &line) && nsl_str_eq(line, NSL_STR("a\n")));
+    NSL_ASSERT(nsl_file_follower_next(&follower, 10, &line) == false && "the line is not complete");
+
+    // the buffer grows for long lines
+    write_file(path, "a", NSL_STR("cdefghijk\n"));
+    NSL_ASSERT(nsl_file_follower_next(&follower, 0, &line) && nsl_str_eq(line, NSL_STR("bcdefghijk\n")));
+
+    // truncated
+    write_file(path, "w", NSL_STR("x\n"));
+    NSL_ASSERT(nsl_file_follower_next(&follower, 0, &line) && nsl_str_eq(line, NSL_STR("x\n")));
+    NSL_ASSERT(follower.offset == 2);
+
+    // rotated: the old file is read to the end first
+    write_file(path, "a", NSL_STR("old\npartial"));
+    NSL_ASSERT(rename("build/follow.log", "build/follow.log.1") == 0);
+    write_file(path, "w", NSL_STR("new\n"));
+    NSL_ASSERT(nsl_file_follower_next(&follower, 0, &line) && nsl_str_eq(line, NSL_STR("old\n")));
+    NSL_ASSERT(nsl_file_follower_next(&follower, 0, &line) && nsl_str_eq(line, NSL_STR("partial")));
+    NSL_ASSERT(nsl_file_follower_next(&follower, 0, &line) && nsl_str_eq(line, NSL_STR("new\n")));
+    NSL_ASSERT(nsl_file_follower_next(&follower, 10, &line) == false);
+
+    nsl_file_follower_free(&follower);
+    nsl_os_remove(NSL_PATH("build/follow.log.1"));
+}
+
+// "a\nbb\n" 100 times and "last", as two gzip members and as one zstd frame
+static const u8 gzip_data[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x4b, 0xe4, 0x4a, 0x4a, 0xe2, 0x4a,
+    0x1c, 0x25, 0x46, 0x12, 0x01, 0x00, 0x81, 0xad, 0x50, 0xc3, 0xf4, 0x01, 0x00, 0x00, 0x1f, 0x8b,
+    0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xcb, 0x49, 0x2c, 0x2e, 0x01, 0x00, 0xa0, 0xa9,
+    0xdb, 0x4a, 0x04, 0x00, 0x00, 0x00,
+};
+static const u8 zstd_data[] = {
+    0x28, 0xb5, 0x2f, 0xfd, 0x04, 0x68, 0x85, 0x00, 0x00, 0x48, 0x61, 0x0a, 0x62, 0x62, 0x0a, 0x6c,
+    0x61, 0x73, 0x74, 0x01, 0x00, 0xec, 0x50, 0x8b, 0x16, 0xd6, 0xb2, 0xd3, 0xa9,
+};
+
+// "a\nbb\nlast" as a zlib stream that needs "a\nbb\n" as the preset dictionary
+static const u8 zlib_dict_data[] = {
+    0x78, 0xbb, 0x04, 0x06, 0x01, 0x3a, 0x4b, 0x04, 0x11, 0x39, 0x89, 0xc5, 0x25, 0x00, 0x0d, 0x1b,
+    0x02, 0xee,
+};
+
+static nsl_Error read_compressed(nsl_Bytes data, usize lines, nsl_Compression *compression) {
+    FILE *file = NULL;
+    NSL_ASSERT(nsl_file_open(&file, NSL_PATH("build/compressed"), "wb") == NSL_NO_ERROR);
+    nsl_file_write_bytes(file, data);
+    nsl_file_close(file);
+
+    NSL_ASSERT(nsl_file_open(&file, NSL_PATH("build/compressed"), "rb") == NSL_NO_ERROR);
+    nsl_Reader source = {.file = file};
+    nsl_LineReader reader = {.source = &source, .cap = 4};
+    nsl_Str line = {0};
+    usize count = 0;
+    while (nsl_line_reader_next(&reader, &line)) {
+        const nsl_Str expected = count + 1 == lines ? NSL_STR("last") : count % 2 ? NSL_STR("bb\n") : NSL_STR("a\n");
+        NSL_ASSERT(nsl_str_eq(line, expected));
+        count++;
+    }
+    NSL_ASSERT(count == lines || source.error);
+    *compression = source.compression;
+    nsl_line_reader_free(&reader);
+    nsl_reader_free(&source);
+    nsl_file_close(file);
+    return source.error;
+}
+
+static void test_reader(void) {
+    nsl_Compression compression = NSL_COMPRESSION_AUTO;
+    NSL_ASSERT(read_compressed(NSL_BYTES_STR("a\nbb\nlast"), 3, &compression) == NSL_NO_ERROR);
+    NSL_ASSERT(compression == NSL_COMPRESSION_NONE);
+
+    // the libraries are optional
+    nsl_Error error = read_compressed(nsl_bytes_from_parts(sizeof(gzip_data), gzip_data), 201, &compression);
+    NSL_ASSERT(compression == NSL_COMPRESSION_GZIP);
+    if (error != NSL_ERROR_FILE_NOT_FOUND) {
+        NSL_ASSERT(error == NSL_NO_ERROR);
+        error = read_compressed(nsl_bytes_from_parts(sizeof(gzip_data) - 3, gzip_data), 201, &compression);
+        NSL_ASSERT(error == NSL_ERROR_PARSE && "truncated");
+
+        // zeros after the last member are padding, anything after them is not
+        u8 padded[sizeof(gzip_data) + 16] = {0};
+        memcpy(padded, gzip_data, sizeof(gzip_data));
+        error = read_compressed(nsl_bytes_from_parts(sizeof(padded), padded), 201, &compression);
+        NSL_ASSERT(error == NSL_NO_ERROR);
+        padded[sizeof(padded) - 1] = 0x1f;
+        error = read_compressed(nsl_bytes_from_parts(sizeof(padded), padded), 201, &compression);
+        NSL_ASSERT(error == NSL_ERROR_PARSE);
+
+        // the dictionary can't be set, this fails instead of waiting for it
+        FILE *file = NULL;
+        NSL_ASSERT(nsl_file_open(&file, NSL_PATH("build/compressed"), "wb") == NSL_NO_ERROR);
+        nsl_file_write_bytes(file, nsl_bytes_from_parts(sizeof(zlib_dict_data), zlib_dict_data));
+        nsl_file_close(file);
+        NSL_ASSERT(nsl_file_open(&file, NSL_PATH("build/compressed"), "rb") == NSL_NO_ERROR);
+        nsl_Reader source = {.file = file, .compression = NSL_COMPRESSION_GZIP};
+        u8 buffer[64];
+        NSL_ASSERT(nsl_reader_read(&source, sizeof(buffer), buffer).size == 0);
+        NSL_ASSERT(source.error == NSL_ERROR_PARSE);
+        nsl_reader_free(&source);
+        nsl_file_close(file);
+    }
+
+    error = read_compressed(nsl_bytes_from_parts(sizeof(zstd_data), zstd_data), 201, &compression);
+    NSL_ASSERT(compression == NSL_COMPRESSION_ZSTD);
+    if (error != NSL_ERROR_FILE_NOT_FOUND) {
+        NSL_ASSERT(error == NSL_NO_ERROR);
+        error = read_compressed(nsl_bytes_from_parts(sizeof(zstd_data) - 3, zstd_data), 201, &compression);
+        NSL_ASSERT(error == NSL_ERROR_PARSE && "truncated");
+    }
+    nsl_os_remove(NSL_PATH("build/compressed"));
+}
+
+typedef struct {
+    u64 id;
+    f64 value;
+} Sample;
+
+static void flip_byte(nsl_Path path, usize offset) {
+    FILE *file = NULL;
+    NSL_ASSERT(nsl_file_open(&file, path, "r+b") == NSL_NO_ERROR);
+    fseek(file, (long)offset, SEEK_SET);
+    const int c = fgetc(file);
+    fseek(file, (long)offset, SEEK_SET);
+    fputc(c ^ 0xff, file);
+    nsl_file_close(file);
+}
+
+static void test_record_file(void) {
+    const nsl_Path path = NSL_PATH("build/records.bin");
+    nsl_List(Sample) samples = {0};
+    for (usize i = 0; i < 100; i++) nsl_list_push(&samples, (Sample){.id = i, .value = (f64)i / 2});
+
+    nsl_RecordWriter writer = {0};
+    NSL_ASSERT(nsl_record_writer_open(path, &writer) == NSL_NO_ERROR);
+    nsl_record_write_str(&writer, NSL_STR("hello"));
+    nsl_record_write_str(&writer, NSL_STR(""));
+    nsl_record_write_list(&writer, &samples);
+    NSL_ASSERT(nsl_record_writer_close(&writer) == NSL_NO_ERROR);
+
+    NSL_ASSERT(nsl_record_writer_append(path, &writer) == NSL_NO_ERROR);
+    nsl_record_write_str(&writer, NSL_STR("appended"));
+    NSL_ASSERT(nsl_record_writer_close(&writer) == NSL_NO_ERROR);
+
+    nsl_RecordFile file = {0};
+    NSL_ASSERT(nsl_record_file_open(path, &file) == NSL_NO_ERROR);
+    NSL_ASSERT(file.count == 4);
+    nsl_Bytes record = {0};
+    NSL_ASSERT(nsl_record_file_get(&file, 0, &record) == NSL_NO_ERROR);
+    NSL_ASSERT(nsl_bytes_eq(record, NSL_BYTES_STR("hello")));
+    NSL_ASSERT(nsl_record_file_get(&file, 1, &record) == NSL_NO_ERROR && record.size == 0);
+    NSL_ASSERT(nsl_record_file_get(&file, 3, &record) == NSL_NO_ERROR);
+    NSL_ASSERT(nsl_bytes_eq(record, NSL_BYTES_STR("appended")));
+
+    // the data is aligned, so it can be used in place
+    NSL_ASSERT(nsl_record_file_get(&file, 2, &record) == NSL_NO_ERROR);
+    NSL_ASSERT((usize)record.data % 8 == 0 && record.size == 100 * sizeof(Sample));
+    const Sample *mapped = (const Sample *)record.data;
+    NSL_ASSERT(mapped[99].id == 99 && mapped[99].value == 49.5);
+    NSL_ASSERT(nsl_record_file_verify(&file) == NSL_NO_ERROR);
+    nsl_record_file_close(&file);
+
+    // a damaged record is reported, the others are still readable
+    flip_byte(path, 8 + 8 + 2);
+    NSL_ASSERT(nsl_record_file_open(path, &file) == NSL_NO_ERROR);
+    NSL_ASSERT(nsl_record_file_get(&file, 0, &record) == NSL_ERROR_PARSE);
+    NSL_ASSERT(nsl_record_file_get(&file, 3, &record) == NSL_NO_ERROR);
+    NSL_ASSERT(nsl_record_file_verify(&file) == NSL_ERROR_PARSE);
+    nsl_record_file_close(&file);
+    flip_byte(path, 8 + 8 + 2);
+
+    // a damaged index is only found by the verification, opening does not read it
+    nsl_FileMap map = {0};
+    NSL_ASSERT(nsl_file_map(path, &map) == NSL_NO_ERROR);
+    const usize size = map.bytes.size;
+    nsl_file_unmap(&map);
+    flip_byte(path, size - 30);
+    NSL_ASSERT(nsl_record_file_open(path, &file) == NSL_NO_ERROR);
+    NSL_ASSERT(nsl_record_file_verify(&file) == NSL_ERROR_PARSE);
+    nsl_record_file_close(&file);
+    NSL_ASSERT(nsl_record_writer_append(path, &writer) == NSL_ERROR_PARSE);
+
+    flip_byte(path, size - 30);
+
+    // an append that stops before the footer is written keeps the old records
+    NSL_ASSERT(nsl_record_writer_append(path, &writer) == NSL_NO_ERROR);
+    nsl_record_write_str(&writer, NSL_STR("lost"));
+    NSL_ASSERT(nsl_writer_close(&writer.writer) == NSL_NO_ERROR);
+    nsl_list_free(&writer.index);
+    nsl_list_free(&writer.buffer);
+    NSL_ASSERT(nsl_record_file_open(path, &file) == NSL_NO_ERROR);
+    NSL_ASSERT(file.count == 4 && nsl_record_file_verify(&file) == NSL_NO_ERROR);
+    nsl_record_file_close(&file);
+
+    // and the next append continues after it
+    NSL_ASSERT(nsl_record_writer_append(path, &writer) == NSL_NO_ERROR);
+    nsl_record_write_str(&writer, NSL_STR("again"));
+    NSL_ASSERT(nsl_record_writer_close(&writer) == NSL_NO_ERROR);
+    NSL_ASSERT(nsl_record_file_open(path, &file) == NSL_NO_ERROR);
+    NSL_ASSERT(file.count == 5 && nsl_record_file_verify(&file) == NSL_NO_ERROR);
+    NSL_ASSERT(nsl_record_file_get(&file, 4, &record) == NSL_NO_ERROR);
+    NSL_ASSERT(nsl_bytes_eq(record, NSL_BYTES_STR("again")));
+    nsl_record_file_close(&file);
+
+    // a damaged footer falls back to the one before
+    NSL_ASSERT(nsl_file_map(path, &map) == NSL_NO_ERROR);
+    flip_byte(path, map.bytes.size - 20);
+    nsl_file_unmap(&map);
+    NSL_ASSERT(nsl_record_file_open(path, &file) == NSL_NO_ERROR);
+    NSL_ASSERT(file.count == 4 && nsl_record_file_verify(&file) == NSL_NO_ERROR);
+    nsl_record_file_close(&file);
+
+    // without one before it is found on open
+    NSL_ASSERT(nsl_record_writer_open(path, &writer) == NSL_NO_ERROR);
+    nsl_record_write_str(&writer, NSL_STR("hello"));
+    NSL_ASSERT(nsl_record_writer_close(&writer) == NSL_NO_ERROR);
+    flip_byte(path, 8 + 16 + 8 + 4);
+    NSL_ASSERT(nsl_record_file_open(path, &file) == NSL_ERROR_PARSE);
+    NSL_ASSERT(nsl_record_file_open(NSL_PATH(__FILE__), &file) == NSL_ERROR_PARSE);
+
+    nsl_list_free(&samples);
+    nsl_os_remove(path);
+}
+
 int main(void) {
     test_file_open();
     test_file_read_str();
     test_file_read_sb();
     test_file_read_line();
+    test_line_reader();
     test_file_read_bytes();
     test_file_write_str();
     test_file_write_bytes();
+    test_file_checksum();
+    test_file_map();
+    test_file_process_chunks();
+    test_io_queue();
+    test_writer();
+    test_file_write_atomic();
+    test_file_follower();
+    test_reader();
+    test_record_file();
 }
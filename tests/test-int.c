@@ -557,6 +557,91 @@ static void test_i64_next_pow2(void) {
 
 /* i64 */
 
+static void test_bit_edge_cases(void) {
+    NSL_ASSERT(nsl_u32_leading_zeros(0) == 32 && nsl_u32_trailing_zeros(0) == 32);
+    NSL_ASSERT(nsl_u16_leading_ones(0xffff) == 16 && nsl_u64_trailing_ones(UINT64_MAX) == 64);
+    NSL_ASSERT(nsl_i8_leading_zeros(-1) == 0 && nsl_i8_count_ones(-1) == 8);
+    NSL_ASSERT(nsl_i16_count_zeros(-2) == 1 && nsl_i32_trailing_zeros(INT32_MIN) == 31);
+    NSL_ASSERT(nsl_i16_swap_bytes((i16)0x80ff) == (i16)0xff80 && "Did not swap correctly");
+    NSL_ASSERT(nsl_i32_reverse_bits(1) == INT32_MIN && "Did not reverse correctly");
+}
+
+static void test_count_ones_array(void) {
+    u64 values[67];
+    usize expected = 0;
+    for (usize i = 0; i < NSL_ARRAY_LEN(values); i++) {
+        values[i] = (u64)i * 0x9e3779b97f4a7c15;
+        expected += nsl_u64_count_ones(values[i]);
+    }
+    for (usize count = 0; count <= NSL_ARRAY_LEN(values); count += 11) {
+        usize sum = 0;
+        for (usize i = 0; i < count; i++) {
+            sum += nsl_u64_count_ones(values[i]);
+        }
+        NSL_ASSERT(nsl_u64_count_ones_array(count, values) == sum && "Did not count correctly");
+    }
+    NSL_ASSERT(nsl_u64_count_ones_array(NSL_ARRAY_LEN(values), values) == expected);
+}
+
+static void test_endian_arrays(void) {
+    nsl_ByteBuffer buffer = {0};
+    u32 values[37];
+    for (usize i = 0; i < NSL_ARRAY_LEN(values); i++) {
+        values[i] = (u32)(i * 0x01020304);
+    }
+
+    nsl_Bytes be = nsl_bb_push_u32_be_array(&buffer, NSL_ARRAY_LEN(values), values);
+    NSL_ASSERT(be.size == sizeof(values) && "Not converted correctly");
+    for (usize i = 0; i < NSL_ARRAY_LEN(values); i++) {
+        NSL_ASSERT(nsl_u32_from_be_bytes(nsl_bytes_slice(be, i * 4, i * 4 + 4)) == values[i]);
+    }
+
+    u32 out[40] = {0};
+    NSL_ASSERT(nsl_bytes_read_u32_be_array(be, NSL_ARRAY_LEN(out), out) == NSL_ARRAY_LEN(values));
+    NSL_ASSERT(memcmp(out, values, sizeof(values)) == 0 && "Not converted correctly");
+
+    const i16 shorts[] = {0x0102, -2, 0x7fff};
+    NSL_ASSERT(nsl_bytes_eq(nsl_bb_push_i16_be_array(&buffer, 3, shorts), NSL_BYTES(0x01, 0x02, 0xff, 0xfe, 0x7f, 0xff)));
+    NSL_ASSERT(nsl_bytes_eq(nsl_bb_push_i16_le_array(&buffer, 3, shorts), NSL_BYTES(0x02, 0x01, 0xfe, 0xff, 0xff, 0x7f)));
+
+    u64 longs[2] = {0};
+    nsl_Bytes le = NSL_BYTES(1, 0, 0, 0, 0, 0, 0, 0x80, 2, 0, 0, 0, 0, 0, 0, 0, 0xff);
+    NSL_ASSERT(nsl_bytes_read_u64_le_array(le, 5, longs) == 2 && "Should only read full values");
+    NSL_ASSERT(longs[0] == 0x8000000000000001 && longs[1] == 2 && "Not converted correctly");
+
+    nsl_list_free(&buffer);
+}
+
+static void test_varint(void) {
+    nsl_ByteBuffer buffer = {0};
+    NSL_ASSERT(nsl_bytes_eq(nsl_bb_push_varint(&buffer, 0), NSL_BYTES(0x00)));
+    NSL_ASSERT(nsl_bytes_eq(nsl_bb_push_varint(&buffer, 300), NSL_BYTES(0xac, 0x02)));
+    NSL_ASSERT(nsl_bytes_eq(nsl_bb_push_varint_signed(&buffer, -1), NSL_BYTES(0x01)));
+    NSL_ASSERT(nsl_zigzag_encode(INT64_MIN) == UINT64_MAX && nsl_zigzag_decode(UINT64_MAX) == INT64_MIN);
+
+    const u64 values[] = {0, 1, 127, 128, 300, 1ull << 35, 0x123456789abcdef, UINT64_MAX};
+    buffer.len = 0;
+    nsl_bb_push_varint_array(&buffer, NSL_ARRAY_LEN(values), values);
+    nsl_bb_push_varint_signed(&buffer, -123456789);
+
+    nsl_Bytes bytes = nsl_bb_to_bytes(&buffer);
+    for (usize i = 0; i < NSL_ARRAY_LEN(values); i++) {
+        u64 value = 0;
+        NSL_ASSERT(nsl_bytes_chop_varint(&bytes, &value) == NSL_NO_ERROR && value == values[i]);
+    }
+    i64 signed_value = 0;
+    NSL_ASSERT(nsl_bytes_chop_varint_signed(&bytes, &signed_value) == NSL_NO_ERROR);
+    NSL_ASSERT(signed_value == -123456789 && bytes.size == 0);
+
+    u64 value = 0;
+    nsl_Bytes truncated = NSL_BYTES(0x80, 0x80);
+    NSL_ASSERT(nsl_bytes_chop_varint(&truncated, &value) == NSL_ERROR_PARSE && truncated.size == 2);
+    nsl_Bytes overflow = NSL_BYTES(0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02);
+    NSL_ASSERT(nsl_bytes_chop_varint(&overflow, &value) == NSL_ERROR_PARSE);
+
+    nsl_list_free(&buffer);
+}
+
 int main(void) {
     test_u8_leading_bits();
     test_u8_swaping_bits();
@@ -629,4 +714,9 @@ int main(void) {
     test_i64_to_bytes();
     test_i64_hash();
     test_i64_next_pow2();
+
+    test_bit_edge_cases();
+    test_count_ones_array();
+    test_endian_arrays();
+    test_varint();
 }
@@ -128,6 +128,46 @@ static void test_reverse(void) {
     }
 
     nsl_list_free(&list);
+
+    nsl_list_reverse(&list);
+    NSL_ASSERT(list.len == 0);
+}
+
+#define TEST_REVERSE(T)                                                                            \
+    do {                                                                                           \
+        nsl_List(T) list = {0};                                                                    \
+        for (usize n = 0; n < 200; n++) {                                                          \
+            nsl_list_clear(&list);                                                                 \
+            for (usize i = 0; i < n; i++) {                                                        \
+                T value;                                                                           \
+                memset(&value, (int)i, sizeof(value));                                             \
+                nsl_list_push(&list, value);                                                       \
+            }                                                                                      \
+            nsl_list_reverse(&list);                                                               \
+            for (usize i = 0; i < n; i++) {                                                        \
+                T value;                                                                           \
+                memset(&value, (int)(n - i - 1), sizeof(value));                                   \
+                NSL_ASSERT(memcmp(&list.items[i], &value, sizeof(value)) == 0);                    \
+            }                                                                                      \
+        }                                                                                          \
+        nsl_list_free(&list);                                                                      \
+    } while (0)
+
+typedef struct {
+    u8 bytes[3];
+} Rgb;
+
+typedef struct {
+    u8 bytes[100];
+} Big;
+
+static void test_reverse_sizes(void) {
+    TEST_REVERSE(u8);
+    TEST_REVERSE(u16);
+    TEST_REVERSE(u32);
+    TEST_REVERSE(u64);
+    TEST_REVERSE(Rgb);
+    TEST_REVERSE(Big);
 }
 
 static bool is_odd(usize i) { return i % 2 == 0; }
@@ -223,6 +263,28 @@ static void test_insert(void) {
     NSL_ASSERT(list.items[2] == 3);
     NSL_ASSERT(list.items[3] == 4);
 
+    nsl_list_insert(&list, 0, 0);
+    nsl_list_insert(&list, 5, list.len);
+    for (usize i = 0; i < list.len; i++) {
+        NSL_ASSERT(list.items[i] == i && "insert did not shift the tail");
+    }
+
+    nsl_list_free(&list);
+}
+
+static void test_insert_n(void) {
+    nsl_List(usize) list = {0};
+    nsl_list_extend_static(&list, (usize[]){0, 1, 5, 6});
+
+    nsl_list_insert_n(&list, 2, 3, (usize[]){2, 3, 4});
+    nsl_list_insert_n(&list, 0, 0, (usize[]){0});
+    nsl_list_insert_n(&list, list.len, 2, (usize[]){7, 8});
+
+    NSL_ASSERT(list.len == 9);
+    for (usize i = 0; i < list.len; i++) {
+        NSL_ASSERT(list.items[i] == i && "items were not inserted correctly");
+    }
+
     nsl_list_free(&list);
 }
 
@@ -244,6 +306,25 @@ static void test_remove(void) {
     nsl_list_free(&list);
 }
 
+static void test_remove_range(void) {
+    nsl_List(usize) list = {0};
+    for (usize i = 0; i < 10; i++) {
+        nsl_list_push(&list, i);
+    }
+
+    nsl_list_remove_range(&list, 2, 3);
+    nsl_list_remove_range(&list, 0, 0);
+    NSL_ASSERT(list.len == 7);
+    NSL_ASSERT(list.items[1] == 1 && list.items[2] == 5 && list.items[6] == 9);
+
+    nsl_list_remove_range(&list, 5, 2);
+    NSL_ASSERT(list.len == 5 && list.items[4] == 7);
+    nsl_list_remove_range(&list, 0, list.len);
+    NSL_ASSERT(list.len == 0);
+
+    nsl_list_free(&list);
+}
+
 static void test_remove_unordered(void) {
     nsl_List(usize) list = {0};
 
@@ -285,6 +366,7 @@ int main(void) {
     test_extend();
     test_reserve();
     test_reverse();
+    test_reverse_sizes();
     test_sort();
     test_last();
     test_filter();
@@ -292,7 +374,9 @@ int main(void) {
     test_copy();
     test_pop();
     test_insert();
+    test_insert_n();
     test_remove();
+    test_remove_range();
     test_remove_unordered();
     test_for_each();
 }
@@ -0,0 +1,227 @@
+#include "../nsl.h"
+
+static u32 rng_state = 0x12345678;
+static u32 rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// sparse values, a dense block, a long run and values around the container borders
+static void fill(nsl_Roaring *r, nsl_BitSet *set, u32 seed) {
+    rng_state = seed;
+    for (usize i = 0; i < 3000; i++) {
+        const u32 v = rng() % 1000000;
+        nsl_roaring_add(r, v);
+        nsl_bitset_set(set, v);
+    }
+    for (usize i = 0; i < 20000; i++) {
+        const u32 v = (3u << 16) + rng() % 40000;
+        nsl_roaring_add(r, v);
+        nsl_bitset_set(set, v);
+    }
+    for (u32 v = 200000 + seed % 100; v < 260000; v++) {
+        nsl_roaring_add(r, v);
+        nsl_bitset_set(set, v);
+    }
+    for (u32 v = (9u << 16) - 5; v < (9u << 16) + 5; v++) {
+        nsl_roaring_add(r, v);
+        nsl_bitset_set(set, v);
+    }
+}
+
+static void assert_same(const nsl_Roaring *r, const nsl_BitSet *set) {
+    NSL_ASSERT(nsl_roaring_count(r) == nsl_bitset_count(set));
+    usize i = 0;
+    u64 v = 0;
+    for (; nsl_roaring_next(r, &v); v++, i++) {
+        NSL_ASSERT(nsl_bitset_next(set, &i) && i == v && "iteration is not correct");
+    }
+    NSL_ASSERT(nsl_bitset_next(set, &i) == false && "iteration stopped early");
+    for (u32 k = 0; k < 2000; k++) {
+        const u32 probe = rng() % 1100000;
+        NSL_ASSERT(nsl_roaring_has(r, probe) == nsl_bitset_test(set, probe));
+    }
+}
+
+static void test_basic(void) {
+    nsl_Roaring r = {0};
+    NSL_ASSERT(nsl_roaring_has(&r, 1) == false);
+    NSL_ASSERT(nsl_roaring_add(&r, 1) == true);
+    NSL_ASSERT(nsl_roaring_add(&r, 1) == false);
+    NSL_ASSERT(nsl_roaring_add(&r, UINT32_MAX) == true);
+    NSL_ASSERT(nsl_roaring_has(&r, 1) && nsl_roaring_has(&r, UINT32_MAX));
+    NSL_ASSERT(nsl_roaring_count(&r) == 2 && r.len == 2);
+
+    u64 v = 2;
+    NSL_ASSERT(nsl_roaring_next(&r, &v) && v == UINT32_MAX);
+    v++;
+    NSL_ASSERT(nsl_roaring_next(&r, &v) == false);
+
+    NSL_ASSERT(nsl_roaring_remove(&r, UINT32_MAX) == true);
+    NSL_ASSERT(nsl_roaring_remove(&r, UINT32_MAX) == false);
+    NSL_ASSERT(r.len == 1);
+
+    // array -> bitmap -> array
+    for (u32 i = 0; i < 5000; i++) nsl_roaring_add(&r, i * 2);
+    NSL_ASSERT(r.items[0].kind == NSL_ROARING_BITMAP);
+    for (u32 i = 0; i < 2000; i++) nsl_roaring_remove(&r, i * 2);
+    NSL_ASSERT(r.items[0].kind == NSL_ROARING_ARRAY);
+    NSL_ASSERT(nsl_roaring_count(&r) == 3001);
+
+    nsl_roaring_free(&r);
+}
+
+static void test_optimize(void) {
+    nsl_Roaring r = {0};
+    nsl_BitSet set = {0};
+    fill(&r, &set, 69);
+
+    nsl_roaring_optimize(&r);
+    bool has_runs = false;
+    for (usize i = 0; i < r.len; i++) {
+        has_runs |= r.items[i].kind == NSL_ROARING_RUN;
+    }
+    NSL_ASSERT(has_runs && "the long run should be stored as a run container");
+    assert_same(&r, &set);
+
+    // modifying a run container
+    NSL_ASSERT(nsl_roaring_remove(&r, 230000) == true);
+    NSL_ASSERT(nsl_roaring_add(&r, 230000) == true);
+    assert_same(&r, &set);
+
+    nsl_roaring_free(&r);
+    nsl_bitset_free(&set);
+}
+
+static void test_set_algebra(void) {
+    nsl_Roaring a = {0}, b = {0}, out = {0};
+    nsl_BitSet sa = {0}, sb = {0}, expected = {0};
+    fill(&a, &sa, 1);
+    fill(&b, &sb, 2);
+    assert_same(&a, &sa);
+
+    nsl_roaring_intersection(&a, &b, &out);
+    nsl_bitset_intersection(&sa, &sb, &expected);
+    assert_same(&out, &expected);
+
+    nsl_roaring_union(&a, &b, &out);
+    nsl_bitset_union(&sa, &sb, &expected);
+    assert_same(&out, &expected);
+
+    nsl_roaring_optimize(&a);
+    nsl_roaring_intersection(&a, &b, &out);
+    nsl_bitset_intersection(&sa, &sb, &expected);
+    assert_same(&out, &expected);
+
+    nsl_roaring_union(&b, &a, &out);
+    nsl_bitset_union(&sa, &sb, &expected);
+    assert_same(&out, &expected);
+
+    nsl_roaring_free(&a);
+    nsl_roaring_free(&b);
+    nsl_roaring_free(&out);
+    nsl_bitset_free(&sa);
+    nsl_bitset_free(&sb);
+    nsl_bitset_free(&expected);
+}
+
+static void test_serialize(void) {
+    nsl_Roaring r = {0};
+    nsl_BitSet set = {0};
+    fill(&r, &set, 420);
+    nsl_roaring_optimize(&r);
+
+    nsl_ByteBuffer bb = {0};
+    nsl_Bytes bytes = nsl_roaring_serialize(&r, &bb);
+    NSL_ASSERT(bytes.size % 8 == 0);
+
+    nsl_Roaring view = {0};
+    NSL_ASSERT(nsl_roaring_from_bytes(bytes, &view) == NSL_NO_ERROR);
+    NSL_ASSERT(view.len == r.len);
+    assert_same(&view, &set);
+
+    // the view copies the containers it modifies
+    nsl_roaring_add(&view, 7);
+    nsl_roaring_remove(&view, 230001);
+    nsl_roaring_remove(&view, (3u << 16) + 1);
+    NSL_ASSERT(nsl_roaring_has(&view, 230001) == false);
+
+    nsl_Roaring copy = {0};
+    NSL_ASSERT(nsl_roaring_from_bytes(bytes, &copy) == NSL_NO_ERROR);
+    assert_same(&copy, &set);
+
+    // unaligned input is copied
+    nsl_ByteBuffer shifted = {0};
+    nsl_list_push(&shifted, 0);
+    nsl_bb_push_bytes(&shifted, bytes.size, bytes.data);
+    NSL_ASSERT(nsl_roaring_from_bytes(nsl_bytes_slice(nsl_bb_to_bytes(&shifted), 1, shifted.len), &copy) == NSL_NO_ERROR);
+    assert_same(&copy, &set);
+
+    NSL_ASSERT(nsl_roaring_from_bytes(nsl_bytes_slice(bytes, 0, bytes.size - 8), &copy) == NSL_ERROR_PARSE);
+    NSL_ASSERT(copy.len == 0);
+    NSL_ASSERT(nsl_roaring_from_bytes(NSL_BYTES_STR("NSLR"), &copy) == NSL_ERROR_PARSE);
+
+    nsl_roaring_free(&r);
+    nsl_roaring_free(&view);
+    nsl_roaring_free(&copy);
+    nsl_bitset_free(&set);
+    nsl_list_free(&bb);
+    nsl_list_free(&shifted);
+}
+
+// serializes 'r' and overwrites the u16 at 'at' in the data of the first container
+static nsl_Error parse_patched(const nsl_Roaring *r, usize at, u16 value) {
+    nsl_ByteBuffer bb = {0};
+    nsl_Bytes bytes = nsl_roaring_serialize(r, &bb);
+    nsl_Roaring out = {0};
+    NSL_ASSERT(nsl_roaring_from_bytes(bytes, &out) == NSL_NO_ERROR);
+
+    const usize offset = nsl_u32_from_le_bytes(nsl_bytes_slice(bytes, 16, 20)) + at * sizeof(u16);
+    bb.items[offset] = value & 0xff;
+    bb.items[offset + 1] = value >> 8;
+    const nsl_Error error = nsl_roaring_from_bytes(bytes, &out);
+    NSL_ASSERT(error == NSL_NO_ERROR || out.len == 0);
+
+    nsl_roaring_free(&out);
+    nsl_list_free(&bb);
+    return error;
+}
+
+static void test_corrupted(void) {
+    nsl_Roaring r = {0};
+    for (u32 v = 0xff00; v < 0xff10; v++) nsl_roaring_add(&r, v);
+    nsl_roaring_optimize(&r);
+    NSL_ASSERT(r.items[0].kind == NSL_ROARING_RUN);
+    NSL_ASSERT(parse_patched(&r, 1, 0x1000) == NSL_ERROR_PARSE && "run past the end of the container");
+    NSL_ASSERT(parse_patched(&r, 1, 0x00ff) == NSL_NO_ERROR);
+
+    for (u32 v = 0x10; v < 0x20; v++) nsl_roaring_add(&r, v);
+    nsl_roaring_optimize(&r);
+    NSL_ASSERT(r.items[0].kind == NSL_ROARING_RUN && r.items[0].len == 2);
+    NSL_ASSERT(parse_patched(&r, 2, 0x18) == NSL_ERROR_PARSE && "overlapping runs");
+    NSL_ASSERT(parse_patched(&r, 2, 0x01) == NSL_ERROR_PARSE && "unsorted runs");
+    nsl_roaring_clear(&r);
+
+    nsl_roaring_add(&r, 1);
+    nsl_roaring_add(&r, 2);
+    nsl_roaring_add(&r, 3);
+    NSL_ASSERT(parse_patched(&r, 1, 1) == NSL_ERROR_PARSE && "duplicate value");
+    NSL_ASSERT(parse_patched(&r, 2, 0) == NSL_ERROR_PARSE && "unsorted values");
+    nsl_roaring_clear(&r);
+
+    for (u32 i = 0; i < 5000; i++) nsl_roaring_add(&r, i * 2);
+    NSL_ASSERT(r.items[0].kind == NSL_ROARING_BITMAP);
+    NSL_ASSERT(parse_patched(&r, 0, 0xffff) == NSL_ERROR_PARSE && "count does not match");
+
+    nsl_roaring_free(&r);
+}
+
+int main(void) {
+    test_basic();
+    test_optimize();
+    test_set_algebra();
+    test_serialize();
+    test_corrupted();
+}
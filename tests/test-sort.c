@@ -0,0 +1,182 @@
+#include "../nsl.h"
+
+#include <math.h>
+
+static u32 rng_state = 0x12345678;
+static u32 rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+#define LESS(a, b) ((a) < (b))
+NSL_SORT_DEFINE(sort_i32, i32, LESS)
+
+typedef struct {
+    u64 key;
+    u32 order;
+} Record;
+
+#define RECORD_GREATER(a, b) ((a).key > (b).key)
+NSL_SORT_DEFINE(sort_records_desc, Record, RECORD_GREATER)
+
+static i32 cmp_i32(const void *a, const void *b) {
+    const i32 x = *(const i32 *)a, y = *(const i32 *)b;
+    return (x > y) - (x < y);
+}
+
+// random, sorted, reversed, few unique values and a sawtooth
+static void fill_pattern(usize pattern, usize n, i32 *values) {
+    for (usize i = 0; i < n; i++) {
+        switch (pattern) {
+        case 0: values[i] = (i32)rng(); break;
+        case 1: values[i] = (i32)i; break;
+        case 2: values[i] = (i32)(n - i); break;
+        case 3: values[i] = (i32)(rng() % 4); break;
+        case 4: values[i] = (i32)(i % 37); break;
+        }
+    }
+}
+
+static void test_sort_define(void) {
+    i32 *values = malloc(5000 * sizeof(i32));
+    i32 *expected = malloc(5000 * sizeof(i32));
+    for (usize pattern = 0; pattern < 5; pattern++) {
+        for (usize n = 0; n < 5000; n = n * 2 + 1) {
+            fill_pattern(pattern, n, values);
+            memcpy(expected, values, n * sizeof(i32));
+            qsort(expected, n, sizeof(i32), cmp_i32);
+
+            sort_i32(n, values);
+            NSL_ASSERT(memcmp(values, expected, n * sizeof(i32)) == 0 && "not sorted");
+        }
+    }
+    free(values);
+    free(expected);
+
+    nsl_List(Record) records = {0};
+    for (u32 i = 0; i < 1000; i++) {
+        nsl_list_push(&records, (Record){.key = rng() % 100, .order = i});
+    }
+    sort_records_desc(records.len, records.items);
+    for (usize i = 1; i < records.len; i++) {
+        NSL_ASSERT(records.items[i - 1].key >= records.items[i].key);
+    }
+    nsl_list_free(&records);
+}
+
+#define TEST_RADIX(T, gen)                                                                         \
+    do {                                                                                           \
+        T values[1000];                                                                            \
+        for (usize n = 0; n <= NSL_ARRAY_LEN(values); n += 333) {                                  \
+            for (usize i = 0; i < n; i++) values[i] = (T)(gen);                                    \
+            nsl_##T##_sort(n, values);                                                             \
+            for (usize i = 1; i < n; i++) NSL_ASSERT(values[i - 1] <= values[i] && #T);            \
+        }                                                                                          \
+    } while (0)
+
+static void test_radix(void) {
+    TEST_RADIX(u8, rng());
+    TEST_RADIX(i8, rng());
+    TEST_RADIX(u16, rng());
+    TEST_RADIX(i16, rng());
+    TEST_RADIX(u32, rng());
+    TEST_RADIX(i32, rng());
+    TEST_RADIX(u64, (u64)rng() << 32 | rng());
+    TEST_RADIX(i64, (u64)rng() << 32 | rng());
+    TEST_RADIX(usize, rng() % 50);
+    TEST_RADIX(f32, (i32)rng() / 1000.0f);
+    TEST_RADIX(f64, (i32)rng() / 1000.0);
+
+    // only the lowest byte differs
+    TEST_RADIX(u64, 0x1234567800000000ull | (rng() & 0xff));
+
+    f64 special[] = {1.5, -0.0, INFINITY, -2.0, 0.0, -INFINITY, 3.0, -1e300};
+    nsl_f64_sort(NSL_ARRAY_LEN(special), special);
+    NSL_ASSERT(special[0] == -INFINITY && special[1] == -1e300 && special[2] == -2.0);
+    NSL_ASSERT(special[3] == 0.0 && signbit(special[3]));
+    NSL_ASSERT(special[4] == 0.0 && !signbit(special[4]));
+    NSL_ASSERT(special[5] == 1.5 && special[6] == 3.0 && special[7] == INFINITY);
+}
+
+static void test_sort_by_key(void) {
+    nsl_List(Record) records = {0};
+    for (usize n = 0; n < 3000; n = n * 3 + 1) {
+        nsl_list_clear(&records);
+        for (u32 i = 0; i < n; i++) {
+            nsl_list_push(&records, (Record){.key = rng() % 17 * 0x0101010101ull, .order = i});
+        }
+        nsl_list_sort_by_u64(&records, key);
+        for (usize i = 1; i < records.len; i++) {
+            const Record *a = &records.items[i - 1];
+            const Record *b = &records.items[i];
+            NSL_ASSERT(a->key <= b->key && "not sorted");
+            NSL_ASSERT((a->key != b->key || a->order < b->order) && "not stable");
+        }
+    }
+    nsl_list_free(&records);
+}
+
+static void test_select_nth(void) {
+    i32 input[3000];
+    i32 values[3000];
+    i32 expected[3000];
+    for (usize pattern = 0; pattern < 5; pattern++) {
+        for (usize n = 1; n < NSL_ARRAY_LEN(values); n = n * 3 + 1) {
+            fill_pattern(pattern, n, input);
+            memcpy(expected, input, n * sizeof(i32));
+            qsort(expected, n, sizeof(i32), cmp_i32);
+
+            for (usize nth = 0; nth < n; nth += n / 7 + 1) {
+                memcpy(values, input, n * sizeof(i32));
+                sort_i32_select_nth(n, values, nth);
+                NSL_ASSERT(values[nth] == expected[nth] && "wrong nth element");
+                for (usize i = 0; i < n; i++) {
+                    NSL_ASSERT(i <= nth || values[nth] <= values[i]);
+                    NSL_ASSERT(nth <= i || values[i] <= values[nth]);
+                }
+
+                memcpy(values, input, n * sizeof(i32));
+                sort_i32_partial_sort(n, values, nth);
+                NSL_ASSERT(memcmp(values, expected, nth * sizeof(i32)) == 0 && "not sorted");
+            }
+        }
+    }
+}
+
+static void test_top_k(void) {
+    nsl_List(Record) top = {0};
+    for (u32 i = 0; i < 10000; i++) {
+        nsl_list_top_k_push(&top, sort_records_desc, 10, (Record){.key = (i * 7919u) % 10007});
+    }
+    NSL_ASSERT(top.len == 10);
+    NSL_ASSERT(top.items[0].key == 9997 && "heap root is not the smallest of the top 10");
+
+    nsl_list_top_k_finish(&top, sort_records_desc);
+    for (usize i = 0; i < top.len; i++) {
+        NSL_ASSERT(top.items[i].key == 10006 - i);
+    }
+
+    nsl_List(Record) all = {0};
+    for (u32 i = 0; i < 5000; i++) {
+        nsl_list_push(&all, (Record){.key = rng() % 1000});
+    }
+    nsl_list_partial_sort(&all, sort_records_desc, 3);
+    for (usize i = 3; i < all.len; i++) {
+        NSL_ASSERT(all.items[i].key <= all.items[2].key);
+    }
+    nsl_list_select_nth(&all, sort_records_desc, 0);
+    NSL_ASSERT(all.items[0].key == 999);
+
+    nsl_list_free(&top);
+    nsl_list_free(&all);
+}
+
+int main(void) {
+    test_sort_define();
+    test_radix();
+    test_sort_by_key();
+    test_select_nth();
+    test_top_k();
+}
@@ -23,6 +23,30 @@ static void test_str_compare(void) {
     NSL_ASSERT(nsl_str_is_empty(NSL_STR("")) == true && "string should be empty");
 }
 
+static void test_str_ignorecase(void) {
+    nsl_Str s = NSL_STR("Content-Type: text/html; Charset=UTF-8 [some more bytes]");
+
+    NSL_ASSERT(nsl_str_eq_ignorecase(s, NSL_STR("content-type: TEXT/HTML; charset=utf-8 [SOME MORE BYTES]")));
+    NSL_ASSERT(!nsl_str_eq_ignorecase(s, NSL_STR("content-type: TEXT/HTML; charset=utf-8 [SOME MORE BYTEZ]")));
+    NSL_ASSERT(!nsl_str_eq_ignorecase(NSL_STR("@"), NSL_STR("`")));
+
+    NSL_ASSERT(nsl_str_startswith_ignorecase(s, NSL_STR("CONTENT-type")) == true);
+    NSL_ASSERT(nsl_str_startswith_ignorecase(s, NSL_STR("type")) == false);
+
+    NSL_ASSERT(nsl_str_find_ignorecase(s, NSL_STR("CHARSET")) == 25);
+    NSL_ASSERT(nsl_str_find_ignorecase(s, NSL_STR("BYTES]")) == 50);
+    NSL_ASSERT(nsl_str_find_ignorecase(s, NSL_STR("bytes!")) == NSL_STR_NOT_FOUND);
+    NSL_ASSERT(nsl_str_find_ignorecase(s, NSL_STR("")) == 0);
+
+    nsl_StrBuffer sb = {0};
+    nsl_Str lower = nsl_str_to_lower(s, &sb);
+    NSL_ASSERT(nsl_str_eq(lower, NSL_STR("content-type: text/html; charset=utf-8 [some more bytes]")));
+    nsl_Str upper = nsl_str_to_upper(s, &sb);
+    NSL_ASSERT(nsl_str_eq(upper, NSL_STR("CONTENT-TYPE: TEXT/HTML; CHARSET=UTF-8 [SOME MORE BYTES]")));
+    NSL_ASSERT(sb.len == s.len * 2);
+    nsl_list_free(&sb);
+}
+
 static void test_str_copy(void) {
     nsl_Arena arena = {0};
 
@@ -111,6 +135,37 @@ static void test_str_try_chop(void) {
     NSL_ASSERT(t3 == false);
 }
 
+static void test_str_chop_by_set(void) {
+    nsl_ByteSet set = nsl_byteset_from_str(NSL_STR(" ,\n"));
+    NSL_ASSERT(nsl_byteset_has(&set, ',') == true);
+    NSL_ASSERT(nsl_byteset_has(&set, 'a') == false);
+
+    nsl_Str text = NSL_STR("Hello, this is some text that is longer than thirty two bytes\nend");
+    NSL_ASSERT(nsl_str_find_by_set(text, &set) == 5);
+    NSL_ASSERT(nsl_str_find_by_set(NSL_STR("no_delimiters_in_this_long_string_at_all"), &set) == NSL_STR_NOT_FOUND);
+
+    nsl_Str chunk = nsl_str_chop_by_set(&text, &set);
+    NSL_ASSERT(nsl_str_eq(chunk, NSL_STR("Hello")));
+    NSL_ASSERT(nsl_str_try_chop_by_set(&text, &set, &chunk) == true);
+    NSL_ASSERT(nsl_str_eq(chunk, NSL_STR("")));
+
+    nsl_StrList words = {0};
+    NSL_ASSERT(nsl_str_split_all(text, &set, &words) == 12);
+    NSL_ASSERT(nsl_str_eq(words.items[0], NSL_STR("this")));
+    NSL_ASSERT(nsl_str_eq(words.items[10], NSL_STR("bytes")));
+    NSL_ASSERT(nsl_str_eq(words.items[11], NSL_STR("end")));
+    nsl_list_free(&words);
+
+    u8 high[] = {'a', 0x80, 'b', 0xff, 'c'};
+    nsl_ByteSet high_set = {0};
+    nsl_byteset_add(&high_set, 0xff);
+    NSL_ASSERT(nsl_str_find_by_set(nsl_str_from_parts(sizeof(high), (const char *)high), &high_set) == 3);
+
+    nsl_ByteSet spaces = nsl_byteset_from_predicate(nsl_char_is_space);
+    nsl_Str padded = NSL_STR("................................\t...");
+    NSL_ASSERT(nsl_str_find_by_set(padded, &spaces) == 32);
+}
+
 static void test_str_chop_right(void) {
     nsl_Str text = NSL_STR("Hello\n\nThis is  text");
     nsl_Str rest[] = {
@@ -235,18 +290,50 @@ static void test_str_hash(void) {
         nsl_Str s;
         u64 hash;
     } tests[] = {
-        {NSL_STR("Hello"), 0x63f0bfacf2c00f6b},
-        {NSL_STR("This is a very long string"), 0xf276220f1fa71f6b},
-        {NSL_STR("Another"), 0x90c0e53673f3e9f4},
-        {NSL_STR("Hello"), 0x63f0bfacf2c00f6b},
+        {NSL_STR("Hello"), 0xc5a7afb07d03565c},
+        {NSL_STR("This is a very long string"), 0x13c1665277480614},
+        {NSL_STR("Another"), 0x280c5deec07a450e},
+        {NSL_STR("Hello"), 0xc5a7afb07d03565c},
     };
 
     for (size_t i = 0; i < sizeof(tests) / sizeof(tests[0]); i++) {
         const u64 hash = nsl_str_hash(tests[i].s);
         NSL_ASSERT(hash == tests[i].hash);
+        NSL_ASSERT(hash == nsl_bytes_hash(nsl_str_to_bytes(tests[i].s)));
+        NSL_ASSERT(hash != nsl_str_hash_seed(tests[i].s, 1));
     }
 }
 
+static void test_str_utf8(void) {
+    nsl_Str s = NSL_STR("Grüße, 日本語! \xf0\x9f\x98\x80 and some more ascii to fill a block");
+    NSL_ASSERT(nsl_str_utf8_validate(s) == true);
+    NSL_ASSERT(nsl_str_utf8_validate(NSL_STR("")) == true);
+    NSL_ASSERT(nsl_str_utf8_validate(NSL_STR("over long \xc0\x80")) == false);
+    NSL_ASSERT(nsl_str_utf8_validate(NSL_STR("surrogate \xed\xa0\x80")) == false);
+    NSL_ASSERT(nsl_str_utf8_validate(NSL_STR("too large \xf4\x90\x80\x80")) == false);
+    NSL_ASSERT(nsl_str_utf8_validate(NSL_STR("lonely continuation \x80")) == false);
+    NSL_ASSERT(nsl_str_utf8_validate(NSL_STR("truncated at the end of the block \xe6\x97")) == false);
+
+    NSL_ASSERT(nsl_str_utf8_count(s) == 49);
+    NSL_ASSERT(nsl_str_utf8_index(s, 9) == 7);
+    NSL_ASSERT(nsl_str_utf8_offset(s, 7) == 9);
+    NSL_ASSERT(nsl_str_utf8_offset(s, 100) == s.len);
+
+    u32 expected[] = {'G', 'r', 0xfc, 0xdf, 'e', ',', ' ', 0x65e5, 0x672c, 0x8a9e, '!', ' ', 0x1f600};
+    nsl_Str it = s;
+    for (usize i = 0; i < NSL_ARRAY_LEN(expected); i++) {
+        u32 cp = 0;
+        NSL_ASSERT(nsl_str_utf8_try_chop(&it, &cp) == true);
+        NSL_ASSERT(cp == expected[i]);
+    }
+
+    nsl_Str invalid = NSL_STR("\xff!");
+    u32 cp = 0;
+    NSL_ASSERT(nsl_str_utf8_try_chop(&invalid, &cp) == true && cp == 0xfffd);
+    NSL_ASSERT(nsl_str_utf8_try_chop(&invalid, &cp) == true && cp == '!');
+    NSL_ASSERT(nsl_str_utf8_try_chop(&invalid, &cp) == false);
+}
+
 static void test_str_format(void) {
     nsl_Arena arena = {0};
     nsl_Str s = nsl_str_format(&arena, "%d %d", 420, 69);
@@ -283,11 +370,13 @@ static void test_str_try_take(void) {
 
 int main(void) {
     test_str_compare();
+    test_str_ignorecase();
     test_str_copy();
     test_str_append();
     test_str_trim();
     test_str_chop();
     test_str_try_chop();
+    test_str_chop_by_set();
     test_str_chop_right();
     test_str_number_converting();
     test_str_find();
@@ -295,6 +384,7 @@ int main(void) {
     test_str_substring();
     test_str_join();
     test_str_hash();
+    test_str_utf8();
     test_str_format();
     test_str_take();
     test_str_try_take();